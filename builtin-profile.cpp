@@ -0,0 +1,94 @@
+/*
+ * Built-in Profile Implementation
+ *
+ * Factory bindings and lookup. Tables are read with memcpy_P / pgm_read_byte
+ * so they stay in flash on AVR as well as on the ARM boards.
+ */
+
+#include "builtin-profile.h"
+#include "chording.h"
+#include "macro-decode.h"
+
+//==============================================================================
+// FACTORY PROFILE
+//==============================================================================
+
+// Navigation paddle: arrows, paging and Enter. No chords - keys in a chord
+// stop sending their own bindings, which a default should not do.
+KP_MACRO(FACTORY_LEFT,     KP_LEFT);
+KP_MACRO(FACTORY_DOWN,     KP_DOWN);
+KP_MACRO(FACTORY_UP,       KP_UP);
+KP_MACRO(FACTORY_RIGHT,    KP_RIGHT);
+KP_MACRO(FACTORY_HOME,     KP_HOME);
+KP_MACRO(FACTORY_END,      KP_END);
+KP_MACRO(FACTORY_PAGEUP,   KP_PAGEUP);
+KP_MACRO(FACTORY_PAGEDOWN, KP_PAGEDOWN);
+KP_MACRO(FACTORY_ENTER,    KP_ENTER);
+
+static const BuiltinKey FACTORY_KEYS[] PROGMEM = {
+  {0, BUILTIN_DOWN, FACTORY_LEFT},
+  {1, BUILTIN_DOWN, FACTORY_DOWN},
+  {2, BUILTIN_DOWN, FACTORY_UP},
+  {3, BUILTIN_DOWN, FACTORY_RIGHT},
+  {4, BUILTIN_DOWN, FACTORY_HOME},
+  {5, BUILTIN_DOWN, FACTORY_END},
+  {6, BUILTIN_DOWN, FACTORY_PAGEUP},
+  {7, BUILTIN_DOWN, FACTORY_PAGEDOWN},
+  {8, BUILTIN_DOWN, FACTORY_ENTER},
+};
+
+const BuiltinProfile FACTORY_PROFILE = {
+  FACTORY_KEYS, sizeof(FACTORY_KEYS) / sizeof(BuiltinKey),
+  nullptr, 0
+};
+
+//==============================================================================
+// ACTIVE PROFILE
+//==============================================================================
+
+static const BuiltinProfile* activeProfile = nullptr;
+
+void setBuiltinProfile(const BuiltinProfile* profile) {
+  activeProfile = profile;
+  if (profile) {
+    chording.setBuiltinChords(profile->chords, profile->chordCount);
+  } else {
+    chording.setBuiltinChords(nullptr, 0);
+  }
+}
+
+void setupBuiltinProfile() {
+#if BUILTIN_PROFILE
+  setBuiltinProfile(&FACTORY_PROFILE);
+#endif
+}
+
+//==============================================================================
+// LOOKUP
+//==============================================================================
+
+const char* findBuiltinKeyMacro(uint8_t key, bool up) {
+  if (!activeProfile) return nullptr;
+
+  uint8_t direction = up ? BUILTIN_UP : BUILTIN_DOWN;
+  for (uint8_t i = 0; i < activeProfile->keyCount; i++) {
+    BuiltinKey entry;
+    memcpy_P(&entry, &activeProfile->keys[i], sizeof(BuiltinKey));
+    if (entry.key == key && entry.direction == direction) {
+      return entry.macro;
+    }
+  }
+  return nullptr;
+}
+
+String decodeBuiltinMacro(const char* macro) {
+  // The decoder reads RAM - copy just for display
+  uint16_t length = strlen_P(macro);
+  uint8_t* bytes = (uint8_t*)malloc(length + 1);
+  if (!bytes) return String(F("(out of memory)"));
+
+  memcpy_P(bytes, macro, length);
+  String readable = macroDecode(bytes, length);
+  free(bytes);
+  return readable;
+}
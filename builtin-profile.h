@@ -0,0 +1,143 @@
+/*
+ * Built-in Profile Interface
+ *
+ * Read-only key and chord bindings compiled into flash. Macros are written
+ * as C++ string literals with the KP_* builders below, so they are encoded
+ * to UTF-8+ by the compiler and validated with static_assert - nothing is
+ * parsed at boot and nothing is copied to RAM. Bindings made with MAP and
+ * CHORD ADD (RAM, saved to EEPROM) overlay the profile; CLEAR on a key
+ * reverts it to the built-in binding.
+ */
+
+#ifndef BUILTIN_PROFILE_H
+#define BUILTIN_PROFILE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "map-parser-tables.h"
+
+//==============================================================================
+// UTF-8+ LITERAL BUILDERS
+//==============================================================================
+
+// Each builder expands to adjacent string literals, e.g.
+//   KP_CTRL("c")            +CTRL "c" -CTRL
+//   KP_SHIFT(KP_TAB)        +SHIFT "\t" -SHIFT
+//   "ls -l" KP_ENTER        "ls -l\n"
+// Hex escapes are kept in their own literal so a following hex digit is not
+// absorbed into the code ("\x13" "a", never "\x13a").
+
+#define KP_CTRL(keys)     "\x01" keys "\x06"
+#define KP_ALT(keys)      "\x02" keys "\x10"
+#define KP_SHIFT(keys)    "\x03" keys "\x11"
+#define KP_CMD(keys)      "\x04" keys "\x12"
+
+#define KP_F1             "\x05\x01"
+#define KP_F2             "\x05\x02"
+#define KP_F3             "\x05\x03"
+#define KP_F4             "\x05\x04"
+#define KP_F5             "\x05\x05"
+#define KP_F6             "\x05\x06"
+#define KP_F7             "\x05\x07"
+#define KP_F8             "\x05\x08"
+#define KP_F9             "\x05\x09"
+#define KP_F10            "\x05\x0A"
+#define KP_F11            "\x05\x0B"
+#define KP_F12            "\x05\x0C"
+
+#define KP_UP             "\x13"
+#define KP_DOWN           "\x14"
+#define KP_LEFT           "\x15"
+#define KP_RIGHT          "\x16"
+#define KP_HOME           "\x17"
+#define KP_END            "\x18"
+#define KP_PAGEUP         "\x19"
+#define KP_PAGEDOWN       "\x1A"
+#define KP_DELETE         "\x1C"
+
+#define KP_CLICK          "\x1E\x01"
+#define KP_RIGHT_CLICK    "\x1E\x02"
+#define KP_MIDDLE_CLICK   "\x1E\x04"
+
+#define KP_ENTER          "\n"
+#define KP_TAB            "\t"
+#define KP_SPACE          " "
+#define KP_ESC            "\x1B"
+#define KP_BACKSPACE      "\b"
+
+//==============================================================================
+// COMPILE-TIME VALIDATION
+//==============================================================================
+
+// Operands of the multi-byte codes must be in range; checked by the compiler
+constexpr bool kpMacroBytesValid(const char* p) {
+  return *p == '\0' ? true
+       : *p == UTF8_FUNCTION_KEY
+           ? (p[1] >= 1 && p[1] <= 12 && kpMacroBytesValid(p + 2))
+       : (*p == UTF8_PRESS_MULTI || *p == UTF8_RELEASE_MULTI)
+           ? (p[1] >= 1 && p[1] <= 0x0F && kpMacroBytesValid(p + 2))
+       : *p == UTF8_MOUSE_MOVE
+           ? (p[1] != '\0' && p[2] != '\0' && kpMacroBytesValid(p + 3))
+       : *p == UTF8_MOUSE_SCROLL
+           ? (p[1] != '\0' && kpMacroBytesValid(p + 2))
+       : *p == UTF8_MOUSE_BUTTON
+           ? ((p[1] & MOUSE_BUTTON_MASK) != 0 && (p[1] & ~(MOUSE_BUTTON_MASK | MOUSE_ACTION_MASK)) == 0 &&
+              (p[1] & MOUSE_ACTION_MASK) != MOUSE_ACTION_MASK && kpMacroBytesValid(p + 2))
+       : kpMacroBytesValid(p + 1);
+}
+
+constexpr bool kpMacroValid(const char* p) {
+  return *p != '\0' && kpMacroBytesValid(p);
+}
+
+// Define a flash-resident macro, rejecting malformed literals at compile time
+#define KP_MACRO(name, literal) \
+  static_assert(kpMacroValid(literal), "Invalid built-in macro " #name); \
+  static const char name[] PROGMEM = literal
+
+//==============================================================================
+// PROFILE TABLES
+//==============================================================================
+
+#define BUILTIN_DOWN 0
+#define BUILTIN_UP   1
+
+// Table entries live in PROGMEM and point at PROGMEM macros
+struct BuiltinKey {
+  uint8_t key;
+  uint8_t direction;           // BUILTIN_DOWN or BUILTIN_UP
+  const char* macro;
+};
+
+struct BuiltinChord {
+  uint32_t keyMask;
+  const char* macro;
+};
+
+struct BuiltinProfile {
+  const BuiltinKey* keys;
+  uint8_t keyCount;
+  const BuiltinChord* chords;
+  uint8_t chordCount;
+};
+
+// Factory profile, active when BUILTIN_PROFILE is non-zero (config.h)
+extern const BuiltinProfile FACTORY_PROFILE;
+
+//==============================================================================
+// PROFILE INTERFACE
+//==============================================================================
+
+// Select the active profile (nullptr = none) and register its chords
+void setBuiltinProfile(const BuiltinProfile* profile);
+
+// Install the factory profile if enabled - call once from setup()
+void setupBuiltinProfile();
+
+// PROGMEM macro for a key, nullptr if the profile does not bind it
+const char* findBuiltinKeyMacro(uint8_t key, bool up);
+
+// Human-readable form of a PROGMEM macro (for SHOW / CHORD LIST)
+String decodeBuiltinMacro(const char* macro);
+
+#endif // BUILTIN_PROFILE_H
@@ -17,6 +17,8 @@
  */
 
 #include "chordStorage.h"
+#include "storage.h"
+#include "scheduler.h"
 #include <EEPROM.h>
 
 //==============================================================================
@@ -24,8 +26,8 @@
 //==============================================================================
 
 // External functions from storage.cpp
-extern uint16_t writeStringToEEPROM(uint16_t offset, const char* str);
-extern uint16_t readStringFromEEPROM(uint16_t offset, char** str);
+extern uint16_t writeStringToEEPROM(uint16_t offset, const char* str, uint16_t end);
+extern uint16_t readStringFromEEPROM(uint16_t offset, char** str, uint16_t end);
 
 //==============================================================================
 // HELPER FUNCTIONS
@@ -63,8 +65,10 @@ uint16_t saveChords(uint16_t startOffset, uint32_t modifierMask,
     // Count chords first by calling forEachChord with a counting callback
     static uint32_t globalChordCount;
     static uint16_t globalOffset;
+    static uint16_t globalEnd;
     globalChordCount = 0;
     globalOffset = offset;
+    globalEnd = storageEnd();
     
     // Reserve space for chord count, we'll update it later
     uint16_t chordCountOffset = offset;
@@ -79,9 +83,12 @@ uint16_t saveChords(uint16_t startOffset, uint32_t modifierMask,
         globalOffset = write32ToEEPROM(globalOffset, keyMask);
         
         // Write macro string
-        globalOffset = writeStringToEEPROM(globalOffset, macro);
+        globalOffset = writeStringToEEPROM(globalOffset, macro, globalEnd);
         
         globalChordCount++;
+        
+        // Only between records: the input task reads the chord list too
+        schedulerYield();
     };
     
     // Call forEachChord with our writing callback
@@ -94,8 +101,8 @@ uint16_t saveChords(uint16_t startOffset, uint32_t modifierMask,
     offset = globalOffset;
     
     // Write end marker (two null bytes)
-    if (offset < EEPROM.length()) EEPROM.write(offset++, 0x00);
-    if (offset < EEPROM.length()) EEPROM.write(offset++, 0x00);
+    if (offset < globalEnd) EEPROM.update(offset++, 0x00);
+    if (offset < globalEnd) EEPROM.update(offset++, 0x00);
     
     return offset;
 }
@@ -112,9 +119,10 @@ uint32_t loadChords(uint16_t startOffset,
     if (!addChord || !clearAllChords) return 0;
     
     uint16_t offset = startOffset;
+    uint16_t end = storageEnd();
     
     // Check magic number
-    uint32_t magic;
+    uint32_t magic = 0;
     offset = read32FromEEPROM(offset, &magic);
     if (magic != CHORD_MAGIC_VALUE) {
         // CRITICAL FIX #2: No valid chord data found - return 0 but clearAllChords was already called
@@ -122,11 +130,11 @@ uint32_t loadChords(uint16_t startOffset,
     }
     
     // Read modifier mask
-    uint32_t modifierMask;
+    uint32_t modifierMask = 0;
     offset = read32FromEEPROM(offset, &modifierMask);
     
     // Read chord count
-    uint32_t chordCount;
+    uint32_t chordCount = 0;
     offset = read32FromEEPROM(offset, &chordCount);
     
     // Sanity check: reasonable chord count (prevent runaway reads)
@@ -136,16 +144,16 @@ uint32_t loadChords(uint16_t startOffset,
     
     // Load each chord
     uint32_t chordsLoaded = 0;
-    for (uint32_t i = 0; i < chordCount && offset < EEPROM.length(); i++) {
+    for (uint32_t i = 0; i < chordCount && offset < end; i++) {
         // Read key mask
-        uint32_t keyMask;
+        uint32_t keyMask = 0;
         offset = read32FromEEPROM(offset, &keyMask);
         
-        if (offset >= EEPROM.length()) break;
+        if (offset >= end) break;
         
         // Read macro string
         char* macroString = nullptr;
-        offset = readStringFromEEPROM(offset, &macroString);
+        offset = readStringFromEEPROM(offset, &macroString, end);
         
         if (offset == 0) {  // Read error
             if (macroString) free(macroString);
@@ -161,7 +169,7 @@ uint32_t loadChords(uint16_t startOffset,
     }
     
     // Verify end marker (optional - for debugging)
-    if (offset < EEPROM.length() - 1) {
+    if (offset < end - 1) {
         uint8_t endMarker1 = EEPROM.read(offset);
         uint8_t endMarker2 = EEPROM.read(offset + 1);
         if (endMarker1 != 0x00 || endMarker2 != 0x00) {
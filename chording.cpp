@@ -11,6 +11,9 @@
 #include "chording.h"
 #include "macro-engine.h"
 #include "storage.h"
+#include "config-hash.h"
+#include "journal.h"
+#include "speed-stats.h"
 #include <string.h>
 
 //==============================================================================
@@ -18,7 +21,7 @@
 //==============================================================================
 
 static const uint32_t DEFAULT_EXECUTION_WINDOW_MS = 50;
-static const uint32_t CANCELLATION_TIMEOUT_MS = 2000;
+static const uint32_t CANCELLATION_TIMEOUT_MS = CHORD_CANCELLATION_TIMEOUT_MS;
 
 //==============================================================================
 // GLOBAL INSTANCE
@@ -26,14 +29,31 @@ static const uint32_t CANCELLATION_TIMEOUT_MS = 2000;
 
 ChordingEngine chording;
 
+void (*undefinedChordHook)(uint32_t keyMask) = nullptr;
+
 //==============================================================================
 // CHORDING ENGINE IMPLEMENTATION
 //==============================================================================
 
+// The key in mask, or CHORD_NO_KEY if it holds none or several
+static uint8_t singleKey(uint32_t mask) {
+    if (mask == 0 || (mask & (mask - 1)) != 0) return CHORD_NO_KEY;
+    uint8_t key = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        key++;
+    }
+    return key;
+}
+
 ChordingEngine::ChordingEngine() {
     chordList = nullptr;
     modifierKeyMask = 0;
     chordSwitchesMask = 0;
+    hasOrderedChords = false;
+    chordHash = 0;
+    builtinChords = nullptr;
+    builtinChordCount = 0;
     state = CHORD_IDLE;
     capturedChord = 0;
     pressedKeys = 0;
@@ -42,10 +62,17 @@ ChordingEngine::ChordingEngine() {
     executionWindowStart = 0;
     executionWindowActive = false;
     cancellationStartTime = 0;
+    gestureStartTime = 0;
+    firstPressedKey = CHORD_NO_KEY;
+    firstReleasedKey = CHORD_NO_KEY;
+    correctionIndex = nullptr;
+    correctedCount = 0;
+    undefinedCount = 0;
 }
 
 ChordingEngine::~ChordingEngine() {
     clearAllChords();
+    setCorrection(false);
 }
 
 bool ChordingEngine::processChording(uint32_t currentSwitchState) {
@@ -73,6 +100,10 @@ bool ChordingEngine::processChording(uint32_t currentSwitchState) {
                 state = CHORD_BUILDING;
                 capturedChord = chordSwitches;
                 executionWindowActive = false;
+                gestureStartTime = now;
+                firstPressedKey = singleKey(chordPressed);
+                firstReleasedKey = CHORD_NO_KEY;
+                journalRecord(JOURNAL_CHORD_START, 0, capturedChord);
             }
             break;
             
@@ -89,6 +120,7 @@ bool ChordingEngine::processChording(uint32_t currentSwitchState) {
                     state = CHORD_CANCELLATION;
                     cancellationStartTime = now;
                     executionWindowActive = false;
+                    journalRecord(JOURNAL_CHORD_CANCEL, 0, nonModifierNonChord);
                 }
             }
             
@@ -97,6 +129,7 @@ bool ChordingEngine::processChording(uint32_t currentSwitchState) {
                 if (!executionWindowActive) {
                     executionWindowStart = now;
                     executionWindowActive = true;
+                    firstReleasedKey = singleKey(chordReleased);
                 }
             }
             break;
@@ -127,6 +160,10 @@ bool ChordingEngine::processChording(uint32_t currentSwitchState) {
                     state = CHORD_BUILDING;
                     capturedChord = chordSwitches;
                     executionWindowActive = false;
+                    gestureStartTime = now;
+                    firstPressedKey = CHORD_NO_KEY;
+                    firstReleasedKey = CHORD_NO_KEY;
+                    journalRecord(JOURNAL_CHORD_START, 0, capturedChord);
                 } else {
                     // No chord keys left - return to idle
                     resetState();
@@ -147,10 +184,34 @@ bool ChordingEngine::processChording(uint32_t currentSwitchState) {
     if (pressedKeys == 0) {
         if (executionWindowActive && state == CHORD_BUILDING) {
             // All keys released within execution window AND in building state - execute chord
-            ChordPattern* pattern = findChordPattern(capturedChord);
+            ChordPattern* pattern;
+            const char* builtin;
+            uint8_t outcome = JOURNAL_CHORD_FIRED;
+            if (!lookupGesture(capturedChord, firstPressedKey, firstReleasedKey, pattern, builtin)) {
+                uint32_t corrected = findCorrection(capturedChord);
+                if (corrected) {
+                    lookupChord(corrected, pattern, builtin);
+                    outcome = JOURNAL_CHORD_CORRECTED;
+                    correctedCount++;
+                } else {
+                    outcome = JOURNAL_CHORD_UNDEFINED;
+                    undefinedCount++;
+                }
+            }
+            journalRecord(JOURNAL_CHORD_END, outcome, capturedChord);
+            speedRecordGesture(outcome, now - gestureStartTime);
+            if (outcome == JOURNAL_CHORD_UNDEFINED && undefinedChordHook) {
+                undefinedChordHook(capturedChord);
+            }
             if (pattern) {
                 executeChord(pattern);
+            } else {
+                executeUTF8MacroP(builtin);
             }
+        } else if (state != CHORD_IDLE) {
+            uint8_t outcome = state == CHORD_CANCELLATION ? JOURNAL_CHORD_CANCELLED : JOURNAL_CHORD_EXPIRED;
+            journalRecord(JOURNAL_CHORD_END, outcome, capturedChord);
+            speedRecordGesture(outcome, now - gestureStartTime);
         }
         // Always reset to IDLE when all keys are released, regardless of state
         resetState();
@@ -173,7 +234,11 @@ void ChordingEngine::handleExecutionWindow() {
         // Some keys still held - update pattern to currently pressed chord keys
         uint32_t currentChordKeys = pressedKeys & chordSwitchesMask;
         if (currentChordKeys != 0) {
+            // A new chord from the keys still held; their order is unknown
             capturedChord = currentChordKeys;
+            firstPressedKey = CHORD_NO_KEY;
+            firstReleasedKey = CHORD_NO_KEY;
+            journalRecord(JOURNAL_CHORD_START, 1, capturedChord);
         } else {
             // No chord keys left - should transition to idle
             resetState();
@@ -184,11 +249,41 @@ void ChordingEngine::handleExecutionWindow() {
     executionWindowActive = false;
 }
 
+ChordRuntimeState ChordingEngine::saveRuntimeState() const {
+    ChordRuntimeState saved;
+    saved.state = state;
+    saved.capturedChord = capturedChord;
+    saved.pressedKeys = pressedKeys;
+    saved.lastSwitchState = lastSwitchState;
+    saved.executionWindowStart = executionWindowStart;
+    saved.executionWindowActive = executionWindowActive;
+    saved.cancellationStartTime = cancellationStartTime;
+    saved.gestureStartTime = gestureStartTime;
+    saved.firstPressedKey = firstPressedKey;
+    saved.firstReleasedKey = firstReleasedKey;
+    return saved;
+}
+
+void ChordingEngine::restoreRuntimeState(const ChordRuntimeState& saved) {
+    state = saved.state;
+    capturedChord = saved.capturedChord;
+    pressedKeys = saved.pressedKeys;
+    lastSwitchState = saved.lastSwitchState;
+    executionWindowStart = saved.executionWindowStart;
+    executionWindowActive = saved.executionWindowActive;
+    cancellationStartTime = saved.cancellationStartTime;
+    gestureStartTime = saved.gestureStartTime;
+    firstPressedKey = saved.firstPressedKey;
+    firstReleasedKey = saved.firstReleasedKey;
+}
+
 void ChordingEngine::resetState() {
     state = CHORD_IDLE;
     capturedChord = 0;
     executionWindowActive = false;
     cancellationStartTime = 0;
+    firstPressedKey = CHORD_NO_KEY;
+    firstReleasedKey = CHORD_NO_KEY;
 }
 
 ChordPattern* ChordingEngine::findChordPattern(uint32_t keyMask) const {
@@ -202,6 +297,118 @@ ChordPattern* ChordingEngine::findChordPattern(uint32_t keyMask) const {
     return nullptr;
 }
 
+// chordList first, then the built-in chords beneath it
+bool ChordingEngine::lookupChord(uint32_t keyMask, ChordPattern*& pattern, const char*& builtin) const {
+    pattern = findChordPattern(keyMask);
+    builtin = pattern ? nullptr : findBuiltinChord(keyMask);
+    return pattern || builtin;
+}
+
+// The keys in each order they were played, matched in one walk of
+// chordList and one of the built-in chords: pressed-first beats
+// released-first beats unordered, and chordList beats a built-in chord
+bool ChordingEngine::lookupGesture(uint32_t keyMask, uint8_t pressedKey, uint8_t releasedKey,
+                                   ChordPattern*& pattern, const char*& builtin) const {
+    uint32_t candidates[3];
+    uint8_t count = 0;
+    if (hasOrderedChords) {
+        if (pressedKey != CHORD_NO_KEY && (keyMask & (1UL << pressedKey))) {
+            candidates[count++] = orderedChordKey(keyMask, pressedKey, false);
+        }
+        if (releasedKey != CHORD_NO_KEY && (keyMask & (1UL << releasedKey))) {
+            candidates[count++] = orderedChordKey(keyMask, releasedKey, true);
+        }
+    }
+    candidates[count++] = keyMask;
+
+    pattern = nullptr;
+    builtin = nullptr;
+    uint8_t best = count;       // Rank of the match so far, count = none
+    for (ChordPattern* current = chordList; current && best > 0; current = current->next) {
+        for (uint8_t i = 0; i < best; i++) {
+            if (current->keyMask == candidates[i]) {
+                pattern = current;
+                best = i;
+                break;
+            }
+        }
+    }
+    for (uint8_t i = 0; i < builtinChordCount && best > 0; i++) {
+        BuiltinChord entry;
+        memcpy_P(&entry, &builtinChords[i], sizeof(BuiltinChord));
+        for (uint8_t c = 0; c < best; c++) {
+            if (entry.keyMask == candidates[c]) {
+                pattern = nullptr;
+                builtin = entry.macro;
+                best = c;
+                break;
+            }
+        }
+    }
+    return best < count;
+}
+
+//==============================================================================
+// NEAR-MISS CORRECTION
+//==============================================================================
+
+// Each defined chord marks the masks one key away from it with that key.
+// A mask reached from two chords is ambiguous and never corrected. Lookup
+// is then a single nibble read, however many chords are defined. Ordered
+// chords are left out: the index covers key masks only.
+
+static void markNeighbours(uint8_t* index, uint32_t chordMask) {
+    if (chordMask & ~CHORD_KEYS_MASK) return;
+    for (uint8_t key = 0; key < NUM_SWITCHES; key++) {
+        uint32_t neighbour = chordMask ^ (1UL << key);
+        if ((neighbour & (neighbour - 1)) == 0) continue;   // A lone tap is not a miss
+        uint8_t shift = (neighbour & 1) ? 4 : 0;
+        uint8_t& cell = index[neighbour >> 1];
+        uint8_t current = (cell >> shift) & 0x0F;
+        uint8_t mark = current ? 0x0F : key + 1;
+        cell = (cell & ~(0x0F << shift)) | (mark << shift);
+    }
+}
+
+void ChordingEngine::buildCorrectionIndex() {
+    if (!correctionIndex) return;
+    memset(correctionIndex, 0, CHORD_CORRECTION_INDEX_SIZE);
+
+    for (ChordPattern* current = chordList; current; current = current->next) {
+        markNeighbours(correctionIndex, current->keyMask);
+    }
+    for (uint8_t i = 0; i < builtinChordCount; i++) {
+        BuiltinChord entry;
+        memcpy_P(&entry, &builtinChords[i], sizeof(BuiltinChord));
+        if (!findChordPattern(entry.keyMask)) {
+            markNeighbours(correctionIndex, entry.keyMask);
+        }
+    }
+}
+
+uint32_t ChordingEngine::findCorrection(uint32_t keyMask) const {
+    if (!correctionIndex || keyMask >= (1UL << NUM_SWITCHES)) return 0;
+
+    uint8_t mark = (correctionIndex[keyMask >> 1] >> ((keyMask & 1) ? 4 : 0)) & 0x0F;
+    if (mark == 0 || mark == 0x0F) return 0;
+    return keyMask ^ (1UL << (mark - 1));
+}
+
+bool ChordingEngine::setCorrection(bool enabled) {
+    if (!enabled) {
+        free(correctionIndex);
+        correctionIndex = nullptr;
+        return true;
+    }
+    if (correctionIndex) return true;
+    if (NUM_SWITCHES > CHORD_CORRECTION_MAX_SWITCHES) return false;
+
+    correctionIndex = (uint8_t*)malloc(CHORD_CORRECTION_INDEX_SIZE);
+    if (!correctionIndex) return false;
+    buildCorrectionIndex();
+    return true;
+}
+
 void ChordingEngine::executeChord(ChordPattern* pattern) {
     if (!pattern || !pattern->macroSequence) return;
     
@@ -213,7 +420,16 @@ bool ChordingEngine::addChord(uint32_t keyMask, const char* macroSequence) {
     if (!macroSequence || keyMask == 0) return false;
     
     // Check for valid chord (at least one non-modifier key)
-    if (getNonModifierKeys(keyMask) == 0) return false;
+    uint32_t keys = keyMask & CHORD_KEYS_MASK;
+    if (getNonModifierKeys(keys) == 0) return false;
+    
+    // An ordered chord's lead key is one of at least two keys
+    if (keyMask & CHORD_ORDER_KEY_MASK) {
+        uint8_t lead = ((keyMask & CHORD_ORDER_KEY_MASK) >> CHORD_ORDER_SHIFT) - 1;
+        if (lead >= NUM_SWITCHES || !(keys & (1UL << lead)) || singleKey(keys) != CHORD_NO_KEY) return false;
+    } else if (keyMask & ~CHORD_KEYS_MASK) {
+        return false;
+    }
     
     // Find existing pattern or create new one
     ChordPattern* pattern = findChordPattern(keyMask);
@@ -221,6 +437,7 @@ bool ChordingEngine::addChord(uint32_t keyMask, const char* macroSequence) {
     if (pattern) {
         // Update existing pattern
         if (pattern->macroSequence) {
+            chordHash -= configHashEntry(CONFIG_HASH_CHORD, keyMask, pattern->macroSequence);
             free(pattern->macroSequence);
         }
     } else {
@@ -245,6 +462,7 @@ bool ChordingEngine::addChord(uint32_t keyMask, const char* macroSequence) {
     }
     
     strcpy(pattern->macroSequence, macroSequence);
+    chordHash += configHashEntry(CONFIG_HASH_CHORD, keyMask, pattern->macroSequence);
     updateChordSwitchesMask();
     return true;
 }
@@ -263,6 +481,7 @@ bool ChordingEngine::removeChord(uint32_t keyMask) {
             }
             
             // Free memory
+            chordHash -= configHashEntry(CONFIG_HASH_CHORD, current->keyMask, current->macroSequence);
             freeChordPattern(current);
             updateChordSwitchesMask();
             return true;
@@ -279,7 +498,8 @@ void ChordingEngine::clearAllChords() {
         freeChordPattern(chordList);
         chordList = next;
     }
-    chordSwitchesMask = 0;
+    chordHash = 0;
+    updateChordSwitchesMask();
     resetState();
 }
 
@@ -293,12 +513,52 @@ void ChordingEngine::freeChordPattern(ChordPattern* pattern) {
 }
 
 void ChordingEngine::updateChordSwitchesMask() {
-    chordSwitchesMask = 0;
+    uint32_t lookupBits = 0;
     ChordPattern* current = chordList;
     while (current) {
-        chordSwitchesMask |= current->keyMask;
+        lookupBits |= current->keyMask;
         current = current->next;
     }
+    for (uint8_t i = 0; i < builtinChordCount; i++) {
+        BuiltinChord entry;
+        memcpy_P(&entry, &builtinChords[i], sizeof(BuiltinChord));
+        lookupBits |= entry.keyMask;
+    }
+    chordSwitchesMask = lookupBits & CHORD_KEYS_MASK;
+    hasOrderedChords = (lookupBits & CHORD_ORDER_KEY_MASK) != 0;
+    buildCorrectionIndex();
+}
+
+//==============================================================================
+// BUILT-IN CHORDS
+//==============================================================================
+
+void ChordingEngine::setBuiltinChords(const BuiltinChord* table, uint8_t count) {
+    builtinChords = table;
+    builtinChordCount = table ? count : 0;
+    updateChordSwitchesMask();
+    resetState();
+}
+
+const char* ChordingEngine::findBuiltinChord(uint32_t keyMask) const {
+    for (uint8_t i = 0; i < builtinChordCount; i++) {
+        BuiltinChord entry;
+        memcpy_P(&entry, &builtinChords[i], sizeof(BuiltinChord));
+        if (entry.keyMask == keyMask) {
+            return entry.macro;
+        }
+    }
+    return nullptr;
+}
+
+void ChordingEngine::forEachBuiltinChord(void (*callback)(uint32_t keyMask, const char* macro)) const {
+    for (uint8_t i = 0; i < builtinChordCount; i++) {
+        BuiltinChord entry;
+        memcpy_P(&entry, &builtinChords[i], sizeof(BuiltinChord));
+        if (callback) {
+            callback(entry.keyMask, entry.macro);
+        }
+    }
 }
 
 //==============================================================================
@@ -347,6 +607,12 @@ bool ChordingEngine::isChordDefined(uint32_t keyMask) const {
     return findChordPattern(keyMask) != nullptr;
 }
 
+bool ChordingEngine::isGestureDefined(uint32_t keyMask, uint8_t pressedKey, uint8_t releasedKey) const {
+    ChordPattern* pattern;
+    const char* builtin;
+    return lookupGesture(keyMask, pressedKey, releasedKey, pattern, builtin);
+}
+
 const char* ChordingEngine::getChordMacro(uint32_t keyMask) const {
     ChordPattern* pattern = findChordPattern(keyMask);
     return pattern ? pattern->macroSequence : nullptr;
@@ -373,6 +639,9 @@ void ChordingEngine::forEachChord(void (*callback)(uint32_t keyMask, const char*
 
 void setupChording() {
     // Chording engine initializes itself
+    if (CHORD_CORRECTION) {
+        chording.setCorrection(true);
+    }
 }
 
 bool processChording(uint32_t currentSwitchState) {
@@ -396,10 +665,12 @@ uint32_t parseKeyList(const char* keyList) {
         if (*pos) {
             // Parse key number
             int keyNum = 0;
+            const char* start = pos;
             while (*pos >= '0' && *pos <= '9') {
                 keyNum = keyNum * 10 + (*pos - '0');
                 pos++;
             }
+            if (pos == start) return 0;  // Not a key number - invalid list
             
             if (keyNum >= 0 && keyNum < NUM_SWITCHES) {
                 mask |= (1UL << keyNum);
@@ -410,10 +681,41 @@ uint32_t parseKeyList(const char* keyList) {
     return mask;
 }
 
+uint32_t parseChordKeys(const char* keyList) {
+    if (!keyList) return 0;
+    const char* order = keyList;
+    while (*order && *order != '>' && *order != '^') order++;
+    if (!*order) return parseKeyList(keyList);
+    
+    // "<lead>>" or "<lead>^" then the other keys
+    const char* pos = keyList;
+    while (*pos == ' ') pos++;
+    int lead = 0;
+    const char* start = pos;
+    while (*pos >= '0' && *pos <= '9') {
+        lead = lead * 10 + (*pos - '0');
+        pos++;
+    }
+    while (*pos == ' ') pos++;
+    if (pos == start || pos != order || lead >= NUM_SWITCHES) return 0;
+    
+    uint32_t others = parseKeyList(order + 1);
+    if (others == 0 || (others & (1UL << lead))) return 0;
+    return orderedChordKey(others | (1UL << lead), lead, *order == '^');
+}
+
 String formatKeyMask(uint32_t keyMask) {
     String result = "";
     bool first = true;
     
+    // Ordered chord: lead key, then the others
+    if (keyMask & CHORD_ORDER_KEY_MASK) {
+        uint8_t lead = ((keyMask & CHORD_ORDER_KEY_MASK) >> CHORD_ORDER_SHIFT) - 1;
+        result += String(lead);
+        result += (keyMask & CHORD_ORDER_RELEASE) ? "^" : ">";
+        keyMask &= CHORD_KEYS_MASK & ~(1UL << lead);
+    }
+    
     for (int i = 0; i < NUM_SWITCHES; i++) {
         if (keyMask & (1UL << i)) {
             if (!first) result += "+";
@@ -6,6 +6,8 @@
  * - Conflict prevention between chord and individual switches
  * - Automatic chord pattern adjustment during release
  * - Modifier key support
+ * - Optional correction of chords one key off a defined chord
+ * - Ordered chords, told apart by the key pressed or released first
  */
 
 #ifndef CHORDING_H
@@ -13,6 +15,34 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "builtin-profile.h"
+
+// A non-chord key press during a chord suppresses execution for this long
+#define CHORD_CANCELLATION_TIMEOUT_MS 2000
+
+// Correction index: one nibble per possible key mask, so its size doubles
+// with every switch; correction is unavailable on larger boards
+#define CHORD_CORRECTION_MAX_SWITCHES 12
+#define CHORD_CORRECTION_INDEX_SIZE ((1UL << NUM_SWITCHES) / 2)
+
+// Ordered chords: a chord's lookup key can also name the key that must be
+// pressed (or released) first, in the bits above the key mask - "2>0+1"
+// and "2^0+1". The same keys as an unordered chord are then several
+// bindings, with no extra wait. Keys changing in the same scan have no order.
+#define CHORD_ORDER_SHIFT    24
+#define CHORD_KEYS_MASK      ((1UL << CHORD_ORDER_SHIFT) - 1)
+#define CHORD_ORDER_KEY_MASK (0x1FUL << CHORD_ORDER_SHIFT)   // Lead key + 1
+#define CHORD_ORDER_RELEASE  (1UL << 29)                     // Released first
+#define CHORD_NO_KEY         0xFF
+
+#if NUM_SWITCHES > CHORD_ORDER_SHIFT
+#error "Ordered chords keep the lead key above bit NUM_SWITCHES - 1"
+#endif
+
+// Lookup key for keys with lead first
+inline uint32_t orderedChordKey(uint32_t keyMask, uint8_t lead, bool release) {
+    return keyMask | ((uint32_t)(lead + 1) << CHORD_ORDER_SHIFT) | (release ? CHORD_ORDER_RELEASE : 0);
+}
 
 //==============================================================================
 // CHORD PATTERN STRUCTURE
@@ -34,6 +64,25 @@ enum ChordState {
     CHORD_CANCELLATION             // Non-chord key pressed, suppressing execution
 };
 
+//==============================================================================
+// STATE MACHINE SNAPSHOT
+//==============================================================================
+
+// Runtime state only (not the chord table) - lets host tools branch the
+// state machine without replaying every event
+struct ChordRuntimeState {
+    ChordState state;
+    uint32_t capturedChord;
+    uint32_t pressedKeys;
+    uint32_t lastSwitchState;
+    uint32_t executionWindowStart;
+    bool executionWindowActive;
+    uint32_t cancellationStartTime;
+    uint32_t gestureStartTime;
+    uint8_t firstPressedKey;
+    uint8_t firstReleasedKey;
+};
+
 //==============================================================================
 // CHORDING ENGINE CLASS
 //==============================================================================
@@ -44,6 +93,10 @@ private:
     ChordPattern* chordList;
     uint32_t modifierKeyMask;       // Which keys are modifiers
     uint32_t chordSwitchesMask;     // Bitmask of all switches used in any chord
+    bool hasOrderedChords;          // Any lookup key with CHORD_ORDER_KEY_MASK bits
+    uint64_t chordHash;             // Sum of configuration hash entries for all chords
+    const BuiltinChord* builtinChords; // Read-only flash chords beneath chordList
+    uint8_t builtinChordCount;
     
     // State machine
     ChordState state;
@@ -56,9 +109,22 @@ private:
     uint32_t executionWindowStart; // Window start time
     bool executionWindowActive;    // Window active flag
     uint32_t cancellationStartTime; // Cancellation window start time
+    uint32_t gestureStartTime;      // First chord key press, for SPEED
+    uint8_t firstPressedKey;        // Lead key of the gesture, CHORD_NO_KEY if none
+    uint8_t firstReleasedKey;       // Key whose release opened the execution window
+    
+    // Correction of near-miss chords (nullptr = off)
+    uint8_t* correctionIndex;       // Per mask: 0 none, key+1 to flip, 0xF ambiguous
+    uint16_t correctedCount;
+    uint16_t undefinedCount;
     
     // Helper methods
     ChordPattern* findChordPattern(uint32_t keyMask) const;
+    bool lookupChord(uint32_t keyMask, ChordPattern*& pattern, const char*& builtin) const;
+    bool lookupGesture(uint32_t keyMask, uint8_t pressedKey, uint8_t releasedKey,
+                       ChordPattern*& pattern, const char*& builtin) const;
+    uint32_t findCorrection(uint32_t keyMask) const;
+    void buildCorrectionIndex();
     void executeChord(ChordPattern* pattern);
     void freeChordPattern(ChordPattern* pattern);
     void updateChordSwitchesMask();
@@ -76,11 +142,16 @@ public:
     // Main processing function - call from main loop
     bool processChording(uint32_t currentSwitchState);
     
-    // Chord management
+    // Chord management - keyMask is the lookup key, ordered or not
     bool addChord(uint32_t keyMask, const char* macroSequence);
     bool removeChord(uint32_t keyMask);
     void clearAllChords();
     
+    // Built-in (PROGMEM) chords - chordList entries with the same mask take precedence
+    void setBuiltinChords(const BuiltinChord* table, uint8_t count);
+    const char* findBuiltinChord(uint32_t keyMask) const;
+    void forEachBuiltinChord(void (*callback)(uint32_t keyMask, const char* macro)) const;
+    
     // Modifier key management
     bool setModifierKey(uint8_t keyIndex, bool isModifier);
     bool isModifierKey(uint8_t keyIndex) const;
@@ -91,17 +162,31 @@ public:
     void setExecutionWindowMs(uint32_t windowMs) { executionWindowMs = windowMs; }
     uint32_t getExecutionWindowMs() const { return executionWindowMs; }
     
+    // Fire the only chord one key away from an undefined chord; false if
+    // the index could not be allocated
+    bool setCorrection(bool enabled);
+    bool isCorrectionEnabled() const { return correctionIndex != nullptr; }
+    uint16_t getCorrectedCount() const { return correctedCount; }
+    uint16_t getUndefinedCount() const { return undefinedCount; }
+    void resetChordStats() { correctedCount = 0; undefinedCount = 0; }
+    
     // Query functions
     int getChordCount() const;
     bool isChordDefined(uint32_t keyMask) const;
+    // Lookup a released gesture gets: chordList and built-ins, ordered by
+    // its first pressed / released key (CHORD_NO_KEY if none), then unordered
+    bool isGestureDefined(uint32_t keyMask, uint8_t pressedKey, uint8_t releasedKey) const;
     const char* getChordMacro(uint32_t keyMask) const;
     bool isSwitchUsedInChords(uint8_t switchIndex) const;
     uint32_t getChordSwitchesMask() const { return chordSwitchesMask; }
+    uint64_t getChordHash() const { return chordHash; }
     
     // State queries
     ChordState getCurrentState() const { return state; }
     uint32_t getCurrentChord() const { return capturedChord; }
     bool isExecutionWindowActive() const { return executionWindowActive; }
+    ChordRuntimeState saveRuntimeState() const;
+    void restoreRuntimeState(const ChordRuntimeState& saved);
     
     // Iteration support for commands and storage
     void forEachChord(void (*callback)(uint32_t keyMask, const char* macro)) const;
@@ -113,6 +198,10 @@ public:
 
 extern ChordingEngine chording;
 
+// Called with the keys of a chord released in time with no macro, nullptr
+// when unused (the host event channel reports these)
+extern void (*undefinedChordHook)(uint32_t keyMask);
+
 // Setup function
 void setupChording();
 
@@ -121,6 +210,7 @@ bool processChording(uint32_t currentSwitchState);
 
 // Chord pattern parsing helpers
 uint32_t parseKeyList(const char* keyList);  // "0,1,5" -> bitmask
-String formatKeyMask(uint32_t keyMask);      // bitmask -> "0+1+5"
+uint32_t parseChordKeys(const char* keyList); // parseKeyList, or "2>0+1" / "2^0+1" ordered
+String formatKeyMask(uint32_t keyMask);      // bitmask -> "0+1+5", ordered "2>0+1"
 
 #endif // CHORDING_H
@@ -0,0 +1,170 @@
+/*
+ * BENCH Command Implementation
+ *
+ * Times the firmware hot paths on the device itself. Each operation is
+ * repeated, doubling the count until a run takes BENCH_MIN_US, and the cost
+ * of the empty timing loop is subtracted. The input task runs between
+ * runs, so keys are only held up for one run (at most twice BENCH_MIN_US).
+ */
+
+#include "../serial-interface.h"
+#include "../macro-engine.h"
+#include "../chording.h"
+#include "../scheduler.h"
+
+#define BENCH_MIN_US        20000UL
+#define BENCH_MAX_ITERATIONS 65536UL
+
+// Reference macro - modifiers, text, function and navigation keys
+static const char BENCH_MACRO[] = "CTRL+SHIFT T \"hello, world\" ENTER F5 +ALT TAB -ALT HOME";
+
+static uint8_t benchBytes[64];
+static uint16_t benchLength = 0;
+static uint32_t benchChordKeys = 0;       // Gesture no chord matches
+static uint8_t benchLeadKey = CHORD_NO_KEY;
+static uint8_t benchReleaseKey = CHORD_NO_KEY;
+static volatile uint32_t benchResult;     // Keeps results live for the optimizer
+
+//==============================================================================
+// BENCHMARKED OPERATIONS
+//==============================================================================
+
+typedef void (*BenchOp)();
+
+static void benchEmpty() {
+}
+
+static void benchEncode() {
+  MacroEncodeResult parsed = macroEncode(BENCH_MACRO);
+  benchResult = (uintptr_t)parsed.error;
+  free(parsed.utf8Sequence);
+}
+
+static void benchDecode() {
+  String decoded = macroDecode(benchBytes, benchLength);
+  benchResult = decoded.length();
+}
+
+// Worst case: a released gesture no pattern matches, so the whole list
+// (and the built-in chords) is walked with every candidate
+static void benchChordLookup() {
+  benchResult = chording.isGestureDefined(benchChordKeys, benchLeadKey, benchReleaseKey);
+}
+
+// Pick the largest run of low keys (at least two) no chord matches in any
+// order, led by its lowest key and first released at its highest
+static bool benchPickMissingChord() {
+  for (uint8_t keys = NUM_SWITCHES; keys >= 2; keys--) {
+    uint32_t mask = (1UL << keys) - 1;
+    if (!chording.isGestureDefined(mask, 0, keys - 1)) {
+      benchChordKeys = mask;
+      benchLeadKey = 0;
+      benchReleaseKey = keys - 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void benchSwitchScan() {
+  benchResult = loopSwitches();
+}
+
+#ifdef __AVR__
+static void benchSwitchRead() {
+  benchResult = switches.readAllSwitches();
+}
+#endif
+
+static void benchDryRun() {
+  benchResult = dryRunUTF8Macro(benchBytes, benchLength);
+}
+
+//==============================================================================
+// TIMING
+//==============================================================================
+
+// Elapsed µs for the calibrated iteration count
+static uint32_t benchTime(BenchOp op, uint32_t iterations) {
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < iterations; i++) op();
+  return micros() - start;
+}
+
+// Nanoseconds per call, net of loop overhead
+static uint32_t benchMeasure(BenchOp op) {
+  uint32_t iterations = 1;
+  uint32_t elapsed = benchTime(op, iterations);
+  while (elapsed < BENCH_MIN_US && iterations < BENCH_MAX_ITERATIONS) {
+    schedulerYield();
+    iterations *= 2;
+    elapsed = benchTime(op, iterations);
+  }
+
+  schedulerYield();
+  uint32_t overhead = benchTime(benchEmpty, iterations);
+  elapsed = elapsed > overhead ? elapsed - overhead : 0;
+  return (uint32_t)((uint64_t)elapsed * 1000 / iterations);
+}
+
+// Prints "<µs>.<hundredths> us/op" after the caller's label
+static void benchReport(BenchOp op) {
+  uint32_t ns = benchMeasure(op);
+
+  Serial.print(ns / 1000);
+  Serial.print('.');
+  uint32_t fraction = (ns % 1000) / 10;
+  if (fraction < 10) Serial.print('0');
+  Serial.print(fraction);
+  Serial.print(F(" us/op"));
+#ifdef F_CPU
+  Serial.print(F(" ("));
+  Serial.print((uint32_t)((uint64_t)ns * (F_CPU / 1000000UL) / 1000));
+  Serial.print(F(" cycles)"));
+#endif
+  Serial.println();
+}
+
+//==============================================================================
+// BENCH COMMAND
+//==============================================================================
+
+void cmdBench() {
+  MacroEncodeResult parsed = macroEncode(BENCH_MACRO);
+  // No sequence is allocated on error (e.g. out of memory)
+  size_t length = parsed.error ? 0 : strlen(parsed.utf8Sequence);
+  if (parsed.error || length > sizeof(benchBytes)) {
+    Serial.println(F("Reference macro failed to encode"));
+    free(parsed.utf8Sequence);
+    return;
+  }
+  memcpy(benchBytes, parsed.utf8Sequence, length);
+  benchLength = length;
+  free(parsed.utf8Sequence);
+
+  Serial.print(F("Benchmark ("));
+  Serial.print(benchLength);
+  Serial.print(F(" byte macro, "));
+  Serial.print(chording.getChordCount());
+  Serial.println(F(" chords):"));
+
+  Serial.print(F("  encode: "));
+  benchReport(benchEncode);
+  Serial.print(F("  decode: "));
+  benchReport(benchDecode);
+  if (benchPickMissingChord()) {
+    Serial.print(F("  chord lookup: "));
+    benchReport(benchChordLookup);
+  }
+#ifdef __AVR__
+  Serial.print(F("  switch read: "));
+  benchReport(benchSwitchRead);
+  Serial.print(F("  switch scan+debounce: "));
+  benchReport(benchSwitchScan);
+#else
+  Serial.print(F("  switch scan: "));
+  benchReport(benchSwitchScan);
+#endif
+  Serial.print(F("  execute (dry run): "));
+  benchReport(benchDryRun);
+}
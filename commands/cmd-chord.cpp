@@ -9,6 +9,7 @@
 #include "../chording.h"
 #include "../storage.h"
 #include "../chordStorage.h"
+#include "../builtin-profile.h"
 
 //==============================================================================
 // CHORD COMMAND IMPLEMENTATION
@@ -39,8 +40,8 @@ void cmdChord(const char* args) {
     strncpy(keyList, args, keyListLen);
     keyList[keyListLen] = '\0';
     
-    // Parse key mask
-    uint32_t keyMask = parseKeyList(keyList);
+    // Parse key mask, with the lead key of an ordered chord
+    uint32_t keyMask = parseChordKeys(keyList);
     if (keyMask == 0) {
       Serial.println(F("Invalid key list"));
       return;
@@ -53,7 +54,7 @@ void cmdChord(const char* args) {
     }
     
     // Check for minimum chord requirement (at least 1 non-modifier key)
-    uint32_t nonModifierKeys = keyMask & ~chording.getModifierMask();
+    uint32_t nonModifierKeys = keyMask & CHORD_KEYS_MASK & ~chording.getModifierMask();
     if (nonModifierKeys == 0) {
       Serial.println(F("Chord must have at least 1 non-modifier key"));
       return;
@@ -93,7 +94,7 @@ void cmdChord(const char* args) {
     while (isspace(*args)) args++;
     
     // Parse key list
-    uint32_t keyMask = parseKeyList(args);
+    uint32_t keyMask = parseChordKeys(args);
     if (keyMask == 0) {
       Serial.println(F("Invalid key list"));
       return;
@@ -123,7 +124,16 @@ void cmdChord(const char* args) {
       Serial.println(readable);
     });
     
-    if (chording.getChordCount() == 0) {
+    // Built-in chords not overridden above
+    chording.forEachBuiltinChord([](uint32_t keyMask, const char* macro) {
+      if (chording.isChordDefined(keyMask)) return;
+      Serial.print(F("  "));
+      Serial.print(formatKeyMask(keyMask));
+      Serial.print(F(": (built-in) "));
+      Serial.println(decodeBuiltinMacro(macro));
+    });
+    
+    if (chording.getChordSwitchesMask() == 0) {
       Serial.println(F("  (no chords defined)"));
     }
   }
@@ -177,6 +187,35 @@ void cmdChord(const char* args) {
       Serial.println(formatKeyMask(modifierMask));
     }
   }
+  else if (strncasecmp(args, "CORRECT", 7) == 0) {
+    args += 7;
+    while (isspace(*args)) args++;
+    
+    if (strncasecmp(args, "ON", 2) == 0) {
+      if (!chording.setCorrection(true)) {
+        Serial.println(F("Not enough memory for chord correction"));
+        return;
+      }
+    }
+    else if (strncasecmp(args, "OFF", 3) == 0) {
+      chording.setCorrection(false);
+    }
+    else if (strncasecmp(args, "RESET", 5) == 0) {
+      chording.resetChordStats();
+    }
+    else if (*args != '\0') {
+      Serial.println(F("Usage: CHORD CORRECT [ON|OFF|RESET]"));
+      return;
+    }
+    
+    Serial.print(F("Chord correction: "));
+    Serial.print(chording.isCorrectionEnabled() ? F("on") : F("off"));
+    Serial.print(F(", "));
+    Serial.print(chording.getCorrectedCount());
+    Serial.print(F(" corrected, "));
+    Serial.print(chording.getUndefinedCount());
+    Serial.println(F(" undefined"));
+  }
   else if (strncasecmp(args, "STATUS", 6) == 0) {
     
     if (chording.getCurrentChord() != 0) {
@@ -189,6 +228,9 @@ void cmdChord(const char* args) {
     
     Serial.print(F("Modifier keys: "));
     Serial.println(formatKeyMask(chording.getModifierMask()));
+    
+    Serial.print(F("Correction: "));
+    Serial.println(chording.isCorrectionEnabled() ? F("on") : F("off"));
   }
   else {
     Serial.println(F("Usage:"));
@@ -198,11 +240,13 @@ void cmdChord(const char* args) {
     Serial.println(F("  CHORD CLEAR                    - Clear all chords"));
     Serial.println(F("  CHORD MODIFIERS [keys]         - Set/show modifier keys"));
     Serial.println(F("  CHORD MODIFIERS CLEAR          - Clear all modifiers"));
+    Serial.println(F("  CHORD CORRECT [ON|OFF|RESET]   - Near-miss correction and counts"));
     Serial.println(F("  CHORD STATUS                   - Show chording status"));
     Serial.println(F(""));
     Serial.println(F("Examples:"));
     Serial.println(F("  CHORD ADD 0,1 \"hello\"          - Keys 0+1 types hello"));
     Serial.println(F("  CHORD ADD 2+3+4 CTRL C         - Keys 2+3+4 sends Ctrl+C"));
+    Serial.println(F("  CHORD ADD 2>3+4 CTRL V         - Same keys, 2 pressed first"));
     Serial.println(F("  CHORD MODIFIERS 1,6             - Set keys 1&6 as modifiers"));
     Serial.println(F("  CHORD REMOVE 0,1               - Remove 0+1 chord"));
   }
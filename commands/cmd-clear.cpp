@@ -9,16 +9,10 @@
 void cmdClearWithSwitchAndDirection(int switchNum, int direction, const char* remainingArgs) {
   if (direction == DIRECTION_DOWN || direction == DIRECTION_UNK) {
     // Clear both up and down macros when direction is unknown/ambiguous
-    if (macros[switchNum].downMacro) {
-      free(macros[switchNum].downMacro);
-      macros[switchNum].downMacro = nullptr;
-    }
+    setSwitchMacro(switchNum, false, nullptr);
   }
   if (direction == DIRECTION_UP || direction == DIRECTION_UNK) {
-    if (macros[switchNum].upMacro) {
-      free(macros[switchNum].upMacro);
-      macros[switchNum].upMacro = nullptr;
-    }
+    setSwitchMacro(switchNum, true, nullptr);
   }
   
   Serial.println(F("Cleared"));
@@ -0,0 +1,30 @@
+/*
+ * CONFIG Command Implementation
+ * 
+ * Configuration-wide queries for fleet verification
+ */
+
+#include "../serial-interface.h"
+#include "../storage.h"
+#include "../chording.h"
+#include "../config-hash.h"
+
+// Current configuration hash - O(1), partial sums are maintained on every change
+uint64_t getConfigHash() {
+  return configHashCombine(getKeyMacroHash(), chording.getChordHash(), chording.getModifierMask());
+}
+
+void cmdConfig(const char* args) {
+  while (isspace(*args)) args++;
+  
+  if (strncasecmp(args, "HASH", 4) == 0) {
+    char hashText[17];
+    formatConfigHash(getConfigHash(), hashText);
+    Serial.print(F("Config hash: "));
+    Serial.println(hashText);
+  }
+  else {
+    Serial.println(F("Usage:"));
+    Serial.println(F("  CONFIG HASH                    - Show configuration hash"));
+  }
+}
@@ -0,0 +1,86 @@
+/*
+ * DUMP Command Implementation
+ *
+ * Prints every binding as its raw UTF-8+ bytes, one length-framed record
+ * per line, for tools/kpconfig to decode on the host:
+ *
+ *   M <mask>                     Chord modifier keys
+ *   K <key> <D|U> <len> <hex>    Key macro
+ *   C <mask> <len> <hex>         Chord macro
+ *   BK / BC ...                  Built-in binding that still applies
+ *   END <records>
+ *
+ * Masks and bytes are hex. Nothing is decoded, so this works in builds
+ * without the macro decoder (MACRO_DECODER 0).
+ */
+
+#include "../serial-interface.h"
+#include "../builtin-profile.h"
+
+static uint16_t dumpRecords;
+
+static void dumpHexByte(uint8_t b) {
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+  Serial.print(HEX_DIGITS[b >> 4]);
+  Serial.print(HEX_DIGITS[b & 0x0F]);
+}
+
+static void dumpMask(uint32_t keyMask) {
+  Serial.print(F(" "));
+  Serial.print((unsigned long)keyMask, HEX);
+}
+
+// " <len> <hex>" and the end of the record; progmem for built-in macros
+static void dumpBytes(const char* macro, bool progmem) {
+  uint16_t length = progmem ? strlen_P(macro) : strlen(macro);
+  Serial.print(F(" "));
+  Serial.print(length);
+  Serial.print(F(" "));
+  for (uint16_t i = 0; i < length; i++) {
+    dumpHexByte(progmem ? pgm_read_byte(macro + i) : (uint8_t)macro[i]);
+  }
+  Serial.println();
+  dumpRecords++;
+}
+
+static void dumpKey(uint8_t key, bool up) {
+  const char* macro = up ? macros[key].upMacro : macros[key].downMacro;
+  bool builtin = !macro || !*macro;
+  if (builtin) {
+    macro = findBuiltinKeyMacro(key, up);
+    if (!macro) return;
+  }
+  Serial.print(builtin ? F("BK ") : F("K "));
+  Serial.print(key);
+  Serial.print(up ? F(" U") : F(" D"));
+  dumpBytes(macro, builtin);
+}
+
+void cmdDump() {
+  dumpRecords = 0;
+
+  Serial.print(F("M"));
+  dumpMask(chording.getModifierMask());
+  Serial.println();
+  dumpRecords++;
+
+  for (uint8_t i = 0; i < NUM_SWITCHES; i++) {
+    dumpKey(i, false);
+    dumpKey(i, true);
+  }
+
+  chording.forEachChord([](uint32_t keyMask, const char* macro) {
+    Serial.print(F("C"));
+    dumpMask(keyMask);
+    dumpBytes(macro, false);
+  });
+  chording.forEachBuiltinChord([](uint32_t keyMask, const char* macro) {
+    if (chording.isChordDefined(keyMask)) return;
+    Serial.print(F("BC"));
+    dumpMask(keyMask);
+    dumpBytes(macro, true);
+  });
+
+  Serial.print(F("END "));
+  Serial.println(dumpRecords);
+}
@@ -0,0 +1,29 @@
+/*
+ * EVENTS Command Implementation
+ *
+ * Turns the binary host event channel on or off
+ */
+
+#include "../serial-interface.h"
+#include "../host-events.h"
+
+void cmdEvents(const char* args) {
+  while (isspace(*args)) args++;
+
+  if (strncasecmp(args, "ON", 2) == 0) {
+    setHostEvents(true);
+  }
+  else if (strncasecmp(args, "OFF", 3) == 0) {
+    setHostEvents(false);
+  }
+  else if (*args) {
+    Serial.println(F("Usage: EVENTS [ON|OFF]"));
+    return;
+  }
+
+  Serial.print(F("Host events: "));
+  Serial.print(hostEventsEnabled() ? F("on") : F("off"));
+  Serial.print(F(", "));
+  Serial.print((unsigned long)hostEventCount());
+  Serial.println(F(" sent"));
+}
@@ -25,14 +25,25 @@ void cmdHelp() {
   Serial.println(F("CHORD MODIFIERS [keys] - set/show modifier keys"));
   Serial.println(F("CHORD LOAD - load chords from EEPROM"));
   Serial.println(F("CHORD STATUS - show chording status"));
+  Serial.println(F("CHORD CORRECT [ON|OFF|RESET] - fix chords one key off"));
   
   Serial.println(F("\n=== System ==="));
-  Serial.println(F("STAT - show status"));
+  Serial.println(F("STAT - show status and stack use"));
+  Serial.println(F("CONFIG HASH - show configuration hash"));
+  Serial.println(F("BENCH - time hot paths on this board"));
+  Serial.println(F("SIM <ADD|ROLL|RUN|LIST|REPORT> - inject switch timelines"));
+  Serial.println(F("JOURNAL [SAVED|DUMP|SAVE|CLEAR] - recent switch/chord/macro events"));
+  Serial.println(F("TASKS [RESET] - main loop task timing and overruns"));
+  Serial.println(F("PREEMPT [ABORT|PRIORITY <keys|NONE>] - abort gesture, priority keys"));
+  Serial.println(F("EVENTS [ON|OFF] - binary frames for unbound keys and chords"));
+  Serial.println(F("SPEED [RESET] - chars, WPM, chords/min over 10s and 1min"));
+  Serial.println(F("DUMP - raw bindings as hex for kpconfig show"));
   
   // FIXED: Use NUM_SWITCHES to show correct key range
   Serial.print(F("\nKeys: 0-"));
   Serial.print(NUM_SWITCHES - 1);
   Serial.println(F(", direction: down(default) or up"));
-  Serial.println(F("Chord keys: 0,1,5 or 0+1+5 format"));
+  Serial.println(F("Chord keys: 0,1,5 or 0+1+5 format; 5>0+1 = 5 pressed first, 5^0+1 = released first"));
   Serial.println(F("Modifier keys don't need release to trigger chords"));
+  Serial.println(F("Mouse: MOVE:x,y SCROLL:n CLICK[:LEFT+RIGHT+MIDDLE] MOUSEDOWN/MOUSEUP:btns"));
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*
+ * JOURNAL Command Implementation
+ *
+ * Shows, dumps, saves and clears the black-box event journal
+ */
+
+#include "../serial-interface.h"
+#include "../journal.h"
+
+static void journalUsage() {
+  Serial.println(F("Usage:"));
+  Serial.println(F("  JOURNAL [SAVED]                - Show events (SAVED = EEPROM copy)"));
+  Serial.println(F("  JOURNAL DUMP [SAVED]           - Binary image as hex (tools/kpjournal)"));
+  Serial.println(F("  JOURNAL SAVE                   - Copy events to EEPROM"));
+  Serial.println(F("  JOURNAL CLEAR                  - Forget events and the EEPROM copy"));
+}
+
+// One line per event, ms relative to the oldest
+static void journalShow(bool saved) {
+  uint8_t count = journalImageCount(saved);
+  if (count == 0) {
+    Serial.println(saved ? F("No saved journal") : F("Journal empty"));
+    return;
+  }
+
+  uint16_t firstMs = journalImageEntry(saved, 0).timeMs;
+  for (uint8_t i = 0; i < count; i++) {
+    JournalEntry entry = journalImageEntry(saved, i);
+    uint16_t ms = entry.timeMs - firstMs;
+    Serial.print(F("  +"));
+    Serial.print((unsigned int)ms);
+    Serial.print(F("ms "));
+    Serial.println(formatJournalEntry(entry));
+  }
+}
+
+// Header and used entries, 16 bytes per line
+static void journalDump(bool saved) {
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+  uint8_t count = journalImageCount(saved);
+  if (saved && count == 0) {
+    Serial.println(F("No saved journal"));
+    return;
+  }
+
+  uint16_t size = JOURNAL_HEADER_SIZE + count * JOURNAL_ENTRY_SIZE;
+
+  for (uint16_t offset = 0; offset < size; offset++) {
+    uint8_t b = journalImageByte(saved, offset);
+    Serial.print(HEX_DIGITS[b >> 4]);
+    Serial.print(HEX_DIGITS[b & 0x0F]);
+    if (offset % 16 == 15 || offset + 1 == size) Serial.println();
+  }
+}
+
+void cmdJournal(const char* args) {
+  while (isspace(*args)) args++;
+
+  if (*args == '\0') {
+    journalShow(false);
+  } else if (strncasecmp(args, "SAVED", 5) == 0) {
+    journalShow(true);
+  } else if (strncasecmp(args, "DUMP", 4) == 0) {
+    args += 4;
+    while (isspace(*args)) args++;
+    journalDump(strncasecmp(args, "SAVED", 5) == 0);
+  } else if (strncasecmp(args, "SAVE", 4) == 0) {
+    if (!saveJournal()) {
+      Serial.println(F("Journal region holds configuration - SAVE it first"));
+      return;
+    }
+    Serial.print(F("Saved "));
+    Serial.print(journalImageCount(true));
+    Serial.println(F(" events"));
+  } else if (strncasecmp(args, "CLEAR", 5) == 0) {
+    Serial.println(clearJournal() ? F("Journal cleared") : F("Journal cleared (EEPROM copy region holds configuration)"));
+  } else {
+    journalUsage();
+  }
+}
@@ -36,6 +36,9 @@ void cmdLoad() {
     }
     
     Serial.println(F("Loaded"));
+    if (!journalRegionFree()) {
+      Serial.println(F("Configuration runs into the journal region - SAVE to move it below"));
+    }
   } else {
     Serial.println(F("No chord data found (switch macros loaded)"));
   }
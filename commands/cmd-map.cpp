@@ -19,12 +19,8 @@ void cmdMapWithSwitchAndDirection(int switchNum, int direction, const char* rema
     return;
   }
   
-  // Free existing macro
-  char** target = (direction == DIRECTION_UP) ? &macros[switchNum].upMacro : &macros[switchNum].downMacro;
-  if (*target) {
-    free(*target);
-  }
-  *target = parsed.utf8Sequence;
+  // Replace existing macro (frees the old one)
+  setSwitchMacro(switchNum, direction == DIRECTION_UP, parsed.utf8Sequence);
   
   Serial.println(F("OK"));
 }
@@ -2,7 +2,7 @@
 #include "../config.h"
 #include "cmd-parsing.h"
 
-bool parseSwitchAndDirection(const char* args, int* switchNum, int* direction, const char** remainingArgs) {
+bool scanSwitchAndDirection(const char* args, int* switchNum, int* direction, const char** remainingArgs) {
   // Skip leading whitespace
   while (isspace(*args)) args++;
   
@@ -10,8 +10,6 @@ bool parseSwitchAndDirection(const char* args, int* switchNum, int* direction, c
   char* endptr;
   int key = strtol(args, &endptr, 10);
   if (key < 0 || key >= NUM_SWITCHES || endptr == args) {
-    Serial.print(F("Invalid key 0-"));
-    Serial.println(NUM_SWITCHES - 1);
     return false;
   }
   
@@ -45,6 +43,13 @@ bool parseSwitchAndDirection(const char* args, int* switchNum, int* direction, c
   return true;
 }
 
+bool parseSwitchAndDirection(const char* args, int* switchNum, int* direction, const char** remainingArgs) {
+  if (scanSwitchAndDirection(args, switchNum, direction, remainingArgs)) return true;
+  Serial.print(F("Invalid key 0-"));
+  Serial.println(NUM_SWITCHES - 1);
+  return false;
+}
+
 void executeWithSwitchAndDirection(const char* args, SwitchDirectionCommandFunc commandFunc) {
   int switchNum, direction;
   const char* remainingArgs;
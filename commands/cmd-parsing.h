@@ -31,6 +31,9 @@ typedef void (*SwitchDirectionCommandFunc)(int switchNum, int direction, const c
 //            remainingArgs points to any remaining arguments after direction
 bool parseSwitchAndDirection(const char* args, int* switchNum, int* direction, const char** remainingArgs);
 
+// As parseSwitchAndDirection, but sends nothing to Serial on error
+bool scanSwitchAndDirection(const char* args, int* switchNum, int* direction, const char** remainingArgs);
+
 // Execute a command function with parsed switch and direction
 void executeWithSwitchAndDirection(const char* args, SwitchDirectionCommandFunc commandFunc);
 
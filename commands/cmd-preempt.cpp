@@ -0,0 +1,52 @@
+/*
+ * PREEMPT Command Implementation
+ *
+ * Sets the abort gesture and priority keys for running macros
+ */
+
+#include "../serial-interface.h"
+#include "../macro-engine.h"
+#include "../chording.h"
+
+// Key list or NONE; false if neither
+static bool parsePreemptKeys(const char* args, uint32_t& keyMask) {
+  if (strncasecmp(args, "NONE", 4) == 0) {
+    keyMask = 0;
+    return true;
+  }
+  keyMask = parseKeyList(args);
+  return keyMask != 0;
+}
+
+void cmdPreempt(const char* args) {
+  while (isspace(*args)) args++;
+
+  if (strncasecmp(args, "ABORT", 5) == 0 || strncasecmp(args, "PRIORITY", 8) == 0) {
+    bool abort = toupper(*args) == 'A';
+    args += abort ? 5 : 8;
+    while (isspace(*args)) args++;
+
+    uint32_t keyMask;
+    if (!parsePreemptKeys(args, keyMask)) {
+      Serial.println(F("Invalid key list"));
+      return;
+    }
+    (abort ? macroAbortKeys : macroPriorityKeys) = keyMask;
+  }
+  else if (strncasecmp(args, "RESET", 5) == 0) {
+    resetMacroPreemptStats();
+  }
+  else if (*args) {
+    Serial.println(F("Usage: PREEMPT [ABORT <keys|NONE>|PRIORITY <keys|NONE>|RESET]"));
+    return;
+  }
+
+  Serial.print(F("Abort keys: "));
+  Serial.println(formatKeyMask(macroAbortKeys));
+  Serial.print(F("Priority keys: "));
+  Serial.println(formatKeyMask(macroPriorityKeys));
+  Serial.print(F("Aborts: "));
+  Serial.print(macroPreemptStats().aborts);
+  Serial.print(F(", preemptions: "));
+  Serial.println(macroPreemptStats().preemptions);
+}
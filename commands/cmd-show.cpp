@@ -5,6 +5,18 @@
  */
 
 #include "cmd-parsing.h"
+#include "../builtin-profile.h"
+
+// Empty overlay - show the built-in binding that still applies, if any
+static void printEmptyMacro(int switchNum, bool up) {
+  const char* builtin = findBuiltinKeyMacro(switchNum, up);
+  if (builtin) {
+    Serial.print(F("(built-in) "));
+    Serial.println(decodeBuiltinMacro(builtin));
+  } else {
+    Serial.println(F("(empty)"));
+  }
+}
 
 void printMacro(int switchNum, int direction) {
   if (direction == DIRECTION_DOWN || direction == DIRECTION_UNK) {
@@ -15,7 +27,7 @@ void printMacro(int switchNum, int direction) {
       String readable = macroDecode((const uint8_t*)macros[switchNum].downMacro, strlen(macros[switchNum].downMacro));
       Serial.println(readable);
     } else {
-      Serial.println(F("(empty)"));
+      printEmptyMacro(switchNum, false);
     }
   }
     
@@ -27,7 +39,7 @@ void printMacro(int switchNum, int direction) {
       String readable = macroDecode((const uint8_t*)macros[switchNum].upMacro, strlen(macros[switchNum].upMacro));
       Serial.println(readable);
     } else {
-      Serial.println(F("(empty)"));
+      printEmptyMacro(switchNum, true);
     }
     return;
   }
@@ -0,0 +1,124 @@
+/*
+ * SIM Command Implementation
+ *
+ * Programs and runs injected switch timelines for latency measurement
+ */
+
+#include "../serial-interface.h"
+#include "../switch-sim.h"
+#include "../chording.h"
+
+// Keys in the order given ("2,0+1" -> 2, 0, 1); returns count, 0 on error
+static uint8_t parseOrderedKeys(const char* args, uint8_t* keys, const char** rest) {
+  uint8_t count = 0;
+  *rest = args;
+  while (*args >= '0' && *args <= '9') {
+    int keyNum = 0;
+    while (*args >= '0' && *args <= '9') {
+      keyNum = keyNum * 10 + (*args - '0');
+      args++;
+    }
+    if (keyNum >= NUM_SWITCHES || count >= NUM_SWITCHES) return 0;
+    keys[count++] = keyNum;
+    if (*args == ',' || *args == '+') args++;
+  }
+  *rest = args;
+  return count;
+}
+
+static void simUsage() {
+  Serial.println(F("Usage:"));
+  Serial.println(F("  SIM ADD <us> <keys|NONE>       - Add step: switch state at offset"));
+  Serial.println(F("  SIM ROLL <keys> <gap> [hold]   - Add roll: press/release in order"));
+  Serial.println(F("  SIM RUN [count]                - Replay timeline count times"));
+  Serial.println(F("  SIM STOP                       - Abort a run"));
+  Serial.println(F("  SIM LIST                       - Show timeline"));
+  Serial.println(F("  SIM REPORT                     - Show last run latencies"));
+  Serial.println(F("  SIM CLEAR                      - Remove all steps"));
+  Serial.println(F("\nExample:"));
+  Serial.println(F("  SIM ROLL 0,1 5000 30000        - 0 then 1 5ms apart, held 30ms"));
+}
+
+void cmdSim(const char* args) {
+  while (isspace(*args)) args++;
+
+  if (strncasecmp(args, "ADD", 3) == 0) {
+    args += 3;
+    char* end;
+    uint32_t offsetUs = strtoul(args, &end, 10);
+    if (end == args) {
+      Serial.println(F("Usage: SIM ADD <us> <keys|NONE>"));
+      return;
+    }
+    while (isspace(*end)) end++;
+
+    uint32_t mask = 0;
+    if (strncasecmp(end, "NONE", 4) != 0) {
+      mask = parseKeyList(end);
+      if (mask == 0) {
+        Serial.println(F("Invalid key list"));
+        return;
+      }
+    }
+    if (!simAddStep(offsetUs, mask)) {
+      Serial.println(F("Step rejected - timeline full, running, or out of order"));
+      return;
+    }
+    Serial.print(F("Step "));
+    Serial.print(simStepCount() - 1);
+    Serial.println(F(" added"));
+  }
+  else if (strncasecmp(args, "ROLL", 4) == 0) {
+    args += 4;
+    while (isspace(*args)) args++;
+
+    uint8_t keys[NUM_SWITCHES];
+    const char* rest;
+    uint8_t count = parseOrderedKeys(args, keys, &rest);
+    char* end;
+    uint32_t gapUs = strtoul(rest, &end, 10);
+    if (count == 0 || end == rest) {
+      Serial.println(F("Usage: SIM ROLL <keys> <gap> [hold]"));
+      return;
+    }
+    const char* holdArg = end;
+    uint32_t holdUs = strtoul(holdArg, &end, 10);
+    if (end == holdArg || holdUs < gapUs) holdUs = gapUs;
+
+    if (!simAddRoll(keys, count, gapUs, holdUs)) {
+      Serial.println(F("Roll rejected - timeline full or running"));
+      return;
+    }
+    Serial.print(F("Roll added, "));
+    Serial.print(simStepCount());
+    Serial.println(F(" steps"));
+  }
+  else if (strncasecmp(args, "RUN", 3) == 0) {
+    long requested = atol(args + 3);
+    uint16_t count = requested <= 0 ? 1 : (requested > 65535 ? 65535 : requested);
+    if (!simStart(count)) {
+      Serial.println(F("No SIM steps"));
+      return;
+    }
+    Serial.print(F("SIM running "));
+    Serial.print(count);
+    Serial.println(F(" runs - report follows"));
+  }
+  else if (strncasecmp(args, "STOP", 4) == 0) {
+    simStop();
+    Serial.println(F("SIM stopped"));
+  }
+  else if (strncasecmp(args, "LIST", 4) == 0) {
+    simPrintSteps();
+  }
+  else if (strncasecmp(args, "REPORT", 6) == 0) {
+    simPrintReport();
+  }
+  else if (strncasecmp(args, "CLEAR", 5) == 0) {
+    simClear();
+    Serial.println(F("SIM steps cleared"));
+  }
+  else {
+    simUsage();
+  }
+}
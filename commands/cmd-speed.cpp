@@ -0,0 +1,50 @@
+/*
+ * SPEED Command Implementation
+ *
+ * Shows typing throughput over the last 10 seconds and the last minute
+ */
+
+#include "../serial-interface.h"
+#include "../speed-stats.h"
+
+static void printSpeedWindow(uint32_t windowMs) {
+  SpeedWindow window = speedWindow(windowMs);
+  uint32_t spanMs = window.spanMs ? window.spanMs : 1;
+
+  Serial.print(F("Last "));
+  Serial.print((unsigned long)((window.spanMs + 500) / 1000));
+  Serial.print(F("s: "));
+  Serial.print((unsigned long)window.chars);
+  Serial.print(F(" chars, "));
+  Serial.print((unsigned long)((uint64_t)window.chars * 60000 / SPEED_WORD_CHARS / spanMs));
+  Serial.print(F(" WPM, "));
+  Serial.print((unsigned long)((uint64_t)window.chords * 60000 / spanMs));
+  Serial.print(F(" chords/min, "));
+  Serial.print(window.cancelled);
+  Serial.print(F("/"));
+  Serial.print(window.gestures);
+  Serial.print(F(" gestures cancelled"));
+  if (window.gestures > 0) {
+    Serial.print(F(", avg gesture "));
+    Serial.print((unsigned long)(window.gestureMs / window.gestures));
+    Serial.print(F("ms"));
+  }
+  Serial.println();
+}
+
+void cmdSpeed(const char* args) {
+  while (isspace(*args)) args++;
+
+  if (strncasecmp(args, "RESET", 5) == 0) {
+    resetSpeedStats();
+    Serial.println(F("Speed statistics reset"));
+    return;
+  }
+  if (*args) {
+    Serial.println(F("Usage: SPEED [RESET]"));
+    return;
+  }
+
+  printSpeedWindow(10000);
+  printSpeedWindow(SPEED_WINDOW_MS);
+}
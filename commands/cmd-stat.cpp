@@ -6,6 +6,7 @@
 
 #include <Arduino.h>
 #include "../serial-interface.h"
+#include "../stack-monitor.h"
 
 int getFreeMemory() {
 #ifdef ESP32
@@ -29,4 +30,20 @@ void cmdStat() {
   
   Serial.print(F("Free RAM: ~"));
   Serial.println(getFreeMemory());
+
+  // Measured, unlike the estimate above: deepest use since boot
+  Serial.print(F("Stack: peak "));
+  Serial.print((unsigned int)stackPeak());
+  Serial.print(F(" bytes, min free "));
+  Serial.println((unsigned int)stackMinFree());
+
+  if (stackCommandCount() == 0) return;
+  Serial.print(F("Command stack:"));
+  for (uint8_t i = 0; i < stackCommandCount(); i++) {
+    Serial.print(i == 0 ? F(" ") : F(", "));
+    Serial.print(stackCommandName(i));
+    Serial.print(' ');
+    Serial.print((unsigned int)stackCommandPeak(i));
+  }
+  Serial.println();
 }
@@ -0,0 +1,69 @@
+/*
+ * TASKS Command Implementation
+ *
+ * Shows main loop task periods, run times and overruns
+ */
+
+#include "../serial-interface.h"
+#include "../config.h"
+#include "../scheduler.h"
+#include "../usb-frame.h"
+
+// Right-aligned in width columns
+static void printField(uint32_t value, uint8_t width) {
+  uint8_t digits = 1;
+  for (uint32_t v = value; v >= 10; v /= 10) digits++;
+  for (uint8_t i = digits; i < width; i++) Serial.print(' ');
+  Serial.print((unsigned long)value);
+}
+
+void cmdTasks(const char* args) {
+  while (isspace(*args)) args++;
+
+  if (strncasecmp(args, "RESET", 5) == 0) {
+    resetSchedulerStats();
+    resetUsbFrameStats();
+    Serial.println(F("Task statistics reset"));
+    return;
+  }
+  if (*args) {
+    Serial.println(F("Usage: TASKS [RESET]"));
+    return;
+  }
+
+  Serial.println(F("Task      Period  Budget    Runs  Max us Late us Overrun  Missed"));
+  for (uint8_t i = 0; i < schedulerTaskCount(); i++) {
+    const SchedulerTask& task = schedulerTask(i);
+    Serial.print(task.name);
+    for (uint8_t j = strlen(task.name); j < 8; j++) Serial.print(' ');
+    printField(task.periodUs, 8);
+    printField(task.budgetUs, 8);
+    printField(task.runs, 8);
+    printField(task.maxRunUs, 8);
+    printField(task.maxLateUs, 8);
+    printField(task.overruns, 8);
+    printField(task.missed, 8);
+    Serial.println();
+  }
+
+  const UsbFrameStats& usb = usbFrameStats();
+  Serial.print(F("USB frames: "));
+  Serial.print((unsigned long)usb.frames);
+#if USB_SOF_SYNC
+  Serial.print(F(", input runs "));
+  Serial.print(USB_SOF_LEAD_US);
+  Serial.print(F("us before each"));
+#endif
+  Serial.println();
+
+  if (usb.reports == 0) return;
+  Serial.print(F("Queue to poll: "));
+  Serial.print((unsigned long)usb.reports);
+  Serial.print(F(" reports, min "));
+  Serial.print((unsigned long)usb.minWaitUs);
+  Serial.print(F(" avg "));
+  Serial.print((unsigned long)(usb.totalWaitUs / usb.reports));
+  Serial.print(F(" max "));
+  Serial.print((unsigned long)usb.maxWaitUs);
+  Serial.println(F("us"));
+}
@@ -0,0 +1,74 @@
+/*
+ * Configuration Hash Implementation
+ *
+ * Entry hashes are summed modulo 2^64 - adding a binding adds its entry
+ * hash, removing it subtracts it. Host tools compute the same value by
+ * calling configHashEntry() on the bindings of a config file.
+ */
+
+#include "config-hash.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+static const uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+static const uint64_t FNV_PRIME = 0x00000100000001B3ULL;
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static uint64_t fnvByte(uint64_t hash, uint8_t b) {
+  hash ^= b;
+  return hash * FNV_PRIME;
+}
+
+// SplitMix64 finalizer - spreads FNV output so sums of entries don't cancel
+static uint64_t finalizeHash(uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 27;
+  h *= 0x94D049BB133111EBULL;
+  h ^= h >> 31;
+  return h;
+}
+
+//==============================================================================
+// HASH INTERFACE
+//==============================================================================
+
+uint64_t configHashEntry(uint8_t kind, uint32_t key, const char* macro) {
+  if (kind == CONFIG_HASH_MODIFIERS) {
+    if (key == 0) return 0;
+  } else if (!macro || *macro == '\0') {
+    return 0;
+  }
+
+  uint64_t hash = FNV_OFFSET_BASIS;
+  hash = fnvByte(hash, kind);
+  for (int i = 0; i < 4; i++) {
+    hash = fnvByte(hash, (uint8_t)(key >> (8 * i)));
+  }
+
+  if (macro) {
+    for (const uint8_t* p = (const uint8_t*)macro; *p; p++) {
+      hash = fnvByte(hash, *p);
+    }
+  }
+
+  return finalizeHash(hash);
+}
+
+uint64_t configHashCombine(uint64_t keyMacroHash, uint64_t chordHash, uint32_t modifierMask) {
+  return keyMacroHash + chordHash + configHashEntry(CONFIG_HASH_MODIFIERS, modifierMask, nullptr);
+}
+
+void formatConfigHash(uint64_t hash, char* buffer) {
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+  for (int i = 15; i >= 0; i--) {
+    buffer[i] = HEX_DIGITS[hash & 0x0F];
+    hash >>= 4;
+  }
+  buffer[16] = '\0';
+}
@@ -0,0 +1,41 @@
+/*
+ * Configuration Hash Interface
+ *
+ * Stable 64-bit hash of the canonical binary configuration:
+ * key macros, chord patterns and the chord modifier mask
+ *
+ * Each binding contributes an independent entry hash and the entries are
+ * summed, so the total does not depend on storage or insertion order and
+ * can be maintained incrementally as bindings change.
+ */
+
+#ifndef CONFIG_HASH_H
+#define CONFIG_HASH_H
+
+#include <Arduino.h>
+
+//==============================================================================
+// ENTRY KINDS
+//==============================================================================
+
+#define CONFIG_HASH_KEY_DOWN   'D'   // Key index + down macro bytes
+#define CONFIG_HASH_KEY_UP     'U'   // Key index + up macro bytes
+#define CONFIG_HASH_CHORD      'C'   // Chord key mask + macro bytes
+#define CONFIG_HASH_MODIFIERS  'M'   // Modifier key mask, no macro
+
+//==============================================================================
+// HASH INTERFACE
+//==============================================================================
+
+// Hash of a single binding: FNV-1a 64 over [kind][key, 4 bytes LE][macro bytes]
+// followed by a 64-bit finalizer. Empty or null macros contribute 0, as does
+// an empty modifier mask, so "unset" and "cleared" hash identically.
+uint64_t configHashEntry(uint8_t kind, uint32_t key, const char* macro);
+
+// Combine the maintained partial sums into the configuration hash
+uint64_t configHashCombine(uint64_t keyMacroHash, uint64_t chordHash, uint32_t modifierMask);
+
+// Format a hash as 16 upper-case hex digits (buffer must hold 17 bytes)
+void formatConfigHash(uint64_t hash, char* buffer);
+
+#endif // CONFIG_HASH_H
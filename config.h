@@ -4,4 +4,79 @@
 
 #define NUM_SWITCHES 9
 
+// Factory bindings in flash (builtin-profile.cpp) beneath MAP / CHORD ADD.
+// Off by default: with it on, CLEAR reverts a key to its built-in binding,
+// so keys the profile binds can no longer be left unbound (or raise EVENTS)
+#ifndef BUILTIN_PROFILE
+#define BUILTIN_PROFILE 0
+#endif
+
+// Boot default for chord correction (CHORD CORRECT): an undefined chord
+// fires the only defined chord one key away. Costs 2^NUM_SWITCHES / 2
+// bytes of RAM for the neighbour index while on
+#ifndef CHORD_CORRECTION
+#define CHORD_CORRECTION 0
+#endif
+
+// Macro preemption (PREEMPT): holding every key in MACRO_ABORT_KEYS stops a
+// running macro; keys in MACRO_PRIORITY_KEYS run their press macro inside a
+// running one. Key masks, 0 = off
+#ifndef MACRO_ABORT_KEYS
+#define MACRO_ABORT_KEYS    0
+#endif
+#ifndef MACRO_PRIORITY_KEYS
+#define MACRO_PRIORITY_KEYS 0
+#endif
+
+// Boot default for the binary host event channel (EVENTS, host-events.h)
+#ifndef HOST_EVENTS
+#define HOST_EVENTS 0
+#endif
+
+// On-device macro decoder for SHOW, CHORD LIST and BENCH. Set to 0 to save
+// its flash and String RAM: those print "<n bytes>" instead, and DUMP plus
+// kpconfig show render bindings on the host
+#ifndef MACRO_DECODER
+#define MACRO_DECODER 1
+#endif
+
+// Main loop task periods and run-time budgets (scheduler.h), microseconds;
+// the input task scans switches, runs the chord engine and key macros
+#ifndef INPUT_PERIOD_US
+#define INPUT_PERIOD_US   1000
+#endif
+#define INPUT_BUDGET_US   500
+#define SERIAL_PERIOD_US  2000
+#define SERIAL_BUDGET_US  1000
+
+// Phase-lock the input task to USB frames (usb-frame.h): it runs
+// USB_SOF_LEAD_US before each start of frame, leaving that long for the
+// scan, chord engine and first report before the host polls
+#ifndef USB_SOF_SYNC
+#define USB_SOF_SYNC      1
+#endif
+#define USB_FRAME_US      1000
+#define USB_SOF_LEAD_US   250
+
+// Mouse keys (mouse-keys.h): motion is sent at most once per
+// MOUSE_PERIOD_US, the mouse endpoint's poll interval (Teensy 2.0 polls
+// its mouse endpoint every 2 ms: MOUSE_INTERVAL in usb_private.h). A key
+// whose press macro moves or scrolls repeats the step while held, after
+// MOUSE_DELAY_MS at MOUSE_MIN_RATE steps per second, rising to
+// MOUSE_MAX_RATE over MOUSE_ACCEL_MS. Scrolling runs MOUSE_WHEEL_DIVISOR
+// times slower than pointer motion
+#ifndef MOUSE_PERIOD_US
+#if defined(CORE_TEENSY)
+#define MOUSE_PERIOD_US     2000
+#else
+#define MOUSE_PERIOD_US     USB_FRAME_US
+#endif
+#endif
+#define MOUSE_BUDGET_US     200
+#define MOUSE_DELAY_MS      150
+#define MOUSE_MIN_RATE      20
+#define MOUSE_MAX_RATE      250
+#define MOUSE_ACCEL_MS      1000
+#define MOUSE_WHEEL_DIVISOR 8
+
 #endif  // CONFIG_N
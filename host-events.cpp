@@ -0,0 +1,85 @@
+/*
+ * Host Event Channel Implementation
+ *
+ * A frame is written in one call so it leaves in a single USB packet
+ * rather than trickling out between console prints.
+ */
+
+#include "host-events.h"
+
+//==============================================================================
+// STATE
+//==============================================================================
+
+static bool enabled = HOST_EVENTS;
+static uint32_t sentCount = 0;
+
+//==============================================================================
+// FRAME FORMAT
+//==============================================================================
+
+static uint8_t* putBits(uint8_t* out, uint32_t value, uint8_t bytes) {
+  for (uint8_t i = 0; i < bytes; i++) {
+    *out++ = 0x80 | (value & 0x7F);
+    value >>= 7;
+  }
+  return out;
+}
+
+static uint8_t frameCheck(const uint8_t* frame) {
+  uint8_t sum = 0;
+  for (uint8_t i = 1; i < HOST_EVENT_FRAME_SIZE - 1; i++) sum += frame[i] & 0x7F;
+  return 0x80 | (sum & 0x7F);
+}
+
+void encodeHostEvent(const HostEvent& event, uint8_t* frame) {
+  uint8_t* out = frame;
+  *out++ = HOST_EVENT_SYNC;
+  out = putBits(out, event.type, 1);
+  out = putBits(out, event.data, 5);
+  out = putBits(out, event.timeUs, 5);
+  *out = frameCheck(frame);
+}
+
+bool decodeHostEvent(const uint8_t* frame, HostEvent& event) {
+  if (frame[0] != HOST_EVENT_SYNC) return false;
+  for (uint8_t i = 1; i < HOST_EVENT_FRAME_SIZE; i++) {
+    if (!(frame[i] & 0x80)) return false;
+  }
+  if (frame[HOST_EVENT_FRAME_SIZE - 1] != frameCheck(frame)) return false;
+
+  event.type = frame[1] & 0x7F;
+  event.data = 0;
+  event.timeUs = 0;
+  for (int8_t i = 4; i >= 0; i--) {
+    event.data = (event.data << 7) | (frame[2 + i] & 0x7F);
+    event.timeUs = (event.timeUs << 7) | (frame[7 + i] & 0x7F);
+  }
+  return true;
+}
+
+//==============================================================================
+// CHANNEL
+//==============================================================================
+
+void setHostEvents(bool on) {
+  enabled = on;
+}
+
+bool hostEventsEnabled() {
+  return enabled;
+}
+
+uint32_t hostEventCount() {
+  return sentCount;
+}
+
+void sendHostEvent(uint8_t type, uint32_t data) {
+  if (!enabled) return;
+
+  HostEvent event = { type, data, micros() };
+  uint8_t frame[HOST_EVENT_FRAME_SIZE];
+  encodeHostEvent(event, frame);
+  Serial.write(frame, HOST_EVENT_FRAME_SIZE);
+  sentCount++;
+}
@@ -0,0 +1,63 @@
+/*
+ * Host Event Channel Interface
+ *
+ * Binary frames on the serial console for switch activity the keypad does
+ * not act on itself: presses and releases of keys with no binding at all,
+ * and chords released with no macro. Host automation reads these instead
+ * of parsing the console text around them. The typing speed counters
+ * (speed-stats.h) trace each macro's characters and each chord gesture
+ * here too.
+ *
+ * Frame (HOST_EVENT_FRAME_SIZE bytes):
+ *   HOST_EVENT_SYNC, then 12 bytes each carrying 7 bits with the top bit
+ *   set: type, data (5 bytes, 7 bits each, low first), device time in
+ *   micros() (5 bytes), check (sum of the 11 values before it, 7 bits).
+ *   The sync byte never occurs in UTF-8 and no frame byte is below 0x80,
+ *   so frames cannot be confused with console text, and a line ending
+ *   translation on the way cannot corrupt them.
+ */
+
+#ifndef HOST_EVENTS_H
+#define HOST_EVENTS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//==============================================================================
+// FRAME FORMAT
+//==============================================================================
+
+#define HOST_EVENT_SYNC       0xFE
+#define HOST_EVENT_FRAME_SIZE 13
+
+#define HOST_EVENT_PRESS      1     // data: key index
+#define HOST_EVENT_RELEASE    2     // data: key index
+#define HOST_EVENT_CHORD      3     // data: chord keys, released with no macro
+#define HOST_EVENT_TYPED      4     // data: characters one macro typed
+#define HOST_EVENT_GESTURE    5     // data: JOURNAL_CHORD_* outcome << 24 | duration ms
+
+struct HostEvent {
+  uint8_t type;
+  uint32_t data;
+  uint32_t timeUs;
+};
+
+void encodeHostEvent(const HostEvent& event, uint8_t* frame);
+
+// false if the frame is malformed or fails its check
+bool decodeHostEvent(const uint8_t* frame, HostEvent& event);
+
+//==============================================================================
+// CHANNEL
+//==============================================================================
+
+void setHostEvents(bool enabled);
+bool hostEventsEnabled();
+
+// Frames sent since boot
+uint32_t hostEventCount();
+
+// Stamp with micros() and send, if the channel is on
+void sendHostEvent(uint8_t type, uint32_t data);
+
+#endif // HOST_EVENTS_H
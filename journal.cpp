@@ -0,0 +1,256 @@
+/*
+ * Event Journal Implementation
+ *
+ * The ring lives in uninitialized RAM so a watchdog reset leaves it
+ * intact; setupJournal() checks its header before trusting it. Images are
+ * produced byte by byte, oldest entry first, so neither JOURNAL DUMP nor
+ * saveJournal() needs a second buffer.
+ */
+
+#include "journal.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <hardware/watchdog.h>
+#endif
+
+//==============================================================================
+// RING STATE
+//==============================================================================
+
+#define JOURNAL_RING_MAGIC 0x4A4B
+
+struct JournalRing {
+  uint16_t magic;
+  uint8_t head;                  // Next slot written
+  uint8_t count;
+  uint8_t check;                 // ~(head ^ count), catches garbage headers
+  JournalEntry entries[JOURNAL_ENTRIES];
+};
+
+#if defined(__AVR__)
+static JournalRing ring __attribute__((section(".noinit")));
+#elif defined(ARDUINO_ARCH_RP2040)
+static JournalRing ring __attribute__((section(".uninitialized_data")));
+#else
+static JournalRing ring;
+#endif
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static bool ringValid() {
+  return ring.magic == JOURNAL_RING_MAGIC && ring.head < JOURNAL_ENTRIES &&
+         ring.count <= JOURNAL_ENTRIES && ring.check == (uint8_t)~(ring.head ^ ring.count);
+}
+
+static void resetRing() {
+  ring.magic = JOURNAL_RING_MAGIC;
+  ring.head = 0;
+  ring.count = 0;
+  ring.check = 0xFF;
+}
+
+static uint8_t readResetCause() {
+#if defined(__AVR__)
+  uint8_t cause = MCUSR & 0x0F;
+  MCUSR = 0;
+  return cause;
+#elif defined(ARDUINO_ARCH_RP2040)
+  return watchdog_caused_reboot() ? JOURNAL_RESET_WATCHDOG : JOURNAL_RESET_POWER;
+#else
+  return 0;
+#endif
+}
+
+static uint8_t entryByte(const JournalEntry& entry, uint8_t offset) {
+  switch (offset) {
+    case 0: return entry.timeMs & 0xFF;
+    case 1: return entry.timeMs >> 8;
+    case 2: return entry.type;
+    case 3: return entry.arg;
+    default: return entry.data >> (8 * (offset - 4));
+  }
+}
+
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+// Same text as formatKeyMask(), without linking the chord engine
+static void appendKeys(String& text, uint32_t keyMask) {
+  if (keyMask == 0) {
+    text += "none";
+    return;
+  }
+  bool first = true;
+  for (uint8_t i = 0; i < 32; i++) {
+    if (!(keyMask & (1UL << i))) continue;
+    if (!first) text += '+';
+    text += String((int)i);
+    first = false;
+  }
+}
+
+//==============================================================================
+// RECORDING
+//==============================================================================
+
+void setupJournal() {
+  uint8_t cause = readResetCause();
+  if ((cause & JOURNAL_RESET_WATCHDOG) && ringValid() && ring.count > 0 && saveJournal()) {
+    cause |= JOURNAL_RESET_SALVAGED;
+  }
+  resetRing();
+  journalRecord(JOURNAL_BOOT, cause, 0);
+}
+
+void journalRecord(uint8_t type, uint8_t arg, uint32_t data) {
+  if (!ringValid()) resetRing();
+
+  JournalEntry& entry = ring.entries[ring.head];
+  entry.timeMs = millis();
+  entry.type = type;
+  entry.arg = arg;
+  entry.data = data;
+
+  ring.head = (ring.head + 1) % JOURNAL_ENTRIES;
+  if (ring.count < JOURNAL_ENTRIES) ring.count++;
+  ring.check = ~(ring.head ^ ring.count);
+}
+
+void journalRecordMacro(const uint8_t* bytes, uint16_t length, bool flash) {
+  uint32_t data = 0;
+  for (uint8_t i = 0; i < 4 && i < length; i++) {
+    uint8_t b = flash ? pgm_read_byte(bytes + i) : bytes[i];
+    data |= (uint32_t)b << (8 * i);
+  }
+  journalRecord(JOURNAL_MACRO, length > 255 ? 255 : length, data);
+}
+
+bool saveJournal() {
+  if (!journalRegionFree()) return false;
+  uint16_t start = JOURNAL_EEPROM_START;
+  for (uint16_t i = 0; i < JOURNAL_IMAGE_SIZE; i++) {
+    EEPROM.update(start + i, journalImageByte(false, i));
+  }
+  return true;
+}
+
+bool clearJournal() {
+  resetRing();
+  if (!journalRegionFree()) return false;
+  uint16_t start = JOURNAL_EEPROM_START;
+  for (uint16_t i = 0; i < JOURNAL_IMAGE_SIZE; i++) {
+    EEPROM.update(start + i, 0xFF);
+  }
+  return true;
+}
+
+//==============================================================================
+// READING
+//==============================================================================
+
+uint8_t journalImageByte(bool saved, uint16_t offset) {
+  if (offset >= JOURNAL_IMAGE_SIZE) return 0xFF;
+  if (saved) return EEPROM.read(JOURNAL_EEPROM_START + offset);
+
+  uint8_t count = ringValid() ? ring.count : 0;
+  switch (offset) {
+    case 0: return 'K';
+    case 1: return 'J';
+    case 2: return JOURNAL_VERSION;
+    case 3: return count;
+  }
+
+  uint8_t index = (offset - JOURNAL_HEADER_SIZE) / JOURNAL_ENTRY_SIZE;
+  if (index >= count) return 0xFF;
+  uint8_t slot = (ring.head + JOURNAL_ENTRIES - count + index) % JOURNAL_ENTRIES;
+  return entryByte(ring.entries[slot], (offset - JOURNAL_HEADER_SIZE) % JOURNAL_ENTRY_SIZE);
+}
+
+uint8_t journalImageCount(bool saved) {
+  if (journalImageByte(saved, 0) != 'K' || journalImageByte(saved, 1) != 'J' ||
+      journalImageByte(saved, 2) != JOURNAL_VERSION) {
+    return 0;
+  }
+  uint8_t count = journalImageByte(saved, 3);
+  return count > JOURNAL_ENTRIES ? 0 : count;
+}
+
+JournalEntry journalImageEntry(bool saved, uint8_t index) {
+  uint8_t bytes[JOURNAL_ENTRY_SIZE];
+  uint16_t offset = JOURNAL_HEADER_SIZE + index * JOURNAL_ENTRY_SIZE;
+  for (uint8_t i = 0; i < JOURNAL_ENTRY_SIZE; i++) {
+    bytes[i] = journalImageByte(saved, offset + i);
+  }
+  return decodeJournalEntry(bytes);
+}
+
+JournalEntry decodeJournalEntry(const uint8_t* bytes) {
+  JournalEntry entry;
+  entry.timeMs = bytes[0] | (bytes[1] << 8);
+  entry.type = bytes[2];
+  entry.arg = bytes[3];
+  entry.data = (uint32_t)bytes[4] | ((uint32_t)bytes[5] << 8) |
+               ((uint32_t)bytes[6] << 16) | ((uint32_t)bytes[7] << 24);
+  return entry;
+}
+
+String formatJournalEntry(const JournalEntry& entry) {
+  String text;
+  switch (entry.type) {
+    case JOURNAL_BOOT:
+      text = "boot";
+      if (entry.arg & JOURNAL_RESET_POWER) text += " power-on";
+      if (entry.arg & JOURNAL_RESET_EXTERNAL) text += " reset-pin";
+      if (entry.arg & JOURNAL_RESET_BROWNOUT) text += " brown-out";
+      if (entry.arg & JOURNAL_RESET_WATCHDOG) text += " watchdog";
+      if (entry.arg & JOURNAL_RESET_SALVAGED) text += " (journal saved)";
+      break;
+
+    case JOURNAL_SWITCHES:
+      text = "switches ";
+      appendKeys(text, entry.data);
+      break;
+
+    case JOURNAL_CHORD_START:
+      text = entry.arg ? "chord recapture " : "chord start ";
+      appendKeys(text, entry.data);
+      break;
+
+    case JOURNAL_CHORD_CANCEL:
+      text = "chord cancel by ";
+      appendKeys(text, entry.data);
+      break;
+
+    case JOURNAL_CHORD_END:
+      text = "chord ";
+      appendKeys(text, entry.data);
+      switch (entry.arg) {
+        case JOURNAL_CHORD_FIRED:     text += " fired"; break;
+        case JOURNAL_CHORD_UNDEFINED: text += " undefined"; break;
+        case JOURNAL_CHORD_CANCELLED: text += " cancelled"; break;
+        case JOURNAL_CHORD_EXPIRED:   text += " expired"; break;
+        case JOURNAL_CHORD_CORRECTED: text += " corrected"; break;
+        default:                      text += " ?"; break;
+      }
+      break;
+
+    case JOURNAL_MACRO:
+      text = "macro ";
+      text += String((int)entry.arg);
+      text += entry.arg == 255 ? "+ bytes" : " bytes";
+      for (uint8_t i = 0; i < 4 && i < entry.arg; i++) {
+        uint8_t b = entry.data >> (8 * i);
+        text += ' ';
+        text += HEX_DIGITS[b >> 4];
+        text += HEX_DIGITS[b & 0x0F];
+      }
+      break;
+
+    default:
+      text = "? type ";
+      text += String((int)entry.type);
+      break;
+  }
+  return text;
+}
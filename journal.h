@@ -0,0 +1,123 @@
+/*
+ * Event Journal Interface
+ *
+ * Black-box record of recent switch edges, chord decisions and macro
+ * executions. Entries go into a RAM ring that survives a watchdog reset
+ * (.noinit); the ring is copied to a reserved region at the end of EEPROM
+ * by JOURNAL SAVE, or at boot when the previous run ended in a watchdog
+ * reset. Recording is a few byte stores, cheap enough for every event.
+ *
+ * Image format (JOURNAL DUMP, the EEPROM copy and tools/kpjournal):
+ *   'K' 'J' <version> <count>, then count 8-byte entries oldest first:
+ *   time ms (uint16 LE, low bits of millis()), type, arg, data (uint32 LE)
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "config.h"
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+
+#ifndef JOURNAL_ENTRIES
+#define JOURNAL_ENTRIES 16
+#endif
+
+#define JOURNAL_VERSION      1
+#define JOURNAL_HEADER_SIZE  4
+#define JOURNAL_ENTRY_SIZE   8
+#define JOURNAL_IMAGE_SIZE   (JOURNAL_HEADER_SIZE + JOURNAL_ENTRIES * JOURNAL_ENTRY_SIZE)
+
+// Reserved at the end of EEPROM, below which the configuration is stored
+#define JOURNAL_EEPROM_START (EEPROM.length() - JOURNAL_IMAGE_SIZE)
+
+// The region holds a journal image or is erased. A configuration saved by
+// firmware without the journal can run into it; until SAVE rewrites that
+// configuration below the region, LOAD reads it to the end of EEPROM and
+// the journal does not write there
+inline bool journalRegionFree() {
+  uint8_t first = EEPROM.read(JOURNAL_EEPROM_START);
+  return first == 0xFF || (first == 'K' && EEPROM.read(JOURNAL_EEPROM_START + 1) == 'J');
+}
+
+// SAVE / image install: the configuration now ends below the region
+inline void claimJournalRegion() {
+  if (!journalRegionFree()) EEPROM.update(JOURNAL_EEPROM_START, 0xFF);
+}
+
+//==============================================================================
+// EVENTS
+//==============================================================================
+
+#define JOURNAL_BOOT          1   // arg: reset cause flags
+#define JOURNAL_SWITCHES      2   // data: switch state
+#define JOURNAL_CHORD_START   3   // data: chord keys; arg 1 = recaptured while held
+#define JOURNAL_CHORD_CANCEL  4   // data: non-chord keys that cancelled it
+#define JOURNAL_CHORD_END     5   // arg: outcome; data: captured chord
+#define JOURNAL_MACRO         6   // arg: length (255 = longer); data: first 4 bytes
+
+// JOURNAL_BOOT reset causes (AVR MCUSR layout)
+#define JOURNAL_RESET_POWER    0x01
+#define JOURNAL_RESET_EXTERNAL 0x02
+#define JOURNAL_RESET_BROWNOUT 0x04
+#define JOURNAL_RESET_WATCHDOG 0x08
+#define JOURNAL_RESET_SALVAGED 0x80   // Previous run's ring was saved to EEPROM
+
+// JOURNAL_CHORD_END outcomes
+#define JOURNAL_CHORD_FIRED     0
+#define JOURNAL_CHORD_UNDEFINED 1     // Released in time, no macro for the keys
+#define JOURNAL_CHORD_CANCELLED 2
+#define JOURNAL_CHORD_EXPIRED   3     // Released after the execution window
+#define JOURNAL_CHORD_CORRECTED 4     // Undefined, fired the only chord one key away
+
+struct JournalEntry {
+  uint16_t timeMs;
+  uint8_t type;
+  uint8_t arg;
+  uint32_t data;
+};
+
+//==============================================================================
+// RECORDING
+//==============================================================================
+
+// Call first in setup(): salvages the ring after a watchdog reset, then
+// starts a fresh one with a JOURNAL_BOOT entry
+void setupJournal();
+
+void journalRecord(uint8_t type, uint8_t arg, uint32_t data);
+
+// JOURNAL_MACRO entry for a RAM or PROGMEM (flash) macro
+void journalRecordMacro(const uint8_t* bytes, uint16_t length, bool flash);
+
+// Copy the ring into the reserved EEPROM region; false while an older
+// configuration occupies it (journalRegionFree)
+bool saveJournal();
+
+// Empty the ring and erase the EEPROM copy (left alone while occupied)
+bool clearJournal();
+
+//==============================================================================
+// READING
+//==============================================================================
+
+// Byte of the live ring's image (saved = false) or of the EEPROM copy
+uint8_t journalImageByte(bool saved, uint16_t offset);
+
+// Entries held by an image; 0 if the EEPROM copy is erased or invalid
+uint8_t journalImageCount(bool saved);
+
+// index 0 is the oldest entry
+JournalEntry journalImageEntry(bool saved, uint8_t index);
+
+// Decode one JOURNAL_ENTRY_SIZE entry from image bytes
+JournalEntry decodeJournalEntry(const uint8_t* bytes);
+
+// "switches 0+1", "chord 0+1 fired", "macro 3 bytes 61 62 63"
+String formatJournalEntry(const JournalEntry& entry);
+
+#endif // JOURNAL_H
@@ -5,6 +5,7 @@
 
 #include <Arduino.h>
 #include <Keyboard.h>
+#include <Mouse.h>
 
 #include "config.h"
 #include "switches.h"
@@ -14,8 +15,24 @@
 #include "storage.h"
 #include "chordStorage.h"      // Unified chord storage interface
 #include "chording.h"          // Chording engine
+#include "builtin-profile.h"   // Factory bindings in flash
+#include "switch-sim.h"        // SIM command input injection
+#include "journal.h"           // Black-box event journal
+#include "stack-monitor.h"     // Stack high-water mark for STAT
+#include "scheduler.h"         // Fixed-rate tasks run by loop()
+#include "usb-frame.h"         // USB frame phase and report timing
+#include "host-events.h"       // Binary events for unbound keys
+#include "speed-stats.h"       // Typing speed counters for SPEED
+#include "mouse-keys.h"        // Pointer motion from mouse operations
 #include "serial-interface.h"
 
+// Optional compile-time configuration image (tools/kpconfig --format header)
+#if defined(__has_include)
+#if __has_include("config-image.h")
+#include "config-image.h"
+#endif
+#endif
+
 //==============================================================================
 // SYSTEM STATE AND CONSTANTS
 //==============================================================================
@@ -24,6 +41,8 @@
 #define RELEASED 0
 
 uint32_t lastSwitchState = 0;
+uint32_t abortHeldKeys = 0;     // Abort gesture keys, ignored until released
+uint32_t preemptedKeys = 0;     // Priority presses handled inside a macro
 bool systemReady = false;
 
 //==============================================================================
@@ -31,6 +50,12 @@ bool systemReady = false;
 //==============================================================================
 
 void setup() {
+  // Before anything can overwrite the journal a watchdog reset left behind
+  setupJournal();
+
+  // Paint the free stack so STAT can report the real high-water mark
+  setupStackMonitor();
+
   // Initialize serial communication first
   Serial.begin(115200);
   while (!Serial && millis() < 3000) {
@@ -39,10 +64,15 @@ void setup() {
 
   // Initialize core systems
   Keyboard.begin();
+  setupMouseKeys();
   setupSwitches();
   setupStorage();
   setupChording();        // Initialize chording system
+  setupBuiltinProfile();  // Flash bindings beneath MAP / CHORD ADD
   setupSerialInterface();
+  macroPollHook = pollMacroInput;
+  undefinedChordHook = sendChordEvent;
+  speedTraceHook = sendSpeedEvent;
   
   Serial.println(F("✓ UTF-8+ Key Paddle v2.0"));
   Serial.println(F("✓ Hardware interface ready"));
@@ -51,6 +81,12 @@ void setup() {
   
   // Auto-load configuration from EEPROM
   uint16_t chordOffset = loadFromStorage();
+#ifdef CONFIG_IMAGE_SIZE
+  if (chordOffset == 0 && installConfigImage(CONFIG_IMAGE, CONFIG_IMAGE_SIZE) > 0) {
+    Serial.println(F("✓ Embedded configuration image installed"));
+    chordOffset = loadFromStorage();
+  }
+#endif
   if (chordOffset > 0) {
     Serial.println(F("✓ Switch macros loaded from EEPROM"));
     
@@ -86,6 +122,11 @@ void setup() {
     Serial.println(F("✓ No stored configuration found (using defaults)"));
   }
   
+  // Input first: it runs ahead of every other task and on their yields
+  addTask("input", loopInput, INPUT_PERIOD_US, INPUT_BUDGET_US);
+  addTask("serial", loopSerialInterface, SERIAL_PERIOD_US, SERIAL_BUDGET_US);
+  addTask("mouse", loopMouseKeys, MOUSE_PERIOD_US, MOUSE_BUDGET_US);
+
   // System ready
   systemReady = true;
   
@@ -110,13 +151,45 @@ void setup() {
 //==============================================================================
 
 void loop() {
-  uint32_t currentSwitchState = loopSwitches();
+#if USB_SOF_SYNC
+  // Scan just ahead of the next frame so reports make the host's next poll
+  if (loopUsbFrame()) {
+    alignTask(0, usbFrameStartUs() + USB_FRAME_US - USB_SOF_LEAD_US);
+  }
+#else
+  loopUsbFrame();
+#endif
+  runScheduler();
+}
+
+// Switch state as the chord engine and key macros see it. Only the input
+// task steps a SIM timeline, so every step reaches processChording()
+uint32_t readInputSwitches(bool stepSim) {
+  uint32_t hardware = loopSwitches();
+  uint32_t switches = stepSim ? simSwitches(hardware) : simPeek(hardware);
+  abortHeldKeys &= switches;
+  return switches & ~abortHeldKeys;
+}
+
+// Input task: switch scan, chording and key macros
+void loopInput() {
+  uint32_t currentSwitchState = readInputSwitches(true);
+
+  // Priority presses already ran inside a macro; only their release is new
+  lastSwitchState |= preemptedKeys;
+  preemptedKeys = 0;
   
   // Process switch state changes
   if (currentSwitchState != lastSwitchState) {
-    Serial.print("Switches 0x");
-    Serial.print(currentSwitchState, HEX);
-    Serial.println();
+    journalRecord(JOURNAL_SWITCHES, 0, currentSwitchState);
+    if (!hostEventsEnabled()) {
+      Serial.print("Switches 0x");
+      Serial.print(currentSwitchState, HEX);
+      Serial.println();
+    }
+
+    // Held mouse motion stops as its key comes up, chord or not
+    updateMouseKeys(currentSwitchState);
 
     if (systemReady) {
       // Process chording first - gets priority over individual keys
@@ -130,9 +203,27 @@ void loop() {
     
     lastSwitchState = currentSwitchState;
   }
-  
-  // Process serial commands
-  loopSerialInterface();
+}
+
+// Between the key actions of a running macro: the abort gesture stops it,
+// and a newly pressed priority key runs its press macro straight away.
+// Priority keys used in chords wait for the chord engine as usual.
+void pollMacroInput() {
+  uint32_t switches = readInputSwitches(false);
+
+  if (macroAbortKeys && (switches & macroAbortKeys) == macroAbortKeys) {
+    abortHeldKeys |= macroAbortKeys;
+    abortMacro();
+    return;
+  }
+
+  uint32_t pressed = switches & ~lastSwitchState & ~preemptedKeys & macroPriorityKeys;
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    if ((pressed & (1UL << i)) && !chording.isSwitchUsedInChords(i)) {
+      preemptedKeys |= (1UL << i);
+      handleKeyEvent(i, PRESSED);
+    }
+  }
 }
 
 //==============================================================================
@@ -176,10 +267,42 @@ void handleKeyEvent(uint8_t keyIndex, uint8_t event) {
     macroString = macros[keyIndex].upMacro;
   }
   
-  // Execute macro if one exists
+  // Execute macro if one exists, otherwise fall back to the built-in profile.
+  // Mouse motion in a press macro keeps going while the key is held
+  const char* builtin = findBuiltinKeyMacro(keyIndex, event == RELEASED);
+  uint8_t outerMouseKey = (event == PRESSED) ? beginMouseKeyMacro(keyIndex) : MOUSE_NO_KEY;
   if (macroString && strlen(macroString) > 0) {
     executeUTF8Macro((const uint8_t*)macroString, strlen(macroString));
+  } else if (builtin) {
+    executeUTF8MacroP(builtin);
+  } else if (isKeyUnbound(keyIndex)) {
+    sendHostEvent(event == PRESSED ? HOST_EVENT_PRESS : HOST_EVENT_RELEASE, keyIndex);
   }
+  if (event == PRESSED) endMouseKeyMacro(outerMouseKey);
+}
+
+// No macro or built-in binding in either direction: left to the host
+bool isKeyUnbound(uint8_t keyIndex) {
+  return !(macros[keyIndex].downMacro && macros[keyIndex].downMacro[0]) &&
+         !(macros[keyIndex].upMacro && macros[keyIndex].upMacro[0]) &&
+         !findBuiltinKeyMacro(keyIndex, false) && !findBuiltinKeyMacro(keyIndex, true);
+}
+
+// A lone tap is a key event, not a chord: send its press here, and
+// handleKeyEvent sends the matching release once the chord engine lets
+// the key go. A bound key's own binding answers for it.
+void sendChordEvent(uint32_t keyMask) {
+  if ((keyMask & (keyMask - 1)) == 0) {
+    uint8_t keyIndex = 0;
+    while (keyMask >>= 1) keyIndex++;
+    if (isKeyUnbound(keyIndex)) sendHostEvent(HOST_EVENT_PRESS, keyIndex);
+    return;
+  }
+  sendHostEvent(HOST_EVENT_CHORD, keyMask);
+}
+
+void sendSpeedEvent(bool gesture, uint32_t data) {
+  sendHostEvent(gesture ? HOST_EVENT_GESTURE : HOST_EVENT_TYPED, data);
 }
 
 //==============================================================================
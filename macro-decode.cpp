@@ -4,8 +4,11 @@
  * Converts UTF-8+ encoded macro sequences back to human-readable format
  */
 
+#include "config.h"
 #include "map-parser-tables.h"
 
+#if MACRO_DECODER
+
 // Helper function to get function key name from number
 const char* getFunctionKeyName(uint8_t keyNum) {
   switch (keyNum) {
@@ -47,6 +50,28 @@ bool shouldRemainAsKeyword(uint8_t utf8Code) {
   }
 }
 
+// Signed mouse offset operand back to its value
+static int mouseOffset(uint8_t operand) {
+  return (int)operand - UTF8_MOUSE_OFFSET;
+}
+
+// "CLICK:LEFT", "MOUSEDOWN:LEFT+RIGHT"
+static void appendMouseButton(String& result, uint8_t operand) {
+  if (!isMouseButtonOperand(operand)) {
+    result += "CLICK:?";
+    return;
+  }
+  switch (operand & MOUSE_ACTION_MASK) {
+    case MOUSE_ACTION_PRESS:   result += "MOUSEDOWN:"; break;
+    case MOUSE_ACTION_RELEASE: result += "MOUSEUP:"; break;
+    default:                   result += "CLICK:"; break;
+  }
+  bool first = true;
+  if (operand & MOUSE_BUTTON_LEFT)   { result += "LEFT"; first = false; }
+  if (operand & MOUSE_BUTTON_RIGHT)  { if (!first) result += "+"; result += "RIGHT"; first = false; }
+  if (operand & MOUSE_BUTTON_MIDDLE) { if (!first) result += "+"; result += "MIDDLE"; }
+}
+
 String macroDecode(const uint8_t* bytes, uint16_t length) {
   if (!bytes || length == 0) return F("\"\"");
   
@@ -120,6 +145,37 @@ String macroDecode(const uint8_t* bytes, uint16_t length) {
           i++;
         }
         continue;
+        
+      case UTF8_MOUSE_MOVE:
+        if (i + 2 < length) {
+          result += "MOVE:";
+          result += String(mouseOffset(bytes[i + 1]));
+          result += ",";
+          result += String(mouseOffset(bytes[i + 2]));
+          i += 3;
+        } else {
+          i++;
+        }
+        continue;
+        
+      case UTF8_MOUSE_SCROLL:
+        if (i + 1 < length) {
+          result += "SCROLL:";
+          result += String(mouseOffset(bytes[i + 1]));
+          i += 2;
+        } else {
+          i++;
+        }
+        continue;
+        
+      case UTF8_MOUSE_BUTTON:
+        if (i + 1 < length) {
+          appendMouseButton(result, bytes[i + 1]);
+          i += 2;
+        } else {
+          i++;
+        }
+        continue;
     }
     
     // Check if it's a navigation key that should remain as keyword
@@ -190,4 +246,16 @@ String macroDecode(const uint8_t* bytes, uint16_t length) {
   }
   
   return result;
-}
\ No newline at end of file
+}
+
+#else // !MACRO_DECODER
+
+// Decoder left out of the build: DUMP sends the raw bytes to the host
+String macroDecode(const uint8_t* bytes, uint16_t length) {
+  String result = F("<");
+  result += String(length);
+  result += F(" bytes>");
+  return result;
+}
+
+#endif // MACRO_DECODER
@@ -14,6 +14,7 @@
 //==============================================================================
 
 // Convert UTF-8+ encoded macro back to human-readable format
+// ("<n bytes>" in MACRO_DECODER 0 builds)
 String macroDecode(const uint8_t* bytes, uint16_t length);
 
 #endif // MACRO_DECOMPILER_H
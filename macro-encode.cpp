@@ -19,6 +19,7 @@ static const char ERR_UNKNOWN_TOKEN[] PROGMEM = "Unknown token";
 static const char ERR_MISSING_KEY[] PROGMEM = "No key follows modifier combination";
 static const char ERR_EMPTY_MODIFIER[] PROGMEM = "Empty modifier specification";
 static const char ERR_UNKNOWN_MODIFIER[] PROGMEM = "Unknown modifier name";
+static const char ERR_QUOTED_OPCODE[] PROGMEM = "Quoted text cannot hold a key code that takes operands";
 
 //==============================================================================
 // PARSER UTILITIES
@@ -88,7 +89,13 @@ static bool addModifierRelease(uint8_t* buffer, int* pos, uint8_t modifierMask)
   return true;
 }
 
-static bool processEscapeSequence(uint8_t* buffer, int* pos, const char** input) {
+// Codes the executor reads operand bytes after - only their tokens add those
+static bool takesOperands(uint8_t code) {
+  return code == UTF8_FUNCTION_KEY || code == UTF8_PRESS_MULTI || code == UTF8_RELEASE_MULTI ||
+         code == UTF8_MOUSE_MOVE || code == UTF8_MOUSE_BUTTON || code == UTF8_MOUSE_SCROLL;
+}
+
+static bool processEscapeSequence(uint8_t* buffer, int* pos, const char** input, const char** error) {
   (*input)++; // Skip backslash
   
   if (!**input) {
@@ -105,6 +112,26 @@ static bool processEscapeSequence(uint8_t* buffer, int* pos, const char** input)
     case 't':  return addByte(buffer, pos, '\t');
     case 'a':  return addByte(buffer, pos, '\a');
     case 'e':  return addByte(buffer, pos, 0x1B);  // Escape character
+    case 'b':  return addByte(buffer, pos, 0x08);  // Backspace character
+    case 'x': {
+      // Hex byte as emitted by the decoder - NUL would end the macro
+      int value = 0;
+      int digits = 0;
+      while (digits < 2 && isxdigit(**input)) {
+        char h = tolower(**input);
+        value = value * 16 + (isdigit(h) ? h - '0' : h - 'a' + 10);
+        (*input)++;
+        digits++;
+      }
+      if (digits > 0 && takesOperands(value)) {
+        *error = ERR_QUOTED_OPCODE;
+        return false;
+      }
+      if (digits > 0 && value != 0) return addByte(buffer, pos, value);
+      *input -= digits;
+      if (!addByte(buffer, pos, '\\')) return false;
+      return addByte(buffer, pos, 'x');
+    }
     case '"':  return addByte(buffer, pos, '"');
     case '\\': return addByte(buffer, pos, '\\');
     default:   
@@ -114,15 +141,19 @@ static bool processEscapeSequence(uint8_t* buffer, int* pos, const char** input)
   }
 }
 
-static bool parseQuotedString(uint8_t* buffer, int* pos, const char** input) {
+static bool parseQuotedString(uint8_t* buffer, int* pos, const char** input, const char** error) {
   (*input)++; // Skip opening quote
   
   while (**input && **input != '"') {
     if (**input == '\\') {
-      if (!processEscapeSequence(buffer, pos, input)) {
+      if (!processEscapeSequence(buffer, pos, input, error)) {
         return false;
       }
     } else {
+      if (takesOperands(**input)) {
+        *error = ERR_QUOTED_OPCODE;
+        return false;
+      }
       if (!addByte(buffer, pos, **input)) {
         return false;
       }
@@ -149,6 +180,74 @@ static bool parseToken(const char** input, char* token, int maxLen) {
   return len > 0;
 }
 
+// Signed mouse offset, -127..127, stored plus UTF8_MOUSE_OFFSET
+static bool parseMouseOffset(const char** text, uint8_t* operand) {
+  const char* p = *text;
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+') p++;
+  if (!isdigit(*p)) return false;
+  
+  int value = 0;
+  while (isdigit(*p)) {
+    value = value * 10 + (*p - '0');
+    if (value > 127) return false;
+    p++;
+  }
+  *operand = UTF8_MOUSE_OFFSET + (negative ? -value : value);
+  *text = p;
+  return true;
+}
+
+// "LEFT", "LEFT+RIGHT" -> button bits, 0 if any name is unknown
+static uint8_t parseMouseButtons(const char* text) {
+  uint8_t buttons = 0;
+  while (*text) {
+    const char* end = strchr(text, '+');
+    size_t len = end ? (size_t)(end - text) : strlen(text);
+    if (len == 4 && strncasecmp(text, "LEFT", 4) == 0) buttons |= MOUSE_BUTTON_LEFT;
+    else if (len == 5 && strncasecmp(text, "RIGHT", 5) == 0) buttons |= MOUSE_BUTTON_RIGHT;
+    else if (len == 6 && strncasecmp(text, "MIDDLE", 6) == 0) buttons |= MOUSE_BUTTON_MIDDLE;
+    else return 0;
+    if (!end) break;
+    if (!end[1]) return 0;
+    text = end + 1;
+  }
+  return buttons;
+}
+
+// MOVE:x,y  SCROLL:n  CLICK[:buttons]  MOUSEDOWN:buttons  MOUSEUP:buttons
+static bool addMouseToken(uint8_t* buffer, int* pos, const char* token) {
+  const char* colon = strchr(token, ':');
+  size_t nameLen = colon ? (size_t)(colon - token) : strlen(token);
+  const char* args = colon ? colon + 1 : "";
+  
+  if (nameLen == 4 && strncasecmp(token, "MOVE", 4) == 0) {
+    uint8_t dx, dy;
+    if (!parseMouseOffset(&args, &dx) || *args++ != ',' ||
+        !parseMouseOffset(&args, &dy) || *args) {
+      return false;
+    }
+    return addByte(buffer, pos, UTF8_MOUSE_MOVE) && addByte(buffer, pos, dx) &&
+           addByte(buffer, pos, dy);
+  }
+  if (nameLen == 6 && strncasecmp(token, "SCROLL", 6) == 0) {
+    uint8_t wheel;
+    if (!parseMouseOffset(&args, &wheel) || *args) return false;
+    return addByte(buffer, pos, UTF8_MOUSE_SCROLL) && addByte(buffer, pos, wheel);
+  }
+  
+  uint8_t action;
+  if (nameLen == 5 && strncasecmp(token, "CLICK", 5) == 0) action = MOUSE_ACTION_CLICK;
+  else if (nameLen == 9 && strncasecmp(token, "MOUSEDOWN", 9) == 0) action = MOUSE_ACTION_PRESS;
+  else if (nameLen == 7 && strncasecmp(token, "MOUSEUP", 7) == 0) action = MOUSE_ACTION_RELEASE;
+  else return false;
+  
+  // A bare CLICK is the left button
+  uint8_t buttons = colon ? parseMouseButtons(args) : (action == MOUSE_ACTION_CLICK ? MOUSE_BUTTON_LEFT : 0);
+  if (buttons == 0) return false;
+  return addByte(buffer, pos, UTF8_MOUSE_BUTTON) && addByte(buffer, pos, action | buttons);
+}
+
 static bool addKeyToBuffer(uint8_t* buffer, int* pos, const char* keyToken) {
   if (strlen(keyToken) == 1) {
     // Single character - store as literal ASCII (no conversion needed)
@@ -170,6 +269,7 @@ static bool addKeyToBuffer(uint8_t* buffer, int* pos, const char* keyToken) {
       if (utf8Code != 0) {
         return addByte(buffer, pos, utf8Code);
       }
+      return addMouseToken(buffer, pos, keyToken);
     }
   }
   return false;
@@ -251,8 +351,9 @@ MacroEncodeResult macroEncode(const char* input) {
     
     if (*pos == '"') {
       // Quoted string - process directly
-      if (!parseQuotedString(parseBuffer, &bufferPos, &pos)) {
-        result.error = ERR_BUFFER_OVERFLOW;
+      const char* quoteError = ERR_BUFFER_OVERFLOW;
+      if (!parseQuotedString(parseBuffer, &bufferPos, &pos, &quoteError)) {
+        result.error = quoteError;
         return result;
       }
     } else {
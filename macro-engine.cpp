@@ -2,9 +2,22 @@
  * Macro Execution Engine Implementation
  * 
  * Executes UTF-8+ encoded macro sequences directly via USB HID
+ *
+ * Execution is synchronous, but macroPollHook runs between key actions so
+ * a macro can be aborted, or preempted by a priority macro run nested
+ * inside it. Modifiers pressed by macros are tracked so either can hand
+ * the keyboard back in a clean state.
+ *
+ * Mouse operations go to mouse-keys.h, which batches motion into one
+ * report per poll.
  */
 
-#include "map-parser-tables.h"
+#include "macro-engine.h"
+#include "config.h"
+#include "journal.h"
+#include "usb-frame.h"
+#include "speed-stats.h"
+#include "mouse-keys.h"
 #include <Keyboard.h>
 
 //==============================================================================
@@ -31,43 +44,157 @@ static const uint16_t FUNCTION_KEY_CODES[] = {
 
 #define NUM_FUNCTION_KEYS 12
 
-void executeUTF8Macro(const uint8_t* bytes, uint16_t length) {
-  if (!bytes || length == 0) return;
-  
+void (*macroOutputHook)() = nullptr;
+void (*macroPollHook)() = nullptr;
+
+uint32_t macroAbortKeys = MACRO_ABORT_KEYS;
+uint32_t macroPriorityKeys = MACRO_PRIORITY_KEYS;
+
+//==============================================================================
+// PREEMPTION STATE
+//==============================================================================
+
+static uint8_t heldModifiers = 0;      // MULTI_* bits pressed by macros
+static uint8_t runDepth = 0;           // Macros running, nested ones included
+static bool polling = false;
+static bool abortRequested = false;
+static MacroPreemptStats preemptStats = { 0, 0 };
+
+static uint8_t modifierBit(uint8_t key) {
+  switch (key) {
+    case KEY_LEFT_CTRL:  return MULTI_CTRL;
+    case KEY_LEFT_SHIFT: return MULTI_SHIFT;
+    case KEY_LEFT_ALT:   return MULTI_ALT;
+    case KEY_LEFT_GUI:   return MULTI_CMD;
+    default:             return 0;
+  }
+}
+
+//==============================================================================
+// BYTE SOURCES
+//==============================================================================
+
+// One executor serves RAM macros and flash (PROGMEM) built-in macros
+struct RamBytes {
+  const uint8_t* bytes;
+  uint8_t operator[](uint16_t i) const { return bytes[i]; }
+};
+
+struct FlashBytes {
+  const uint8_t* bytes;
+  uint8_t operator[](uint16_t i) const { return pgm_read_byte(bytes + i); }
+};
+
+//==============================================================================
+// OUTPUT SINKS
+//==============================================================================
+
+// HID output for normal execution
+struct HidSink {
+  uint16_t chars = 0;             // Writes, for the typing speed counters
+  bool sent = false;              // First report queued (macroOutputHook)
+
+  void output() {
+    if (!sent) {
+      sent = true;
+      if (macroOutputHook) macroOutputHook();
+    }
+  }
+  void press(uint8_t key) {
+    Keyboard.press(key);
+    usbReportQueued();
+    output();
+    heldModifiers |= modifierBit(key);
+  }
+  void release(uint8_t key) {
+    Keyboard.release(key);
+    usbReportQueued();
+    output();
+    heldModifiers &= ~modifierBit(key);
+  }
+  void write(uint8_t key) { Keyboard.write(key); usbReportQueued(); output(); chars++; }
+  void mouseMove(int8_t dx, int8_t dy) { queueMouseMove(dx, dy); }
+  void mouseScroll(int8_t wheel) { queueMouseScroll(wheel); }
+  void mouseButton(uint8_t operand) { ::mouseButton(operand); output(); }
+
+  // Between actions: false once the macro has been aborted
+  bool poll() {
+    if (macroPollHook && !polling) {
+      polling = true;
+      macroPollHook();
+      polling = false;
+    }
+    return !abortRequested;
+  }
+};
+
+// Counts actions without sending them (BENCH dry runs)
+struct NullSink {
+  uint16_t actions = 0;
+  void press(uint8_t key) { actions++; }
+  void release(uint8_t key) { actions++; }
+  void write(uint8_t key) { actions++; }
+  void mouseMove(int8_t dx, int8_t dy) { actions++; }
+  void mouseScroll(int8_t wheel) { actions++; }
+  void mouseButton(uint8_t operand) { actions++; }
+  bool poll() { return true; }
+};
+
+static void pressModifiers(uint8_t mask) {
+  if (mask & MULTI_CTRL)  { Keyboard.press(KEY_LEFT_CTRL); usbReportQueued(); }
+  if (mask & MULTI_SHIFT) { Keyboard.press(KEY_LEFT_SHIFT); usbReportQueued(); }
+  if (mask & MULTI_ALT)   { Keyboard.press(KEY_LEFT_ALT); usbReportQueued(); }
+  if (mask & MULTI_CMD)   { Keyboard.press(KEY_LEFT_GUI); usbReportQueued(); }
+}
+
+static void releaseModifiers(uint8_t mask) {
+  if (mask & MULTI_CTRL)  { Keyboard.release(KEY_LEFT_CTRL); usbReportQueued(); }
+  if (mask & MULTI_SHIFT) { Keyboard.release(KEY_LEFT_SHIFT); usbReportQueued(); }
+  if (mask & MULTI_ALT)   { Keyboard.release(KEY_LEFT_ALT); usbReportQueued(); }
+  if (mask & MULTI_CMD)   { Keyboard.release(KEY_LEFT_GUI); usbReportQueued(); }
+}
+
+//==============================================================================
+// EXECUTION
+//==============================================================================
+
+template <typename Bytes, typename Sink>
+static void executeMacroBytes(const Bytes& bytes, uint16_t length, Sink& sink) {
   for (uint16_t i = 0; i < length; i++) {
+    if (i > 0 && !sink.poll()) return;
     uint8_t b = bytes[i];
     
     switch (b) {
       // Individual modifier press operations
-      case UTF8_PRESS_CTRL:    Keyboard.press(KEY_LEFT_CTRL); break;
-      case UTF8_PRESS_ALT:     Keyboard.press(KEY_LEFT_ALT); break;
-      case UTF8_PRESS_SHIFT:   Keyboard.press(KEY_LEFT_SHIFT); break;
-      case UTF8_PRESS_CMD:     Keyboard.press(KEY_LEFT_GUI); break;
+      case UTF8_PRESS_CTRL:    sink.press(KEY_LEFT_CTRL); break;
+      case UTF8_PRESS_ALT:     sink.press(KEY_LEFT_ALT); break;
+      case UTF8_PRESS_SHIFT:   sink.press(KEY_LEFT_SHIFT); break;
+      case UTF8_PRESS_CMD:     sink.press(KEY_LEFT_GUI); break;
       
       // Individual modifier release operations
-      case UTF8_RELEASE_CTRL:  Keyboard.release(KEY_LEFT_CTRL); break;
-      case UTF8_RELEASE_ALT:   Keyboard.release(KEY_LEFT_ALT); break;
-      case UTF8_RELEASE_SHIFT: Keyboard.release(KEY_LEFT_SHIFT); break;
-      case UTF8_RELEASE_CMD:   Keyboard.release(KEY_LEFT_GUI); break;
+      case UTF8_RELEASE_CTRL:  sink.release(KEY_LEFT_CTRL); break;
+      case UTF8_RELEASE_ALT:   sink.release(KEY_LEFT_ALT); break;
+      case UTF8_RELEASE_SHIFT: sink.release(KEY_LEFT_SHIFT); break;
+      case UTF8_RELEASE_CMD:   sink.release(KEY_LEFT_GUI); break;
       
       // Multi-modifier operations
       case UTF8_PRESS_MULTI:
         if (i + 1 < length) {
           uint8_t mask = bytes[++i];
-          if (mask & MULTI_CTRL)  Keyboard.press(KEY_LEFT_CTRL);
-          if (mask & MULTI_SHIFT) Keyboard.press(KEY_LEFT_SHIFT);
-          if (mask & MULTI_ALT)   Keyboard.press(KEY_LEFT_ALT);
-          if (mask & MULTI_CMD)   Keyboard.press(KEY_LEFT_GUI);
+          if (mask & MULTI_CTRL)  sink.press(KEY_LEFT_CTRL);
+          if (mask & MULTI_SHIFT) sink.press(KEY_LEFT_SHIFT);
+          if (mask & MULTI_ALT)   sink.press(KEY_LEFT_ALT);
+          if (mask & MULTI_CMD)   sink.press(KEY_LEFT_GUI);
         }
         break;
         
       case UTF8_RELEASE_MULTI:
         if (i + 1 < length) {
           uint8_t mask = bytes[++i];
-          if (mask & MULTI_CTRL)  Keyboard.release(KEY_LEFT_CTRL);
-          if (mask & MULTI_SHIFT) Keyboard.release(KEY_LEFT_SHIFT);
-          if (mask & MULTI_ALT)   Keyboard.release(KEY_LEFT_ALT);
-          if (mask & MULTI_CMD)   Keyboard.release(KEY_LEFT_GUI);
+          if (mask & MULTI_CTRL)  sink.release(KEY_LEFT_CTRL);
+          if (mask & MULTI_SHIFT) sink.release(KEY_LEFT_SHIFT);
+          if (mask & MULTI_ALT)   sink.release(KEY_LEFT_ALT);
+          if (mask & MULTI_CMD)   sink.release(KEY_LEFT_GUI);
         }
         break;
       
@@ -78,20 +205,115 @@ void executeUTF8Macro(const uint8_t* bytes, uint16_t length) {
           // Validate function key number (1-12)
           if (keyNum >= 1 && keyNum <= NUM_FUNCTION_KEYS) {
             uint16_t hidCode = FUNCTION_KEY_CODES[keyNum];
-            Keyboard.press(hidCode);
+            sink.press(hidCode);
 
-            Keyboard.release(hidCode);
+            sink.release(hidCode);
           }
           // If invalid, silently ignore (as requested)
         }
         // If no next byte available, silently ignore
         break;
       
+      // Mouse operations, signed operands offset by UTF8_MOUSE_OFFSET
+      case UTF8_MOUSE_MOVE:
+        if (i + 2 < length) {
+          int8_t dx = bytes[++i] - UTF8_MOUSE_OFFSET;
+          int8_t dy = bytes[++i] - UTF8_MOUSE_OFFSET;
+          sink.mouseMove(dx, dy);
+        }
+        break;
+        
+      case UTF8_MOUSE_SCROLL:
+        if (i + 1 < length) {
+          sink.mouseScroll(bytes[++i] - UTF8_MOUSE_OFFSET);
+        }
+        break;
+        
+      case UTF8_MOUSE_BUTTON:
+        if (i + 1 < length) {
+          sink.mouseButton(bytes[++i]);
+        }
+        break;
+      
       // All other bytes are direct HID codes or printable characters
       default:
-        Keyboard.write(b);
+        sink.write(b);
+    }
+  }
+}
+
+// Runs a macro with HID output. Started while another runs (from the poll
+// hook), it gets a keyboard free of the outer macro's modifiers, and the
+// outer macro gets them back afterwards. Returns the characters it typed
+template <typename Bytes>
+static uint16_t runMacro(const Bytes& bytes, uint16_t length) {
+  uint8_t outerModifiers = heldModifiers;
+  if (runDepth > 0) {
+    if (abortRequested) return 0;
+    preemptStats.preemptions++;
+    releaseModifiers(outerModifiers);
+    heldModifiers = 0;
+  }
+
+  runDepth++;
+  HidSink sink;
+  executeMacroBytes(bytes, length, sink);
+  runDepth--;
+
+  if (abortRequested) {
+    if (runDepth == 0) {
+      releaseModifiers(heldModifiers);
+      heldModifiers = 0;
+      releaseMouseButtons();
+      abortRequested = false;
     }
+  } else if (runDepth > 0) {
+    releaseModifiers(heldModifiers & ~outerModifiers);
+    pressModifiers(outerModifiers & ~heldModifiers);
+    heldModifiers = outerModifiers;
   }
+  return sink.chars;
+}
+
+void executeUTF8Macro(const uint8_t* bytes, uint16_t length) {
+  if (!bytes || length == 0) return;
+  journalRecordMacro(bytes, length, false);
+  speedRecordChars(runMacro(RamBytes{bytes}, length));
+}
+
+void executeUTF8MacroP(const char* macro) {
+  if (!macro) return;
+  uint16_t length = strlen_P(macro);
+  journalRecordMacro((const uint8_t*)macro, length, true);
+  speedRecordChars(runMacro(FlashBytes{(const uint8_t*)macro}, length));
+}
+
+uint16_t dryRunUTF8Macro(const uint8_t* bytes, uint16_t length) {
+  NullSink sink;
+  if (bytes && length > 0) executeMacroBytes(RamBytes{bytes}, length, sink);
+  return sink.actions;
+}
+
+//==============================================================================
+// PREEMPTION
+//==============================================================================
+
+void abortMacro() {
+  if (runDepth == 0 || abortRequested) return;
+  abortRequested = true;
+  preemptStats.aborts++;
+}
+
+bool isMacroRunning() {
+  return runDepth > 0;
+}
+
+const MacroPreemptStats& macroPreemptStats() {
+  return preemptStats;
+}
+
+void resetMacroPreemptStats() {
+  preemptStats = { 0, 0 };
 }
 
 void initializeMacroEngine() {
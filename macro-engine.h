@@ -15,4 +15,44 @@
 
 void executeUTF8Macro(const uint8_t* bytes, uint16_t length);
 
+// Execute a NUL-terminated macro stored in PROGMEM (built-in profiles)
+void executeUTF8MacroP(const char* macro);
+
+// Decode a macro without sending HID reports; returns the number of key
+// actions it would send (BENCH)
+uint16_t dryRunUTF8Macro(const uint8_t* bytes, uint16_t length);
+
+// Called as each macro queues its first HID report, nullptr when unused
+// (input simulation timestamps its output here)
+extern void (*macroOutputHook)();
+
+//==============================================================================
+// PREEMPTION
+//==============================================================================
+
+// Called between the key actions of a running macro, nullptr when unused.
+// The input side checks the switches here: the abort gesture calls
+// abortMacro(), and a priority key's macro is run by calling
+// executeUTF8Macro() again. The running macro's modifiers are released
+// around the nested one and pressed again after it.
+extern void (*macroPollHook)();
+
+// Keys held together to abort (0 = none), and keys whose macros preempt
+// (input policy; the engine only stores them for PREEMPT)
+extern uint32_t macroAbortKeys;
+extern uint32_t macroPriorityKeys;
+
+// Stop every running macro and release the modifiers they hold
+void abortMacro();
+
+bool isMacroRunning();
+
+struct MacroPreemptStats {
+  uint16_t aborts;
+  uint16_t preemptions;       // Macros run inside another
+};
+
+const MacroPreemptStats& macroPreemptStats();
+void resetMacroPreemptStats();
+
 #endif // MACRO_ENGINE_H
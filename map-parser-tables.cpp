@@ -172,6 +172,13 @@ bool isUTF8ControlCode(uint8_t b) {
   if (b == UTF8_PRESS_MULTI || b == UTF8_RELEASE_MULTI) return true;  // 0x0E-0x0F
   if (b >= UTF8_RELEASE_ALT && b <= UTF8_RELEASE_CMD) return true;  // 0x10-0x12
   if (b >= UTF8_KEY_DOWN && b <= UTF8_KEY_DELETE) return true;  // 0x13-0x1A
+  if (b >= UTF8_MOUSE_MOVE && b <= UTF8_MOUSE_SCROLL) return true;  // 0x1D-0x1F
   
   return false;
 }
+
+bool isMouseButtonOperand(uint8_t operand) {
+  return (operand & MOUSE_BUTTON_MASK) != 0 &&
+         (operand & ~(MOUSE_BUTTON_MASK | MOUSE_ACTION_MASK)) == 0 &&
+         (operand & MOUSE_ACTION_MASK) != (MOUSE_ACTION_PRESS | MOUSE_ACTION_RELEASE);
+}
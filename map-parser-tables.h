@@ -56,7 +56,23 @@
 // 0x01B is ESC do not use that.
 #define UTF8_KEY_DELETE      0x1C
                                  
-// Reserved for future expansion: 0x1D, 0x1Em 0x1F
+// Mouse operations (mouse-keys.h). Signed operands are stored plus 0x80,
+// so -127..127 never produces a NUL
+#define UTF8_MOUSE_MOVE      0x1D  // Followed by dx + 0x80, dy + 0x80
+#define UTF8_MOUSE_BUTTON    0x1E  // Followed by action | buttons
+#define UTF8_MOUSE_SCROLL    0x1F  // Followed by wheel + 0x80
+
+#define UTF8_MOUSE_OFFSET    0x80
+
+// Mouse button operand: buttons in the low bits, action above
+#define MOUSE_BUTTON_LEFT    0x01
+#define MOUSE_BUTTON_RIGHT   0x02
+#define MOUSE_BUTTON_MIDDLE  0x04
+#define MOUSE_BUTTON_MASK    0x07
+#define MOUSE_ACTION_CLICK   0x00
+#define MOUSE_ACTION_PRESS   0x10
+#define MOUSE_ACTION_RELEASE 0x20
+#define MOUSE_ACTION_MASK    0x30
 
 // Special character keys that were previously keywords
 // These now map to their literal ASCII values in the encoder/decoder
@@ -107,4 +123,7 @@ bool isRegularCharacter(uint8_t b);
 bool needsQuoting(uint8_t b);
 bool isUTF8ControlCode(uint8_t b);  // Helper to identify all UTF-8+ control codes
 
+// Mouse button operand is a known action on at least one button
+bool isMouseButtonOperand(uint8_t operand);
+
 #endif // MAP_PARSER_TABLES_H
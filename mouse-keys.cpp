@@ -0,0 +1,198 @@
+/*
+ * Mouse Keys Implementation
+ */
+
+#include "mouse-keys.h"
+#include "map-parser-tables.h"
+#include <Mouse.h>
+
+// A stalled loop must not turn into one large jump
+#define MOUSE_MAX_ELAPSED_US 20000
+
+//==============================================================================
+// STATE
+//==============================================================================
+
+struct HeldMotion {
+  uint8_t key;
+  int8_t dx;
+  int8_t dy;
+  int8_t wheel;
+  uint32_t startMs;
+};
+
+static HeldMotion held[MOUSE_HELD_MAX];
+static uint8_t heldCount = 0;
+static uint8_t holdKey = MOUSE_NO_KEY;
+
+static int16_t pendingX = 0, pendingY = 0, pendingWheel = 0;
+static int32_t fractionX = 0, fractionY = 0, fractionWheel = 0;   // 1/256 steps
+static uint8_t pressedButtons = 0;
+static uint32_t lastRunUs = 0;
+static MouseKeyStats stats = { 0, 0 };
+
+static int8_t clampReport(int16_t value) {
+  return value > 127 ? 127 : (value < -127 ? -127 : value);
+}
+
+// One report with as much of the pending motion as it can carry
+static void sendPending() {
+  if (pendingX == 0 && pendingY == 0 && pendingWheel == 0) return;
+  int8_t x = clampReport(pendingX);
+  int8_t y = clampReport(pendingY);
+  int8_t wheel = clampReport(pendingWheel);
+  Mouse.move(x, y, wheel);
+  pendingX -= x;
+  pendingY -= y;
+  pendingWheel -= wheel;
+  stats.reports++;
+}
+
+// The held motion entry for the key whose press macro is running
+static HeldMotion* holdEntry() {
+  if (holdKey == MOUSE_NO_KEY) return nullptr;
+  for (uint8_t i = 0; i < heldCount; i++) {
+    if (held[i].key == holdKey) return &held[i];
+  }
+  if (heldCount >= MOUSE_HELD_MAX) return nullptr;
+  HeldMotion& motion = held[heldCount++];
+  motion.key = holdKey;
+  motion.dx = motion.dy = motion.wheel = 0;
+  motion.startMs = millis();
+  return &motion;
+}
+
+//==============================================================================
+// OUTPUT
+//==============================================================================
+
+void setupMouseKeys() {
+  Mouse.begin();
+  lastRunUs = micros();
+}
+
+void loopMouseKeys() {
+  uint32_t now = micros();
+  uint32_t elapsedUs = now - lastRunUs;
+  lastRunUs = now;
+  if (elapsedUs > MOUSE_MAX_ELAPSED_US) elapsedUs = MOUSE_MAX_ELAPSED_US;
+
+  if (heldCount > 0) {
+    uint32_t nowMs = millis();
+    for (uint8_t i = 0; i < heldCount; i++) {
+      uint16_t rate = mouseStepRate(nowMs - held[i].startMs);
+      if (rate == 0) continue;
+      // Steps covered since the last run, in 1/256 steps (1e6 / 256 us)
+      int32_t units = (uint32_t)rate * elapsedUs / 3906;
+      fractionX += held[i].dx * units;
+      fractionY += held[i].dy * units;
+      fractionWheel += held[i].wheel * units / MOUSE_WHEEL_DIVISOR;
+    }
+    pendingX += fractionX / 256;
+    pendingY += fractionY / 256;
+    pendingWheel += fractionWheel / 256;
+    fractionX %= 256;
+    fractionY %= 256;
+    fractionWheel %= 256;
+  }
+
+  sendPending();
+}
+
+void queueMouseMove(int8_t dx, int8_t dy) {
+  pendingX += dx;
+  pendingY += dy;
+  stats.steps++;
+  HeldMotion* motion = holdEntry();
+  if (motion) {
+    motion->dx = clampReport(motion->dx + dx);
+    motion->dy = clampReport(motion->dy + dy);
+  }
+}
+
+void queueMouseScroll(int8_t wheel) {
+  pendingWheel += wheel;
+  stats.steps++;
+  HeldMotion* motion = holdEntry();
+  if (motion) motion->wheel = clampReport(motion->wheel + wheel);
+}
+
+void mouseButton(uint8_t operand) {
+  if (!isMouseButtonOperand(operand)) return;
+  // All of it, even past one report, so the click lands where the macro moved to
+  while (pendingX != 0 || pendingY != 0 || pendingWheel != 0) sendPending();
+
+  uint8_t buttons = operand & MOUSE_BUTTON_MASK;
+  switch (operand & MOUSE_ACTION_MASK) {
+    case MOUSE_ACTION_PRESS:
+      Mouse.press(buttons);
+      pressedButtons |= buttons;
+      break;
+    case MOUSE_ACTION_RELEASE:
+      Mouse.release(buttons);
+      pressedButtons &= ~buttons;
+      break;
+    default:
+      Mouse.click(buttons);
+      break;
+  }
+}
+
+void releaseMouseButtons() {
+  if (pressedButtons) Mouse.release(pressedButtons);
+  pressedButtons = 0;
+}
+
+//==============================================================================
+// HELD MOTION
+//==============================================================================
+
+uint8_t beginMouseKeyMacro(uint8_t keyIndex) {
+  // A fresh press starts the curve again
+  for (uint8_t i = 0; i < heldCount; i++) {
+    if (held[i].key == keyIndex) {
+      held[i] = held[--heldCount];
+      break;
+    }
+  }
+  uint8_t previous = holdKey;
+  holdKey = keyIndex;
+  return previous;
+}
+
+void endMouseKeyMacro(uint8_t previous) {
+  holdKey = previous;
+}
+
+void updateMouseKeys(uint32_t switches) {
+  for (uint8_t i = 0; i < heldCount; ) {
+    if (switches & (1UL << held[i].key)) {
+      i++;
+    } else {
+      held[i] = held[--heldCount];
+    }
+  }
+  if (heldCount == 0) {
+    fractionX = fractionY = fractionWheel = 0;
+  }
+}
+
+uint16_t mouseStepRate(uint32_t heldMs) {
+  if (heldMs < MOUSE_DELAY_MS) return 0;
+  uint32_t t = heldMs - MOUSE_DELAY_MS;
+  if (t >= MOUSE_ACCEL_MS) return MOUSE_MAX_RATE;
+  uint32_t f = t * 256 / MOUSE_ACCEL_MS;
+  return MOUSE_MIN_RATE + (uint32_t)(MOUSE_MAX_RATE - MOUSE_MIN_RATE) * f * f / 65536;
+}
+
+//==============================================================================
+// STATISTICS
+//==============================================================================
+
+const MouseKeyStats& mouseKeyStats() {
+  return stats;
+}
+
+void resetMouseKeyStats() {
+  stats = { 0, 0 };
+}
@@ -0,0 +1,76 @@
+/*
+ * Mouse Keys Interface
+ *
+ * Pointer motion, scrolling and buttons for the UTF-8+ mouse operations.
+ * Moves and scrolls are not sent as they run: they add to a pending report
+ * that the mouse task sends once per MOUSE_PERIOD_US (the mouse endpoint's
+ * poll interval), so a macro of many small steps, or several held keys,
+ * cost one report per poll. Button operations first send all pending
+ * motion, in as many reports as it takes, so the click lands where the
+ * macro moved to.
+ *
+ * A move or scroll in a key's press macro also repeats while that key is
+ * held: after MOUSE_DELAY_MS the step is applied MOUSE_MIN_RATE times a
+ * second, speeding up along a quadratic curve to MOUSE_MAX_RATE over
+ * MOUSE_ACCEL_MS. The task integrates that rate in 1/256 step fractions,
+ * so slow motion stays smooth at the full report rate.
+ */
+
+#ifndef MOUSE_KEYS_H
+#define MOUSE_KEYS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#define MOUSE_HELD_MAX   4          // Keys moving the pointer at once
+#define MOUSE_NO_KEY     0xFF
+
+//==============================================================================
+// OUTPUT
+//==============================================================================
+
+// Call from setup()
+void setupMouseKeys();
+
+// Mouse task: advances held motion and sends at most one report
+void loopMouseKeys();
+
+// Add to the pending report
+void queueMouseMove(int8_t dx, int8_t dy);
+void queueMouseScroll(int8_t wheel);
+
+// UTF8_MOUSE_BUTTON operand: click, press or release
+void mouseButton(uint8_t operand);
+
+// Release the buttons macros left pressed (macro abort)
+void releaseMouseButtons();
+
+//==============================================================================
+// HELD MOTION
+//==============================================================================
+
+// Around a key's press macro: its moves and scrolls repeat until
+// updateMouseKeys() sees the key released. begin returns the key of an
+// outer press macro (or MOUSE_NO_KEY) for end to put back
+uint8_t beginMouseKeyMacro(uint8_t keyIndex);
+void endMouseKeyMacro(uint8_t previous);
+
+// Call with the switch state on every change; stops released keys
+void updateMouseKeys(uint32_t switches);
+
+// Steps per second a key held this long moves at (0 before MOUSE_DELAY_MS)
+uint16_t mouseStepRate(uint32_t heldMs);
+
+//==============================================================================
+// STATISTICS
+//==============================================================================
+
+struct MouseKeyStats {
+  uint32_t steps;                // Moves and scrolls queued by macros
+  uint32_t reports;              // Motion reports sent
+};
+
+const MouseKeyStats& mouseKeyStats();
+void resetMouseKeyStats();
+
+#endif // MOUSE_KEYS_H
@@ -0,0 +1,107 @@
+/*
+ * Cooperative Task Scheduler Implementation
+ *
+ * Due times advance by whole periods so a task keeps its rate rather than
+ * drifting by its own run time. Due times already past when a run ends
+ * are skipped, keeping the phase, and counted as missed rather than run
+ * back to back.
+ */
+
+#include "scheduler.h"
+
+//==============================================================================
+// STATE
+//==============================================================================
+
+static SchedulerTask tasks[SCHEDULER_TASKS];
+static uint8_t taskCount = 0;
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static void runIfDue(SchedulerTask& task) {
+  uint32_t now = micros();
+  if (task.running || (int32_t)(now - task.nextDueUs) < 0) return;
+
+  uint32_t late = now - task.nextDueUs;
+  if (late > task.maxLateUs) task.maxLateUs = late;
+
+  task.running = true;
+  task.run();
+  task.running = false;
+
+  uint32_t end = micros();
+  uint32_t elapsed = end - now;
+  task.runs++;
+  if (elapsed > task.maxRunUs) task.maxRunUs = elapsed;
+  if (elapsed > task.budgetUs && task.overruns < 0xFFFF) task.overruns++;
+
+  task.nextDueUs += task.periodUs;
+  if ((int32_t)(end - task.nextDueUs) >= 0) {
+    uint32_t skipped = (end - task.nextDueUs) / task.periodUs + 1;
+    task.missed = (task.missed + skipped > 0xFFFF) ? 0xFFFF : task.missed + skipped;
+    task.nextDueUs += skipped * task.periodUs;
+  }
+}
+
+//==============================================================================
+// SCHEDULING
+//==============================================================================
+
+bool addTask(const char* name, TaskFunction run, uint32_t periodUs, uint32_t budgetUs) {
+  if (taskCount >= SCHEDULER_TASKS || !run || periodUs == 0) return false;
+
+  SchedulerTask& task = tasks[taskCount++];
+  task = SchedulerTask();
+  task.name = name;
+  task.run = run;
+  task.periodUs = periodUs;
+  task.budgetUs = budgetUs;
+  task.nextDueUs = micros();
+  return true;
+}
+
+void runScheduler() {
+  if (taskCount == 0) return;
+
+  runIfDue(tasks[0]);
+  for (uint8_t i = 1; i < taskCount; i++) {
+    runIfDue(tasks[i]);
+    runIfDue(tasks[0]);
+  }
+}
+
+void schedulerYield() {
+  if (taskCount > 0) runIfDue(tasks[0]);
+}
+
+void alignTask(uint8_t index, uint32_t dueUs) {
+  if (index >= taskCount) return;
+  // An overdue task runs first; with loop passes slower than the period,
+  // aligning on every pass would keep it in the future for good
+  if ((int32_t)(micros() - tasks[index].nextDueUs) > 0) return;
+  tasks[index].nextDueUs = dueUs;
+}
+
+//==============================================================================
+// STATISTICS
+//==============================================================================
+
+uint8_t schedulerTaskCount() {
+  return taskCount;
+}
+
+const SchedulerTask& schedulerTask(uint8_t index) {
+  return tasks[index < taskCount ? index : 0];
+}
+
+void resetSchedulerStats() {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    tasks[i].runs = 0;
+    tasks[i].maxRunUs = 0;
+    tasks[i].maxLateUs = 0;
+    tasks[i].overruns = 0;
+    tasks[i].missed = 0;
+  }
+}
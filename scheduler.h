@@ -0,0 +1,69 @@
+/*
+ * Cooperative Task Scheduler Interface
+ *
+ * Runs the main loop's subsystems at fixed periods instead of one
+ * unconditional sequence. Each task records its run time against a
+ * budget and how late it started, so a subsystem hogging the loop shows
+ * up in TASKS rather than as sluggish keys.
+ *
+ * The first task added is the input task. It is checked before every
+ * other task, and long-running work elsewhere (SAVE) calls
+ * schedulerYield() between records so a due scan is never held up for
+ * more than one record of that work.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+
+#ifndef SCHEDULER_TASKS
+#define SCHEDULER_TASKS 4
+#endif
+
+typedef void (*TaskFunction)();
+
+struct SchedulerTask {
+  const char* name;
+  TaskFunction run;
+  uint32_t periodUs;
+  uint32_t budgetUs;
+  uint32_t nextDueUs;
+  uint32_t runs;
+  uint32_t maxRunUs;
+  uint32_t maxLateUs;            // Start time past the due time
+  uint16_t overruns;             // Runs longer than budgetUs
+  uint16_t missed;               // Periods skipped because it fell behind
+  bool running;
+};
+
+//==============================================================================
+// SCHEDULING
+//==============================================================================
+
+// Register a task due every periodUs, first run immediately; false if full
+bool addTask(const char* name, TaskFunction run, uint32_t periodUs, uint32_t budgetUs);
+
+// Call from loop(): runs every due task, the input task before each
+void runScheduler();
+
+// Runs the input task if it is due and not already running
+void schedulerYield();
+
+// Move a task's next due time, keeping its period from there (phase lock);
+// ignored while the task is overdue
+void alignTask(uint8_t index, uint32_t dueUs);
+
+//==============================================================================
+// STATISTICS
+//==============================================================================
+
+uint8_t schedulerTaskCount();
+const SchedulerTask& schedulerTask(uint8_t index);
+void resetSchedulerStats();
+
+#endif // SCHEDULER_H
@@ -5,6 +5,7 @@
  */
 
 #include "serial-interface.h"
+#include "stack-monitor.h"
 
 //==============================================================================
 // READLINE IMPLEMENTATION - Include directly since it's needed
@@ -26,50 +27,109 @@
 #include "commands/cmd-chord.cpp"
 #include "commands/cmd-save.cpp"
 #include "commands/cmd-stat.cpp"
+#include "commands/cmd-config.cpp"
+#include "commands/cmd-sim.cpp"
+#include "commands/cmd-bench.cpp"
+#include "commands/cmd-journal.cpp"
+#include "commands/cmd-tasks.cpp"
+#include "commands/cmd-preempt.cpp"
+#include "commands/cmd-events.cpp"
+#include "commands/cmd-speed.cpp"
+#include "commands/cmd-dump.cpp"
 
 
 //==============================================================================
 // COMMAND PROCESSING
 //==============================================================================
 
-void processCommand(const char* cmd) {
-  // Skip leading whitespace
-  while (isspace(*cmd)) cmd++;
-  if (*cmd == '\0') return;
-  
-  // Find arguments (first space after command)
-  const char* args = cmd;
-  while (*args && !isspace(*args)) args++;
-  while (isspace(*args)) args++;
-  
-  // Dispatch commands using standard string functions
+// Runs the command; returns its name, or nullptr if unknown
+static const char* dispatchCommand(const char* cmd, const char* args) {
   if (strncasecmp(cmd, "HELP", 4) == 0) {
     cmdHelp();
+    return "HELP";
   }
-  else if (strncasecmp(cmd, "SHOW", 4) == 0) {
+  if (strncasecmp(cmd, "SHOW", 4) == 0) {
     cmdShow(args);
+    return "SHOW";
   }
-  else if (strncasecmp(cmd, "MAP", 3) == 0) {
+  if (strncasecmp(cmd, "MAP", 3) == 0) {
     cmdMap(args);
+    return "MAP";
   }
-  else if (strncasecmp(cmd, "CLEAR", 5) == 0) {
+  if (strncasecmp(cmd, "CLEAR", 5) == 0) {
     cmdClear(args);
+    return "CLEAR";
   }
-  else if (strncasecmp(cmd, "CHORD", 5) == 0) {
+  if (strncasecmp(cmd, "CHORD", 5) == 0) {
     cmdChord(args);
+    return "CHORD";
+  }
+  if (strncasecmp(cmd, "CONFIG", 6) == 0) {
+    cmdConfig(args);
+    return "CONFIG";
+  }
+  if (strncasecmp(cmd, "BENCH", 5) == 0) {
+    cmdBench();
+    return "BENCH";
+  }
+  if (strncasecmp(cmd, "SIM", 3) == 0) {
+    cmdSim(args);
+    return "SIM";
+  }
+  if (strncasecmp(cmd, "JOURNAL", 7) == 0) {
+    cmdJournal(args);
+    return "JOURNAL";
+  }
+  if (strncasecmp(cmd, "TASKS", 5) == 0) {
+    cmdTasks(args);
+    return "TASKS";
+  }
+  if (strncasecmp(cmd, "PREEMPT", 7) == 0) {
+    cmdPreempt(args);
+    return "PREEMPT";
   }
-  else if (strncasecmp(cmd, "LOAD", 4) == 0) {
+  if (strncasecmp(cmd, "EVENTS", 6) == 0) {
+    cmdEvents(args);
+    return "EVENTS";
+  }
+  if (strncasecmp(cmd, "SPEED", 5) == 0) {
+    cmdSpeed(args);
+    return "SPEED";
+  }
+  if (strncasecmp(cmd, "DUMP", 4) == 0) {
+    cmdDump();
+    return "DUMP";
+  }
+  if (strncasecmp(cmd, "LOAD", 4) == 0) {
     cmdLoad();
+    return "LOAD";
   }
-  else if (strncasecmp(cmd, "SAVE", 4) == 0) {
+  if (strncasecmp(cmd, "SAVE", 4) == 0) {
     cmdSave();
+    return "SAVE";
   }
-  else if (strncasecmp(cmd, "STAT", 4) == 0) {
+  if (strncasecmp(cmd, "STAT", 4) == 0) {
     cmdStat();
+    return "STAT";
   }
-  else {
-    Serial.println(F("Unknown command - type HELP"));
-  }
+  Serial.println(F("Unknown command - type HELP"));
+  return nullptr;
+}
+
+void processCommand(const char* cmd) {
+  // Skip leading whitespace
+  while (isspace(*cmd)) cmd++;
+  if (*cmd == '\0') return;
+  
+  // Find arguments (first space after command)
+  const char* args = cmd;
+  while (*args && !isspace(*args)) args++;
+  while (isspace(*args)) args++;
+  
+  // Measure each command's stack peak on its own
+  stackBeginCommand();
+  const char* name = dispatchCommand(cmd, args);
+  if (name) stackEndCommand(name);
 }
 
 //==============================================================================
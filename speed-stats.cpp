@@ -0,0 +1,106 @@
+/*
+ * Typing Speed Telemetry Implementation
+ */
+
+#include "speed-stats.h"
+#include "journal.h"
+
+void (*speedTraceHook)(bool gesture, uint32_t data) = nullptr;
+
+//==============================================================================
+// BUCKET RING
+//==============================================================================
+
+struct SpeedBucket {
+  uint16_t chars;
+  uint8_t chords;
+  uint8_t gestures;
+  uint8_t cancelled;
+  uint32_t gestureMs;
+};
+
+static SpeedBucket buckets[SPEED_BUCKETS];
+static uint8_t head = 0;                // Bucket being filled
+static uint32_t headStartMs = 0;
+static uint32_t resetMs = 0;
+
+// Move head to the bucket holding now, emptying the buckets passed over;
+// after a long idle spell the whole ring is emptied at once
+static void advance(uint32_t now) {
+  uint32_t passed = (now - headStartMs) / SPEED_BUCKET_MS;
+  if (passed == 0) return;
+  headStartMs += passed * SPEED_BUCKET_MS;
+  if (passed >= SPEED_BUCKETS) {
+    memset(buckets, 0, sizeof(buckets));
+    return;
+  }
+  while (passed--) {
+    head = (head + 1) % SPEED_BUCKETS;
+    memset(&buckets[head], 0, sizeof(SpeedBucket));
+  }
+}
+
+static void addSaturated(uint8_t& counter) {
+  if (counter < 0xFF) counter++;
+}
+
+//==============================================================================
+// RECORDING
+//==============================================================================
+
+void speedRecordChars(uint16_t count) {
+  if (count == 0) return;
+  advance(millis());
+  SpeedBucket& bucket = buckets[head];
+  bucket.chars = (bucket.chars > 0xFFFF - count) ? 0xFFFF : bucket.chars + count;
+  if (speedTraceHook) speedTraceHook(false, count);
+}
+
+void speedRecordGesture(uint8_t outcome, uint32_t durationMs) {
+  advance(millis());
+  SpeedBucket& bucket = buckets[head];
+  addSaturated(bucket.gestures);
+  bucket.gestureMs += durationMs;
+  if (outcome == JOURNAL_CHORD_FIRED || outcome == JOURNAL_CHORD_CORRECTED) {
+    addSaturated(bucket.chords);
+  } else if (outcome == JOURNAL_CHORD_CANCELLED) {
+    addSaturated(bucket.cancelled);
+  }
+  if (speedTraceHook) {
+    speedTraceHook(true, ((uint32_t)outcome << 24) | (durationMs < 0xFFFFFF ? durationMs : 0xFFFFFF));
+  }
+}
+
+//==============================================================================
+// READING
+//==============================================================================
+
+SpeedWindow speedWindow(uint32_t windowMs) {
+  uint32_t now = millis();
+  advance(now);
+
+  uint8_t count = (windowMs + SPEED_BUCKET_MS - 1) / SPEED_BUCKET_MS;
+  if (windowMs > SPEED_WINDOW_MS) count = SPEED_BUCKETS;
+  if (count == 0) count = 1;
+
+  SpeedWindow window = { 0, 0, 0, 0, 0, 0 };
+  for (uint8_t i = 0; i < count; i++) {
+    const SpeedBucket& bucket = buckets[(head + SPEED_BUCKETS - i) % SPEED_BUCKETS];
+    window.chars += bucket.chars;
+    window.chords += bucket.chords;
+    window.gestures += bucket.gestures;
+    window.cancelled += bucket.cancelled;
+    window.gestureMs += bucket.gestureMs;
+  }
+
+  // From the start of the oldest bucket summed, or the last reset if later
+  window.spanMs = now - (headStartMs - (uint32_t)(count - 1) * SPEED_BUCKET_MS);
+  if (now - resetMs < window.spanMs) window.spanMs = now - resetMs;
+  return window;
+}
+
+void resetSpeedStats() {
+  memset(buckets, 0, sizeof(buckets));
+  head = 0;
+  headStartMs = resetMs = millis();
+}
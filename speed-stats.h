@@ -0,0 +1,67 @@
+/*
+ * Typing Speed Telemetry Interface
+ *
+ * Sliding-window counters fed by the macro executor and the chord engine:
+ * characters typed, chords fired, chord gestures and their durations, and
+ * cancelled gestures. Time is split into SPEED_BUCKET_MS buckets in a ring
+ * of SPEED_BUCKETS; recording an event adds to the current bucket, so the
+ * cost per event is constant. Windows are summed from the newest buckets
+ * when they are read (SPEED).
+ */
+
+#ifndef SPEED_STATS_H
+#define SPEED_STATS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+
+#ifndef SPEED_BUCKETS
+#define SPEED_BUCKETS 12
+#endif
+
+#define SPEED_BUCKET_MS    5000
+#define SPEED_WINDOW_MS    ((uint32_t)SPEED_BUCKETS * SPEED_BUCKET_MS)
+
+// Characters per word for WPM
+#define SPEED_WORD_CHARS   5
+
+//==============================================================================
+// RECORDING
+//==============================================================================
+
+// Characters one macro typed (HID writes, not modifiers or function keys)
+void speedRecordChars(uint16_t count);
+
+// A chord gesture ended: outcome is a JOURNAL_CHORD_* outcome, duration
+// runs from the first chord key press to the last release
+void speedRecordGesture(uint8_t outcome, uint32_t durationMs);
+
+// Called for each recorded event, nullptr when unused: gesture = false
+// with the characters typed, or true with (outcome << 24) | duration ms
+// (the host event channel reports these)
+extern void (*speedTraceHook)(bool gesture, uint32_t data);
+
+//==============================================================================
+// READING
+//==============================================================================
+
+struct SpeedWindow {
+  uint32_t spanMs;        // Time covered, shorter than asked after a reset
+  uint32_t chars;
+  uint16_t chords;        // Fired, corrected chords included
+  uint16_t gestures;      // Every chord gesture, whatever its outcome
+  uint16_t cancelled;
+  uint32_t gestureMs;     // Summed gesture durations
+};
+
+// Totals over the newest buckets covering about windowMs, up to SPEED_WINDOW_MS
+SpeedWindow speedWindow(uint32_t windowMs);
+
+// Forget everything recorded so far
+void resetSpeedStats();
+
+#endif // SPEED_STATS_H
@@ -0,0 +1,144 @@
+/*
+ * Stack Monitor Implementation
+ *
+ * Painting and scanning go through volatile pointers so the compiler
+ * cannot drop stores to memory it considers dead. The scan starts at the
+ * higher of the current heap end and where the last paint started: the
+ * heap may have grown over painted bytes, or shrunk and left unpainted
+ * ones behind.
+ */
+
+#include "stack-monitor.h"
+
+#include <string.h>
+
+//==============================================================================
+// PLATFORM BOUNDS
+//==============================================================================
+
+#if defined(__AVR__)
+extern char* __brkval;
+extern char __heap_start;
+
+static uint8_t* stackTop() { return (uint8_t*)RAMEND; }
+static uint8_t* heapEnd() { return (uint8_t*)(__brkval ? __brkval : &__heap_start); }
+
+static void initBounds(uint8_t* frame) {}
+
+#elif defined(ARDUINO_ARCH_RP2040)
+// Core 0 stack from the pico-sdk linker script; the heap lives elsewhere
+extern uint8_t __StackBottom;
+extern uint8_t __StackTop;
+
+static uint8_t* stackTop() { return &__StackTop; }
+static uint8_t* heapEnd() { return &__StackBottom; }
+
+static void initBounds(uint8_t* frame) {}
+
+#else
+#define STACK_HOST_WINDOW 32768
+
+static uint8_t* hostTop;
+
+static uint8_t* stackTop() { return hostTop; }
+static uint8_t* heapEnd() { return hostTop - STACK_HOST_WINDOW; }
+
+static void initBounds(uint8_t* frame) {
+  hostTop = frame;
+}
+#endif
+
+//==============================================================================
+// STATE
+//==============================================================================
+
+struct CommandPeak {
+  const char* name;
+  uint16_t bytes;
+};
+
+static uint8_t* paintedFrom;
+static uint16_t peakBytes;
+static uint16_t minFreeBytes = 0xFFFF;
+static CommandPeak commandPeaks[STACK_COMMAND_SLOTS];
+static uint8_t commandCount;
+
+//==============================================================================
+// PAINT AND SCAN
+//==============================================================================
+
+static void __attribute__((noinline)) paintFreeStack() {
+  volatile uint8_t* p = heapEnd();
+  uint8_t* end = (uint8_t*)__builtin_frame_address(0) - STACK_PAINT_GUARD;
+  paintedFrom = (uint8_t*)p;
+  while (p < end) *p++ = STACK_PAINT;
+}
+
+// Bytes used from the stack top down to the deepest overwritten paint;
+// also updates the overall peak and minimum free gap
+static uint16_t __attribute__((noinline)) scanStack() {
+  uint8_t* heap = heapEnd();
+  volatile uint8_t* p = paintedFrom > heap ? paintedFrom : heap;
+  uint8_t* sp = (uint8_t*)__builtin_frame_address(0);
+  while ((uint8_t*)p < sp && *p == STACK_PAINT) p++;
+
+  uint16_t used = stackTop() - (uint8_t*)p;
+  uint16_t gap = (uint8_t*)p - heap;
+  if (used > peakBytes) peakBytes = used;
+  if (gap < minFreeBytes) minFreeBytes = gap;
+  return used;
+}
+
+//==============================================================================
+// MEASUREMENT
+//==============================================================================
+
+void __attribute__((noinline)) setupStackMonitor() {
+  initBounds((uint8_t*)__builtin_frame_address(0));
+  paintFreeStack();
+}
+
+void stackBeginCommand() {
+  if (!paintedFrom) return;
+  scanStack();
+  paintFreeStack();
+}
+
+void stackEndCommand(const char* name) {
+  if (!paintedFrom) return;
+  uint16_t used = scanStack();
+
+  uint8_t i = 0;
+  while (i < commandCount && strcmp(commandPeaks[i].name, name) != 0) i++;
+  if (i == commandCount) {
+    if (commandCount == STACK_COMMAND_SLOTS) return;
+    commandPeaks[commandCount++] = { name, 0 };
+  }
+  if (used > commandPeaks[i].bytes) commandPeaks[i].bytes = used;
+}
+
+//==============================================================================
+// RESULTS
+//==============================================================================
+
+uint16_t stackPeak() {
+  if (paintedFrom) scanStack();
+  return peakBytes;
+}
+
+uint16_t stackMinFree() {
+  if (paintedFrom) scanStack();
+  return minFreeBytes;
+}
+
+uint8_t stackCommandCount() {
+  return commandCount;
+}
+
+const char* stackCommandName(uint8_t index) {
+  return index < commandCount ? commandPeaks[index].name : "";
+}
+
+uint16_t stackCommandPeak(uint8_t index) {
+  return index < commandCount ? commandPeaks[index].bytes : 0;
+}
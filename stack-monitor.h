@@ -0,0 +1,59 @@
+/*
+ * Stack Monitor Interface
+ *
+ * Measures how deep the stack has actually gone. The free gap between the
+ * heap and the stack is painted with a known byte; the lowest address no
+ * longer holding it marks the deepest use since painting. The gap is
+ * repainted before every console command, so each command's peak is
+ * measured on its own, while loop() work in between (chords, macros) is
+ * folded into the overall peak first.
+ *
+ * On the host the "stack" is a window below the frame that called
+ * setupStackMonitor(), which gives the same numbers relative to that frame.
+ */
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include <Arduino.h>
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+
+// Commands with a recorded peak (4 bytes each)
+#ifndef STACK_COMMAND_SLOTS
+#define STACK_COMMAND_SLOTS 16
+#endif
+
+#define STACK_PAINT        0xC5
+#define STACK_PAINT_GUARD  64     // Left unpainted below the painting frame
+
+//==============================================================================
+// MEASUREMENT
+//==============================================================================
+
+// Call first in setup(): paints the free gap
+void setupStackMonitor();
+
+// Around each console command; name must outlive the program (a literal)
+void stackBeginCommand();
+void stackEndCommand(const char* name);
+
+//==============================================================================
+// RESULTS
+//==============================================================================
+
+// Deepest stack use since boot, in bytes below the stack top
+uint16_t stackPeak();
+
+// Smallest gap seen between the heap end and the deepest stack use
+uint16_t stackMinFree();
+
+uint8_t stackCommandCount();
+
+// Peak recorded while the command ran, measured from the stack top
+const char* stackCommandName(uint8_t index);
+uint16_t stackCommandPeak(uint8_t index);
+
+#endif // STACK_MONITOR_H
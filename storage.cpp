@@ -11,6 +11,8 @@
 
 #include "config.h"
 #include "storage.h"
+#include "config-hash.h"
+#include "scheduler.h"
 #include <EEPROM.h>
 
 //==============================================================================
@@ -19,6 +21,9 @@
 
 SwitchMacros macros[NUM_SWITCHES];
 
+// Running configuration hash of macros[] (see config-hash.h)
+static uint64_t keyMacroHash = 0;
+
 // Free a macro string if it exists
 void freeMacroString(char*& macroPtr) {
   if (macroPtr) {
@@ -27,18 +32,22 @@ void freeMacroString(char*& macroPtr) {
   }
 }
 
+uint16_t storageEnd() {
+  return journalRegionFree() ? JOURNAL_EEPROM_START : EEPROM.length();
+}
+
 // Read a null-terminated string from EEPROM, returns new offset
 // Caller must free the returned string
-uint16_t readStringFromEEPROM(uint16_t offset, char** str) {
+uint16_t readStringFromEEPROM(uint16_t offset, char** str, uint16_t end) {
   *str = nullptr;
   
   // Find string length
   uint16_t start = offset;
-  while (offset < EEPROM.length() && EEPROM.read(offset) != 0) {
+  while (offset < end && EEPROM.read(offset) != 0) {
     offset++;
   }
   
-  if (offset >= EEPROM.length()) return 0;  // No null terminator found
+  if (offset >= end) return 0;  // No null terminator found
   
   size_t len = offset - start;
   offset++;  // Skip null terminator
@@ -60,13 +69,13 @@ uint16_t readStringFromEEPROM(uint16_t offset, char** str) {
   return offset;
 }
 
-// Write a \0 terminated string to EEPROM at offset
+// Write a \0 terminated string to EEPROM at offset, skipping unchanged bytes
 // Returns new offset after the string
-uint16_t writeStringToEEPROM(uint16_t offset, const char* str) {
+uint16_t writeStringToEEPROM(uint16_t offset, const char* str, uint16_t end) {
   if (!str || strlen(str) == 0) {
     // Write empty string (just null terminator) for both null and empty strings
-    if (offset < EEPROM.length()) {
-      EEPROM.write(offset++, 0);
+    if (offset < end) {
+      EEPROM.update(offset++, 0);
     }
     return offset;
   }
@@ -74,8 +83,8 @@ uint16_t writeStringToEEPROM(uint16_t offset, const char* str) {
   // Write string including null terminator
   size_t len = strlen(str);
   for (size_t i = 0; i <= len; i++) { // Include null terminator
-    if (offset >= EEPROM.length()) break;
-    EEPROM.write(offset++, str[i]);
+    if (offset >= end) break;
+    EEPROM.update(offset++, str[i]);
   }
   
   return offset;
@@ -87,6 +96,33 @@ void setupStorage() {
     macros[i].downMacro = nullptr;
     macros[i].upMacro = nullptr;
   }
+  keyMacroHash = 0;
+}
+
+uint16_t installConfigImage(const uint8_t* image, uint16_t size) {
+  if (!image || size > JOURNAL_EEPROM_START) return 0;
+  
+  claimJournalRegion();
+  for (uint16_t i = 0; i < size; i++) {
+    EEPROM.update(i, pgm_read_byte(image + i));
+  }
+  return size;
+}
+
+void setSwitchMacro(int switchNum, bool up, char* macro) {
+  if (switchNum < 0 || switchNum >= NUM_SWITCHES) return;
+  
+  char*& target = up ? macros[switchNum].upMacro : macros[switchNum].downMacro;
+  uint8_t kind = up ? CONFIG_HASH_KEY_UP : CONFIG_HASH_KEY_DOWN;
+  
+  keyMacroHash -= configHashEntry(kind, switchNum, target);
+  freeMacroString(target);
+  target = macro;
+  keyMacroHash += configHashEntry(kind, switchNum, target);
+}
+
+uint64_t getKeyMacroHash() {
+  return keyMacroHash;
 }
 
 uint16_t loadFromStorage() {
@@ -104,42 +140,56 @@ uint16_t loadFromStorage() {
     freeMacroString(macros[i].downMacro);
     freeMacroString(macros[i].upMacro);
   }
+  keyMacroHash = 0;
   
   // Read NUM_SWITCHES pairs of \0 terminated strings
   uint16_t offset = EEPROM_DATA_START;
+  uint16_t end = storageEnd();
   char *macro;
   
   for (int i = 0; i < NUM_SWITCHES; i++) {
     // Read down macro
-    offset = readStringFromEEPROM(offset, &macro);
+    offset = readStringFromEEPROM(offset, &macro, end);
     if (offset == 0) return 0; // Read error
     macros[i].downMacro = macro; // Will be nullptr for empty strings
     
     // Read up macro  
-    offset = readStringFromEEPROM(offset, &macro);
+    offset = readStringFromEEPROM(offset, &macro, end);
     if (offset == 0) return 0; // Read error
     macros[i].upMacro = macro; // Will be nullptr for empty strings
+    
+    keyMacroHash += configHashEntry(CONFIG_HASH_KEY_DOWN, i, macros[i].downMacro);
+    keyMacroHash += configHashEntry(CONFIG_HASH_KEY_UP, i, macros[i].upMacro);
   }
   
   return offset;
 }
 
+// Each changed byte can take milliseconds, so the input task gets a turn after
+// every macro written. It only reads macros[], and SAVE runs from the
+// serial task, so no command can change them while it waits.
 uint16_t saveToStorage() {
+  // From here on the configuration stays below the journal region
+  claimJournalRegion();
+
   // Write magic number
   uint32_t magic = EEPROM_MAGIC_VALUE;
   EEPROM.put(EEPROM_MAGIC_ADDR, magic);
   
   // Write NUM_SWITCHES pairs of \0 terminated strings
   uint16_t offset = EEPROM_DATA_START;
+  uint16_t end = storageEnd();
   
   for (int i = 0; i < NUM_SWITCHES; i++) {
     // Write down macro (empty string if nullptr)
-    offset = writeStringToEEPROM(offset, macros[i].downMacro);
-    if (offset >= EEPROM.length()) return 0; // Out of space
+    offset = writeStringToEEPROM(offset, macros[i].downMacro, end);
+    if (offset >= end) return 0; // Out of space
+    schedulerYield();
     
     // Write up macro (empty string if nullptr)
-    offset = writeStringToEEPROM(offset, macros[i].upMacro);  
-    if (offset >= EEPROM.length()) return 0; // Out of space
+    offset = writeStringToEEPROM(offset, macros[i].upMacro, end);  
+    if (offset >= end) return 0; // Out of space
+    schedulerYield();
   }
   
   return offset;
@@ -10,6 +10,7 @@
 #include <Arduino.h>
 
 #include "config.h"
+#include "journal.h"
 
 //==============================================================================
 // CONFIGURATION
@@ -19,6 +20,7 @@
 #define EEPROM_MAGIC_ADDR 0
 #define EEPROM_DATA_START 4
 
+
 //==============================================================================
 // SWITCH DATA STRUCTURE
 //==============================================================================
@@ -47,12 +49,28 @@ uint16_t loadFromStorage();
 // Save the switch macro pairs from macros[] array to EEPROM  
 uint16_t saveToStorage();
 
-// Write a null-terminated string to EEPROM at offset
+// Copy a storage image (e.g. generated by tools/kpconfig) from PROGMEM
+// into EEPROM, writing only bytes that differ. Returns bytes installed.
+uint16_t installConfigImage(const uint8_t* image, uint16_t size);
+
+// Replace a switch macro, freeing the previous one (nullptr clears)
+// Takes ownership of macro and keeps the configuration hash up to date
+void setSwitchMacro(int switchNum, bool up, char* macro);
+
+// Sum of configuration hash entries for all switch macros
+uint64_t getKeyMacroHash();
+
+// End of the configuration: where the event journal's EEPROM region begins,
+// or the end of EEPROM for one saved before the journal took the region.
+// Reads EEPROM, so SAVE / LOAD take it once and pass it down as end
+uint16_t storageEnd();
+
+// Write a null-terminated string to EEPROM at offset, stopping at end
 // Returns new offset after the string
-uint16_t writeStringToEEPROM(uint16_t offset, const char* str);
+uint16_t writeStringToEEPROM(uint16_t offset, const char* str, uint16_t end);
 
 // Read a null-terminated string from EEPROM, returns new offset
-// Caller must free the returned string
-uint16_t readStringFromEEPROM(uint16_t offset, char** str);
+// (0 if no terminator before end). Caller must free the returned string
+uint16_t readStringFromEEPROM(uint16_t offset, char** str, uint16_t end);
 
 #endif // STORAGE_H
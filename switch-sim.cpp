@@ -0,0 +1,267 @@
+/*
+ * Switch Input Simulation Implementation
+ *
+ * At most one step is injected per loop() pass, so every programmed state
+ * change is seen by the chord engine even when steps are closer together
+ * than a loop pass; the resulting lateness is reported as injection lag.
+ */
+
+#include "switch-sim.h"
+#include "macro-engine.h"
+#include "chording.h"
+
+//==============================================================================
+// TIMELINE STATE
+//==============================================================================
+
+struct SimStep {
+  uint32_t offsetUs;
+  uint32_t mask;
+};
+
+struct SimStepStats {
+  uint32_t latencySumUs;
+  uint16_t latencyMinUs;
+  uint16_t latencyMaxUs;          // Saturates at 65535
+  uint16_t outputs;               // Runs in which this step produced HID output
+};
+
+static SimStep steps[SIM_MAX_STEPS];
+static SimStepStats stats[SIM_MAX_STEPS];
+static uint8_t stepCount = 0;
+
+//==============================================================================
+// RUN STATE
+//==============================================================================
+
+static bool running = false;
+static uint16_t runsWanted = 0;
+static uint16_t runsDone = 0;
+static uint8_t nextStep = 0;
+static uint32_t simMask = 0;
+static uint32_t runStartUs = 0;         // Current repetition
+static uint32_t firstStartUs = 0;       // Whole run, for the report
+static uint32_t lastEndUs = 0;
+static uint32_t loopPasses = 0;
+static uint32_t maxLagUs = 0;
+
+static int8_t awaitingStep = -1;        // Step whose first output is pending
+static uint32_t injectedAtUs = 0;
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static void noteOutput() {
+  if (awaitingStep < 0) return;
+
+  uint32_t latency = micros() - injectedAtUs;
+  if (latency > 0xFFFF) latency = 0xFFFF;
+
+  SimStepStats& s = stats[awaitingStep];
+  if (s.outputs == 0 || latency < s.latencyMinUs) s.latencyMinUs = latency;
+  if (latency > s.latencyMaxUs) s.latencyMaxUs = latency;
+  s.latencySumUs += latency;
+  s.outputs++;
+  awaitingStep = -1;
+}
+
+static void finishRun(uint32_t now) {
+  running = false;
+  simMask = 0;
+  awaitingStep = -1;
+  lastEndUs = now;
+  macroOutputHook = nullptr;
+  simPrintReport();
+}
+
+static void printMask(uint32_t mask) {
+  if (mask == 0) {
+    Serial.print(F("none"));
+  } else {
+    Serial.print(formatKeyMask(mask));
+  }
+}
+
+//==============================================================================
+// TIMELINE
+//==============================================================================
+
+bool simAddStep(uint32_t offsetUs, uint32_t mask) {
+  if (running || stepCount >= SIM_MAX_STEPS) return false;
+  if (stepCount > 0 && offsetUs < steps[stepCount - 1].offsetUs) return false;
+
+  steps[stepCount].offsetUs = offsetUs;
+  steps[stepCount].mask = mask;
+  stepCount++;
+  return true;
+}
+
+bool simAddRoll(const uint8_t* keys, uint8_t count, uint32_t gapUs, uint32_t holdUs) {
+  if (running || count == 0 || stepCount + 2 * count > SIM_MAX_STEPS) return false;
+  if (holdUs < gapUs) holdUs = gapUs;
+
+  uint32_t offset = stepCount > 0 ? steps[stepCount - 1].offsetUs + gapUs : 0;
+  uint32_t mask = stepCount > 0 ? steps[stepCount - 1].mask : 0;
+
+  for (uint8_t i = 0; i < count; i++) {
+    mask |= (1UL << keys[i]);
+    simAddStep(offset, mask);
+    offset += gapUs;
+  }
+  offset += holdUs - gapUs;
+  for (uint8_t i = 0; i < count; i++) {
+    mask &= ~(1UL << keys[i]);
+    simAddStep(offset, mask);
+    offset += gapUs;
+  }
+  return true;
+}
+
+void simClear() {
+  simStop();
+  stepCount = 0;
+}
+
+uint8_t simStepCount() {
+  return stepCount;
+}
+
+//==============================================================================
+// RUNNING
+//==============================================================================
+
+bool simStart(uint16_t repeat) {
+  if (stepCount == 0 || repeat == 0) return false;
+
+  memset(stats, 0, sizeof(stats));
+  runsWanted = repeat;
+  runsDone = 0;
+  nextStep = 0;
+  simMask = 0;
+  loopPasses = 0;
+  maxLagUs = 0;
+  awaitingStep = -1;
+  firstStartUs = runStartUs = micros();
+  macroOutputHook = noteOutput;
+  running = true;
+  return true;
+}
+
+void simStop() {
+  if (!running) return;
+  running = false;
+  simMask = 0;
+  awaitingStep = -1;
+  lastEndUs = micros();
+  macroOutputHook = nullptr;
+}
+
+bool simIsRunning() {
+  return running;
+}
+
+uint32_t simSwitches(uint32_t hardwareState) {
+  if (!running) return hardwareState;
+
+  uint32_t now = micros();
+  uint32_t elapsed = now - runStartUs;
+  loopPasses++;
+
+  if (nextStep < stepCount) {
+    const SimStep& step = steps[nextStep];
+    if (elapsed >= step.offsetUs) {
+      uint32_t lag = elapsed - step.offsetUs;
+      if (lag > maxLagUs) maxLagUs = lag;
+
+      simMask = step.mask;
+      awaitingStep = nextStep;
+      injectedAtUs = now;
+      nextStep++;
+    }
+  } else if (elapsed >= steps[stepCount - 1].offsetUs + SIM_REPEAT_GAP_US) {
+    runsDone++;
+    if (runsDone >= runsWanted) {
+      finishRun(now);
+      return hardwareState;
+    }
+    // Next repetition starts from all keys released
+    runStartUs = now;
+    nextStep = 0;
+    simMask = 0;
+    awaitingStep = -1;
+  }
+
+  return simMask;
+}
+
+uint32_t simPeek(uint32_t hardwareState) {
+  return running ? simMask : hardwareState;
+}
+
+//==============================================================================
+// REPORTING
+//==============================================================================
+
+void simPrintSteps() {
+  if (stepCount == 0) {
+    Serial.println(F("No SIM steps"));
+    return;
+  }
+  for (uint8_t i = 0; i < stepCount; i++) {
+    Serial.print(F("  #"));
+    Serial.print(i);
+    Serial.print(F(" +"));
+    Serial.print(steps[i].offsetUs);
+    Serial.print(F("us "));
+    printMask(steps[i].mask);
+    Serial.println();
+  }
+}
+
+void simPrintReport() {
+  if (running) {
+    Serial.print(F("SIM running: run "));
+    Serial.print(runsDone + 1);
+    Serial.print(F(" of "));
+    Serial.println(runsWanted);
+    return;
+  }
+  if (runsDone == 0) {
+    Serial.println(F("No completed SIM run"));
+    return;
+  }
+
+  uint32_t totalUs = lastEndUs - firstStartUs;
+  Serial.print(F("SIM complete: "));
+  Serial.print(runsDone);
+  Serial.print(F(" runs, "));
+  Serial.print(totalUs);
+  Serial.print(F("us, "));
+  Serial.print(loopPasses);
+  Serial.print(F(" loop passes ("));
+  Serial.print(totalUs > 0 ? (uint32_t)((uint64_t)loopPasses * 1000000UL / totalUs) : 0);
+  Serial.print(F("/s), max injection lag "));
+  Serial.print(maxLagUs);
+  Serial.println(F("us"));
+
+  for (uint8_t i = 0; i < stepCount; i++) {
+    Serial.print(F("  #"));
+    Serial.print(i);
+    Serial.print(F(" "));
+    printMask(steps[i].mask);
+    Serial.print(F(": "));
+    if (stats[i].outputs == 0) {
+      Serial.println(F("no output"));
+      continue;
+    }
+    Serial.print(stats[i].outputs);
+    Serial.print(F(" outputs, latency min "));
+    Serial.print(stats[i].latencyMinUs);
+    Serial.print(F(" avg "));
+    Serial.print(stats[i].latencySumUs / stats[i].outputs);
+    Serial.print(F(" max "));
+    Serial.print(stats[i].latencyMaxUs);
+    Serial.println(F("us"));
+  }
+}
@@ -0,0 +1,66 @@
+/*
+ * Switch Input Simulation Interface
+ *
+ * Replays a programmed timeline of switch masks (µs offsets) through the
+ * same path loop() reads the hardware, and measures the latency from each
+ * injected state change to the first HID output it causes. Driven by
+ * loop() passes, so timing includes the real chord engine and executor.
+ */
+
+#ifndef SWITCH_SIM_H
+#define SWITCH_SIM_H
+
+#include <Arduino.h>
+#include "config.h"
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+
+#ifndef SIM_MAX_STEPS
+#define SIM_MAX_STEPS 16
+#endif
+
+// Idle time after the last step before a repeated run starts again -
+// longer than the chord execution window so every run starts from idle
+#define SIM_REPEAT_GAP_US 100000UL
+
+//==============================================================================
+// TIMELINE
+//==============================================================================
+
+// Append a step at offsetUs from the start of the run (non-decreasing)
+bool simAddStep(uint32_t offsetUs, uint32_t mask);
+
+// Append a roll after the last step: keys pressed one at a time gapUs
+// apart, held holdUs, then released one at a time in the same order
+bool simAddRoll(const uint8_t* keys, uint8_t count, uint32_t gapUs, uint32_t holdUs);
+
+void simClear();
+uint8_t simStepCount();
+
+//==============================================================================
+// RUNNING
+//==============================================================================
+
+// Start replaying the timeline repeat times; false if it is empty
+bool simStart(uint16_t repeat);
+void simStop();
+bool simIsRunning();
+
+// loop() hook - returns the simulated switch state while a run is active,
+// otherwise hardwareState unchanged
+uint32_t simSwitches(uint32_t hardwareState);
+
+// The state simSwitches() last returned, without stepping the timeline -
+// for reads outside the input task (macro polling)
+uint32_t simPeek(uint32_t hardwareState);
+
+//==============================================================================
+// REPORTING
+//==============================================================================
+
+void simPrintSteps();
+void simPrintReport();
+
+#endif // SWITCH_SIM_H
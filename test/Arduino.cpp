@@ -6,6 +6,7 @@
 #include "Arduino.h"
 #include "Serial.cpp"
 #include "Keyboard.cpp"
+#include "Mouse.cpp"
 #include "EEPROM.cpp"
 
 //==============================================================================
@@ -21,4 +22,5 @@ int* __brkval = nullptr;   // Simulated current break (no allocation initially)
 //==============================================================================
 
 uint32_t TestTimeControl::currentTime = 0;
+uint32_t TestTimeControl::currentMicros = 0;
 bool TestTimeControl::useControlledTime = false;
\ No newline at end of file
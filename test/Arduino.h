@@ -23,6 +23,7 @@ typedef const char* __FlashStringHelper;
 #define F(string_literal) (string_literal)
 #define PROGMEM
 #define PGM_P const char*
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
 
 // Arduino constants (must be defined before String class)
 #define HEX 16
@@ -35,12 +36,14 @@ typedef const char* __FlashStringHelper;
 class TestTimeControl {
 private:
     static uint32_t currentTime;     // Declaration only
+    static uint32_t currentMicros;   // Microseconds within currentTime (0-999)
     static bool useControlledTime;   // Declaration only
     
 public:
     // Set absolute time value
     static void setTime(uint32_t time) {
         currentTime = time;
+        currentMicros = 0;
         useControlledTime = true;
     }
     
@@ -50,6 +53,14 @@ public:
         useControlledTime = true;
     }
     
+    // Advance time by delta microseconds
+    static void advanceMicros(uint32_t deltaUs) {
+        uint32_t total = currentMicros + deltaUs;
+        currentTime += total / 1000;
+        currentMicros = total % 1000;
+        useControlledTime = true;
+    }
+    
     // Get current controlled time
     static uint32_t getTime() {
         return currentTime;
@@ -78,6 +89,18 @@ public:
             return static_cast<uint32_t>(duration.count());
         }
     }
+    
+    // Internal function called by micros()
+    static uint32_t getCurrentMicros() {
+        if (useControlledTime) {
+            return currentTime * 1000 + currentMicros;
+        } else {
+            static auto start_time = std::chrono::steady_clock::now();
+            auto now = std::chrono::steady_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - start_time);
+            return static_cast<uint32_t>(duration.count());
+        }
+    }
 };
 
 // Static member declarations (defined in Arduino.cpp)
@@ -88,6 +111,11 @@ inline uint32_t millis() {
     return TestTimeControl::getCurrentTime();
 }
 
+// Controllable micros() function
+inline uint32_t micros() {
+    return TestTimeControl::getCurrentMicros();
+}
+
 extern int __heap_start;
 extern int* __brkval;
 
@@ -128,6 +156,10 @@ inline void* memcpy_P(void* dest, const void* src, size_t n) {
     return memcpy(dest, src, n);
 }
 
+inline size_t strlen_P(const char* s) {
+    return strlen(s);
+}
+
 inline int strcasecmp(const char* s1, const char* s2) {
     while (*s1 && *s2) {
         char c1 = tolower(*s1);
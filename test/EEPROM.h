@@ -15,7 +15,9 @@
 // EEPROM MOCK CONFIGURATION
 //==============================================================================
 
+#ifndef EEPROM_SIZE
 #define EEPROM_SIZE 1024  // Simulate 1KB EEPROM (Teensy 2.0 has 512 bytes, but we'll use more for testing)
+#endif
 
 //==============================================================================
 // EEPROM MOCK CLASS
@@ -0,0 +1,42 @@
+/*
+ * Mouse.cpp Mock Implementation
+ * Global instance for the Mouse mock
+ */
+
+#include "Arduino.h"
+#include "Mouse.h"
+
+// Global Mouse instance
+MockMouse Mouse;
+
+void MockMouse::record(int8_t x, int8_t y, int8_t wheel) {
+    reports.push_back({ micros(), x, y, wheel, buttons });
+}
+
+std::string MockMouse::toString() const {
+    std::string result;
+    uint8_t lastButtons = 0;
+    for (size_t i = 0; i < reports.size(); i++) {
+        const Report& report = reports[i];
+        std::string text;
+        if (report.buttons != lastButtons) {
+            text = "buttons";
+            if (report.buttons == 0) text += " none";
+            if (report.buttons & MOUSE_LEFT) text += " left";
+            if (report.buttons & MOUSE_RIGHT) text += " right";
+            if (report.buttons & MOUSE_MIDDLE) text += " middle";
+            lastButtons = report.buttons;
+        }
+        if (report.x || report.y) {
+            if (!text.empty()) text += " ";
+            text += "move " + std::to_string(report.x) + "," + std::to_string(report.y);
+        }
+        if (report.wheel) {
+            if (!text.empty()) text += " ";
+            text += "scroll " + std::to_string(report.wheel);
+        }
+        if (i > 0) result += "; ";
+        result += text.empty() ? "empty" : text;
+    }
+    return result;
+}
@@ -0,0 +1,76 @@
+/*
+ * Mouse.h Mock for Testing
+ * Records each HID mouse report with its micros() timestamp, so tests can
+ * check report contents and cadence
+ */
+
+#ifndef MOUSE_H
+#define MOUSE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#define MOUSE_LEFT   1
+#define MOUSE_RIGHT  2
+#define MOUSE_MIDDLE 4
+#define MOUSE_ALL    (MOUSE_LEFT | MOUSE_RIGHT | MOUSE_MIDDLE)
+
+//==============================================================================
+// MOCK MOUSE CLASS
+//==============================================================================
+
+class MockMouse {
+public:
+    struct Report {
+        uint32_t timeUs;
+        int8_t x;
+        int8_t y;
+        int8_t wheel;
+        uint8_t buttons;
+    };
+
+    void begin() { /* no-op for testing */ }
+
+    void move(signed char x, signed char y, signed char wheel = 0) {
+        record(x, y, wheel);
+    }
+
+    void press(uint8_t b = MOUSE_LEFT) {
+        buttons |= b;
+        record(0, 0, 0);
+    }
+
+    void release(uint8_t b = MOUSE_LEFT) {
+        buttons &= ~b;
+        record(0, 0, 0);
+    }
+
+    // Arduino Mouse library: press b alone, then release
+    void click(uint8_t b = MOUSE_LEFT) {
+        buttons = b;
+        record(0, 0, 0);
+        buttons = 0;
+        record(0, 0, 0);
+    }
+
+    bool isPressed(uint8_t b = MOUSE_LEFT) const { return (buttons & b) != 0; }
+
+    const std::vector<Report>& getReports() const { return reports; }
+    void clearReports() { reports.clear(); }
+
+    // "move 5,-3", "scroll 1", "buttons left", "buttons none"; reports
+    // separated by "; "
+    std::string toString() const;
+
+private:
+    std::vector<Report> reports;
+    uint8_t buttons = 0;
+
+    void record(int8_t x, int8_t y, int8_t wheel);
+};
+
+// Global instance for Arduino compatibility
+extern MockMouse Mouse;
+
+#endif // MOUSE_H
@@ -39,6 +39,11 @@ public:
         clear();
     }
     
+    // Host port is always connected (setup() waits on !Serial)
+    explicit operator bool() const {
+        return true;
+    }
+    
     bool available() {
         return inputPosition < inputBuffer.length();
     }
@@ -66,6 +71,14 @@ public:
         currentLine += std::to_string(value);
     }
     
+    void print(unsigned int value) {
+        currentLine += std::to_string(value);
+    }
+    
+    void print(unsigned long value) {
+        currentLine += std::to_string(value);
+    }
+    
     void print(int value, int base) {
         if (base == 16) {
             std::stringstream ss;
@@ -76,6 +89,20 @@ public:
         }
     }
     
+    void print(unsigned int value, int base) {
+        print((unsigned long)value, base);
+    }
+    
+    void print(unsigned long value, int base) {
+        if (base == 16) {
+            std::stringstream ss;
+            ss << std::hex << std::uppercase << value;
+            currentLine += ss.str();
+        } else {
+            currentLine += std::to_string(value);
+        }
+    }
+    
     void println() {
         outputLines.push_back(currentLine);
         currentLine.clear();
@@ -101,11 +128,32 @@ public:
         println();
     }
     
+    void println(unsigned int value) {
+        print(value);
+        println();
+    }
+    
+    void println(unsigned long value) {
+        print(value);
+        println();
+    }
+    
     void println(int value, int base) {
         print(value, base);
         println();
     }
     
+    // Raw bytes (binary frames) go into the output as they are
+    size_t write(uint8_t b) {
+        currentLine += (char)b;
+        return 1;
+    }
+    
+    size_t write(const uint8_t* buffer, size_t size) {
+        currentLine.append((const char*)buffer, size);
+        return size;
+    }
+    
     // Support for F() macro strings (treat as regular strings in test)
     void print(const __FlashStringHelper* str) {
         print((const char*)str);
@@ -154,6 +202,20 @@ public:
         return result;
     }
     
+    // Output as a byte stream since the last call (lines end in '\n'),
+    // leaving pending input alone - used by host tools that talk to the mock
+    std::string takeOutput() {
+        std::string result;
+        for (const auto& line : outputLines) {
+            result += line;
+            result += "\n";
+        }
+        result += currentLine;
+        outputLines.clear();
+        currentLine.clear();
+        return result;
+    }
+
     std::string getLastLine() const {
         if (!currentLine.empty()) {
             return currentLine;
@@ -0,0 +1,762 @@
+/*
+ * Parser Fuzzing Harness
+ *
+ * Fuzz targets for everything that parses serial input: macroEncode,
+ * macroDecode, parseKeyList, parseChordKeys, parseSwitchAndDirection and
+ * processCommand.
+ * Each target checks its own correctness properties, and every run is
+ * measured in instructions (CPU ns where perf counters are unavailable)
+ * and peak heap bytes, so slow inputs are caught as well as wrong ones.
+ *
+ * Standalone driver (make fuzz-parsers):
+ *   fuzz-parsers run <file|dir>...            Check inputs, print their cost
+ *   fuzz-parsers scale <file|dir>...          Report super-linear cost growth
+ *   fuzz-parsers fuzz <target> [-n N] [-s SEED]
+ *                                             Cost-guided mutation from the
+ *                                             corpus; the minimized worst input
+ *                                             goes to fuzz-worst/<target>/
+ *
+ * Inputs live in fuzz-corpus/<target>/ and fuzz-worst/<target>/ - the
+ * directory name selects the target.
+ *
+ * libFuzzer build (make fuzz-libfuzzer, clang): coverage-guided, target
+ * chosen by FUZZ_TARGET=<name> or otherwise by the first input byte.
+ */
+
+#include "Arduino.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../macro-encode.h"
+#include "../macro-decode.h"
+#include "../storage.h"
+#include "../chording.h"
+#include "../config-hash.h"
+#include "../builtin-profile.h"
+#include "../switch-sim.h"
+#include "../serial-interface.h"
+#include "../commands/cmd-parsing.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+
+#ifdef FUZZ_LIBFUZZER
+#include <sanitizer/allocator_interface.h>
+#else
+#include <malloc.h>
+#endif
+
+// CONFIG HASH as reported by the device (cmd-config.cpp)
+uint64_t getConfigHash();
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+#define SUPERLINEAR_EXPONENT 1.25   // Cost growth flagged above len^1.25
+#define MIN_WORST_LENGTH       32   // Shortest input kept as a worst case
+#define HOST_SCALE_LIMIT     4096   // Longest input built when measuring growth
+
+//==============================================================================
+// COST MEASUREMENT
+//==============================================================================
+
+struct FuzzCost {
+    uint64_t work = 0;              // Instructions, or CPU ns without perf
+    uint64_t peakBytes = 0;         // Heap high-water mark above the start
+    uint64_t allocations = 0;
+};
+
+static int perfFd = -1;
+static bool perfTried = false;
+
+static bool openInstructionCounter() {
+    if (perfTried) return perfFd >= 0;
+    perfTried = true;
+
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perfFd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    return perfFd >= 0;
+}
+
+static const char* workUnit() {
+    return openInstructionCounter() ? "instructions" : "ns";
+}
+
+static uint64_t readWork() {
+    if (openInstructionCounter()) {
+        uint64_t count = 0;
+        if (read(perfFd, &count, sizeof(count)) == sizeof(count)) return count;
+    }
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+// Heap accounting - malloc / free are wrapped in the standalone build and
+// observed through sanitizer hooks under libFuzzer
+static bool tracking = false;
+static int64_t liveBytes = 0;
+static int64_t peakLiveBytes = 0;
+static uint64_t allocationCount = 0;
+
+static void noteAlloc(size_t size) {
+    if (!tracking) return;
+    allocationCount++;
+    liveBytes += size;
+    if (liveBytes > peakLiveBytes) peakLiveBytes = liveBytes;
+}
+
+static void noteFree(size_t size) {
+    if (tracking) liveBytes -= size;
+}
+
+#ifdef FUZZ_LIBFUZZER
+static void sanitizerMallocHook(const volatile void* ptr, size_t size) {
+    noteAlloc(size);
+}
+
+static void sanitizerFreeHook(const volatile void* ptr) {
+    noteFree(__sanitizer_get_allocated_size((const void*)ptr));
+}
+#else
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    if (ptr) noteAlloc(malloc_usable_size(ptr));
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    if (ptr) noteAlloc(malloc_usable_size(ptr));
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    size_t before = ptr ? malloc_usable_size(ptr) : 0;
+    void* moved = __libc_realloc(ptr, size);
+    if (moved) {
+        noteFree(before);
+        noteAlloc(malloc_usable_size(moved));
+    }
+    return moved;
+}
+
+void free(void* ptr) {
+    if (ptr) noteFree(malloc_usable_size(ptr));
+    __libc_free(ptr);
+}
+}
+#endif
+
+//==============================================================================
+// FUZZ TARGETS
+//==============================================================================
+
+typedef bool (*FuzzCheck)(const std::string& input, std::string& failure);
+
+static std::string cString(const std::string& input) {
+    return input.substr(0, strnlen(input.c_str(), input.size()));
+}
+
+// Every operand byte is present and in range. \xHH escapes can place
+// opcode bytes in a sequence without one; the decoder cannot name those
+static bool wellFormed(const std::string& bytes) {
+    for (size_t i = 0; i < bytes.size(); i++) {
+        uint8_t b = bytes[i];
+        if (b == UTF8_FUNCTION_KEY || b == UTF8_PRESS_MULTI || b == UTF8_RELEASE_MULTI) {
+            if (++i >= bytes.size()) return false;
+            uint8_t operand = bytes[i];
+            if (b == UTF8_FUNCTION_KEY ? (operand < 1 || operand > 12)
+                                       : (operand == 0 || operand > 0x0F)) {
+                return false;
+            }
+        } else if (b == UTF8_MOUSE_MOVE || b == UTF8_MOUSE_SCROLL) {
+            // Any non-zero operand is an offset; a move has two
+            i += (b == UTF8_MOUSE_MOVE) ? 2 : 1;
+            if (i >= bytes.size() || bytes[i] == 0 || bytes[i - 1] == 0) return false;
+        } else if (b == UTF8_MOUSE_BUTTON) {
+            if (++i >= bytes.size() || !isMouseButtonOperand(bytes[i])) return false;
+        }
+    }
+    return true;
+}
+
+// Encoded bytes are bounded, error and result are exclusive, and decoding
+// then re-encoding a well-formed result reproduces the same bytes
+static bool checkEncode(const std::string& input, std::string& failure) {
+    MacroEncodeResult parsed = macroEncode(cString(input).c_str());
+    if (parsed.error) {
+        if (parsed.utf8Sequence) {
+            failure = "error returned together with a sequence";
+            free(parsed.utf8Sequence);
+            return false;
+        }
+        return true;
+    }
+    if (!parsed.utf8Sequence) {
+        failure = "no sequence and no error";
+        return false;
+    }
+    std::string bytes = parsed.utf8Sequence;
+    free(parsed.utf8Sequence);
+    if (bytes.size() > MAX_MACRO_LENGTH) {
+        failure = "sequence longer than MAX_MACRO_LENGTH";
+        return false;
+    }
+    if (bytes.empty() || !wellFormed(bytes)) return true;
+
+    String text = macroDecode((const uint8_t*)bytes.data(), bytes.size());
+    MacroEncodeResult again = macroEncode(text.c_str());
+    bool same = !again.error && bytes == again.utf8Sequence;
+    free(again.utf8Sequence);
+    if (!same) {
+        failure = "decode/encode round trip changed the bytes: " + std::string(text.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Any byte string decodes, to output of bounded size
+static bool checkDecode(const std::string& input, std::string& failure) {
+    uint16_t length = input.size() > 0xFFFF ? 0xFFFF : input.size();
+    String text = macroDecode((const uint8_t*)input.data(), length);
+    if (text.length() > 16UL * length + 2) {
+        failure = "decoded text out of proportion to the input";
+        return false;
+    }
+    return true;
+}
+
+// Only real key numbers set bits; digit-only lists match a direct parse
+static bool checkKeyList(const std::string& input, std::string& failure) {
+    std::string text = cString(input);
+    uint32_t mask = parseKeyList(text.c_str());
+    if (mask & ~((1UL << NUM_SWITCHES) - 1)) {
+        failure = "mask has bits beyond NUM_SWITCHES";
+        return false;
+    }
+    // Ordered chord lists keep their lead key and format back to themselves
+    uint32_t chord = parseChordKeys(text.c_str());
+    if (chord & CHORD_ORDER_KEY_MASK) {
+        uint8_t lead = ((chord & CHORD_ORDER_KEY_MASK) >> CHORD_ORDER_SHIFT) - 1;
+        if (!(chord & (1UL << lead)) || parseChordKeys(formatKeyMask(chord).c_str()) != chord) {
+            failure = "ordered chord key list does not round-trip";
+            return false;
+        }
+    }
+    if (text.find_first_not_of("0123456789 ,+") != std::string::npos) return true;
+
+    uint32_t expected = 0;
+    for (size_t i = 0; i < text.size(); ) {
+        if (!isdigit((unsigned char)text[i])) { i++; continue; }
+        unsigned long key = 0;
+        while (i < text.size() && isdigit((unsigned char)text[i])) {
+            if (key < 1000) key = key * 10 + (text[i] - '0');
+            i++;
+        }
+        if (key < NUM_SWITCHES) expected |= 1UL << key;
+    }
+    if (mask != expected) {
+        failure = "mask differs from the listed keys";
+        return false;
+    }
+    return true;
+}
+
+// Results stay in range and the remaining arguments lie inside the input
+static bool checkSwitchDirection(const std::string& input, std::string& failure) {
+    std::string text = cString(input);
+    int switchNum = -1;
+    int direction = -2;
+    const char* rest = nullptr;
+    if (!parseSwitchAndDirection(text.c_str(), &switchNum, &direction, &rest)) return true;
+
+    if (switchNum < 0 || switchNum >= NUM_SWITCHES) {
+        failure = "switch number out of range";
+        return false;
+    }
+    if (direction != DIRECTION_UNK && direction != DIRECTION_DOWN && direction != DIRECTION_UP) {
+        failure = "invalid direction";
+        return false;
+    }
+    if (!rest || rest < text.c_str() || rest > text.c_str() + text.size() || isspace(*rest)) {
+        failure = "remaining arguments outside the input or not trimmed";
+        return false;
+    }
+    return true;
+}
+
+static uint64_t chordHashSum;
+
+static void sumChordHash(uint32_t keyMask, const char* macro) {
+    chordHashSum += configHashEntry(CONFIG_HASH_CHORD, keyMask, macro);
+}
+
+static void resetDevice() {
+    for (int i = 0; i < NUM_SWITCHES; i++) {
+        setSwitchMacro(i, false, nullptr);
+        setSwitchMacro(i, true, nullptr);
+    }
+    chording.clearAllChords();
+    chording.clearAllModifiers();
+    simClear();
+    EEPROM.clear();
+    Serial.clear();
+    Keyboard.clearActions();
+}
+
+// A console line as readLine() would deliver it: printable ASCII, 127 chars.
+// BENCH is skipped - it deliberately runs for a fixed time.
+static bool checkCommand(const std::string& input, std::string& failure) {
+    std::string line;
+    for (char c : input) {
+        if (c >= 32 && c <= 126 && line.size() < 127) line += c;
+    }
+    size_t start = line.find_first_not_of(' ');
+    if (start != std::string::npos && strncasecmp(line.c_str() + start, "BENCH", 5) == 0) {
+        return true;
+    }
+
+    processCommand(line.c_str());
+
+    bool ok = true;
+    if (Serial.getFullOutput().size() > 16384) {
+        failure = "command output out of proportion";
+        ok = false;
+    }
+
+    // CONFIG HASH is maintained incrementally - it must match a full recompute
+    uint64_t keyHash = 0;
+    for (int i = 0; i < NUM_SWITCHES; i++) {
+        keyHash += configHashEntry(CONFIG_HASH_KEY_DOWN, i, macros[i].downMacro);
+        keyHash += configHashEntry(CONFIG_HASH_KEY_UP, i, macros[i].upMacro);
+    }
+    chordHashSum = 0;
+    chording.forEachChord(sumChordHash);
+    if (ok && getConfigHash() != configHashCombine(keyHash, chordHashSum, chording.getModifierMask())) {
+        failure = "CONFIG HASH differs from a full recompute";
+        ok = false;
+    }
+
+    resetDevice();
+    return ok;
+}
+
+struct FuzzTarget {
+    const char* name;
+    FuzzCheck check;
+    size_t maxLength;               // Longest input worth building for this target
+};
+
+static const FuzzTarget TARGETS[] = {
+    {"encode",    checkEncode,          HOST_SCALE_LIMIT},
+    {"decode",    checkDecode,          HOST_SCALE_LIMIT},
+    {"keylist",   checkKeyList,         HOST_SCALE_LIMIT},
+    {"switchdir", checkSwitchDirection, HOST_SCALE_LIMIT},
+    {"command",   checkCommand,         127},
+};
+
+#define TARGET_COUNT (sizeof(TARGETS) / sizeof(TARGETS[0]))
+
+static const FuzzTarget* findTarget(const std::string& name) {
+    for (const auto& target : TARGETS) {
+        if (name == target.name) return &target;
+    }
+    return nullptr;
+}
+
+static bool runTarget(const FuzzTarget& target, const std::string& input,
+                      FuzzCost& cost, std::string& failure) {
+    liveBytes = peakLiveBytes = 0;
+    allocationCount = 0;
+    tracking = true;
+    uint64_t start = readWork();
+    bool ok = target.check(input, failure);
+    uint64_t end = readWork();
+    tracking = false;
+
+    cost.work = end - start;
+    cost.peakBytes = peakLiveBytes;
+    cost.allocations = allocationCount;
+    return ok;
+}
+
+//==============================================================================
+// LIBFUZZER ENTRY POINT
+//==============================================================================
+
+static const FuzzTarget* fixedTarget = nullptr;
+static double worstWorkPerByte = 0;
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv) {
+    const char* name = getenv("FUZZ_TARGET");
+    if (name) fixedTarget = findTarget(name);
+#ifdef FUZZ_LIBFUZZER
+    __sanitizer_install_malloc_and_free_hooks(sanitizerMallocHook, sanitizerFreeHook);
+#endif
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const FuzzTarget* target = fixedTarget;
+    if (!target) {
+        if (size == 0) return 0;
+        target = &TARGETS[data[0] % TARGET_COUNT];
+        data++;
+        size--;
+    }
+    std::string input((const char*)data, std::min(size, target->maxLength));
+
+    FuzzCost cost;
+    std::string failure;
+    if (!runTarget(*target, input, cost, failure)) {
+        fprintf(stderr, "%s: %s\n", target->name, failure.c_str());
+        abort();
+    }
+
+    double perByte = (double)cost.work / (input.size() + 1);
+    if (perByte > worstWorkPerByte) {
+        worstWorkPerByte = perByte;
+        fprintf(stderr, "#worst %s len=%zu %s=%llu peak=%llu allocs=%llu\n", target->name,
+                input.size(), workUnit(), (unsigned long long)cost.work,
+                (unsigned long long)cost.peakBytes, (unsigned long long)cost.allocations);
+    }
+    return 0;
+}
+
+#ifndef FUZZ_LIBFUZZER
+
+//==============================================================================
+// INPUT FILES
+//==============================================================================
+
+struct FuzzInput {
+    std::string path;
+    const FuzzTarget* target;
+    std::string data;
+};
+
+static bool readFile(const std::string& path, std::string& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Files under a directory named after a target; that directory picks the target
+static void collectInputs(const std::string& path, std::vector<FuzzInput>& inputs) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return;
+
+    if (S_ISDIR(info.st_mode)) {
+        DIR* dir = opendir(path.c_str());
+        if (!dir) return;
+        std::vector<std::string> names;
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') names.push_back(entry->d_name);
+        }
+        closedir(dir);
+        std::sort(names.begin(), names.end());
+        for (const auto& name : names) collectInputs(path + "/" + name, inputs);
+        return;
+    }
+
+    size_t slash = path.find_last_of('/');
+    size_t parent = slash == std::string::npos ? std::string::npos : path.find_last_of('/', slash - 1);
+    std::string dirName = slash == std::string::npos ? ""
+        : path.substr(parent == std::string::npos ? 0 : parent + 1,
+                      slash - (parent == std::string::npos ? 0 : parent + 1));
+    const FuzzTarget* target = findTarget(dirName);
+    if (!target) return;
+
+    FuzzInput input;
+    input.path = path;
+    input.target = target;
+    if (readFile(path, input.data)) inputs.push_back(input);
+}
+
+static std::string hexName(const std::string& data) {
+    uint64_t hash = configHashEntry('Z', data.size(), nullptr);
+    for (unsigned char c : data) hash = (hash ^ c) * 0x100000001B3ULL;
+    char name[20];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+    return name;
+}
+
+//==============================================================================
+// COST GROWTH
+//==============================================================================
+
+// Least cost over a few runs - timing noise only ever adds
+static uint64_t stableWork(const FuzzTarget& target, const std::string& input) {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 3; i++) {
+        FuzzCost cost;
+        std::string failure;
+        runTarget(target, input, cost, failure);
+        best = std::min(best, cost.work);
+    }
+    return best;
+}
+
+// Slope of log(cost) over log(length) while the input is repeated 2x..32x;
+// 1.0 is linear. Returns 0 if the input cannot be grown far enough.
+static double growthExponent(const FuzzTarget& target, const std::string& input) {
+    if (input.empty()) return 0;
+
+    std::vector<double> xs, ys;
+    for (size_t copies = 2; copies <= 32 && copies * input.size() <= target.maxLength; copies *= 2) {
+        std::string grown;
+        for (size_t i = 0; i < copies; i++) grown += input;
+        xs.push_back(log((double)grown.size()));
+        ys.push_back(log((double)stableWork(target, grown) + 1));
+    }
+    if (xs.size() < 3) return 0;
+
+    double mx = 0, my = 0;
+    for (size_t i = 0; i < xs.size(); i++) { mx += xs[i]; my += ys[i]; }
+    mx /= xs.size();
+    my /= ys.size();
+    double num = 0, den = 0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        num += (xs[i] - mx) * (ys[i] - my);
+        den += (xs[i] - mx) * (xs[i] - mx);
+    }
+    return den > 0 ? num / den : 0;
+}
+
+//==============================================================================
+// MUTATION
+//==============================================================================
+
+static const char* const DICTIONARY[] = {
+    "CTRL", "SHIFT", "ALT", "WIN", "CMD", "CTRL+SHIFT", "+CTRL", "-CTRL", "+SHIFT+ALT",
+    "F1", "F12", "F13", "ENTER", "TAB", "ESC", "UP", "DOWN", "HOME", "PAGEDOWN", "DELETE",
+    "\"", "\\", "\\x", "\\n", "\\x1F", " ", "  ", ",", "+", "0", "8", "9", "99999999999",
+    "MAP ", "CLEAR ", "SHOW ALL", "CHORD ADD ", "CHORD MODIFIERS ", "CHORD LIST",
+    "CONFIG HASH", "SIM ADD ", "SIM ROLL ", "SAVE", "LOAD", "HELP",
+};
+
+static std::string mutate(const std::string& parent, std::mt19937& rng, size_t maxLength) {
+    std::string child = parent;
+    int rounds = 1 + rng() % 4;
+    for (int r = 0; r < rounds; r++) {
+        size_t pos = child.empty() ? 0 : rng() % (child.size() + 1);
+        switch (rng() % 6) {
+            case 0:     // Flip a byte
+                if (!child.empty()) child[rng() % child.size()] = (char)rng();
+                break;
+            case 1:     // Insert a dictionary token
+                child.insert(pos, DICTIONARY[rng() % (sizeof(DICTIONARY) / sizeof(DICTIONARY[0]))]);
+                break;
+            case 2:     // Delete a chunk
+                if (!child.empty()) {
+                    size_t at = rng() % child.size();
+                    child.erase(at, 1 + rng() % std::min<size_t>(8, child.size() - at));
+                }
+                break;
+            case 3:     // Duplicate a chunk
+                if (!child.empty()) {
+                    size_t at = rng() % child.size();
+                    size_t len = 1 + rng() % std::min<size_t>(16, child.size() - at);
+                    child.insert(pos, child.substr(at, len));
+                }
+                break;
+            case 4:     // Insert a printable byte
+                child.insert(pos, 1, (char)(32 + rng() % 95));
+                break;
+            default:    // Insert a raw byte
+                child.insert(pos, 1, (char)rng());
+                break;
+        }
+    }
+    if (child.size() > maxLength) child.resize(maxLength);
+    return child;
+}
+
+// Drop chunks while the cost per byte stays within 5% of the original and
+// the input is long enough that fixed call overhead does not dominate
+static std::string minimize(const FuzzTarget& target, const std::string& input) {
+    auto perByte = [&](const std::string& s) {
+        return (double)stableWork(target, s) / (s.size() + 1);
+    };
+    std::string best = input;
+    double goal = perByte(input) * 0.95;
+
+    for (size_t chunk = best.size() / 2; chunk >= 1; chunk /= 2) {
+        for (size_t at = 0; at + chunk <= best.size(); ) {
+            std::string trial = best.substr(0, at) + best.substr(at + chunk);
+            if (trial.size() >= MIN_WORST_LENGTH && perByte(trial) >= goal) {
+                best = trial;
+            } else {
+                at += chunk;
+            }
+        }
+    }
+    return best;
+}
+
+//==============================================================================
+// DRIVER MODES
+//==============================================================================
+
+static int runInputs(const std::vector<FuzzInput>& inputs) {
+    int failures = 0;
+    for (const auto& input : inputs) {
+        FuzzCost cost;
+        std::string failure;
+        bool ok = runTarget(*input.target, input.data, cost, failure);
+        printf("%-4s %-9s %5zu bytes %10llu %s %7llu peak bytes %5llu allocs  %s\n",
+               ok ? "ok" : "FAIL", input.target->name, input.data.size(),
+               (unsigned long long)cost.work, workUnit(), (unsigned long long)cost.peakBytes,
+               (unsigned long long)cost.allocations, input.path.c_str());
+        if (!ok) {
+            printf("     %s\n", failure.c_str());
+            failures++;
+        }
+    }
+    printf("\n%zu inputs, %d failures\n", inputs.size(), failures);
+    return failures ? 1 : 0;
+}
+
+static int scaleInputs(const std::vector<FuzzInput>& inputs) {
+    int superLinear = 0;
+    for (const auto& input : inputs) {
+        double exponent = growthExponent(*input.target, input.data);
+        if (exponent == 0) continue;
+        bool flagged = exponent > SUPERLINEAR_EXPONENT;
+        superLinear += flagged;
+        printf("%-12s %-9s cost ~ len^%.2f  %s\n", flagged ? "SUPERLINEAR" : "ok",
+               input.target->name, exponent, input.path.c_str());
+    }
+    printf("\n%d super-linear inputs (threshold len^%.2f, %s)\n", superLinear,
+           SUPERLINEAR_EXPONENT, workUnit());
+    return 0;
+}
+
+static int fuzzTarget(const FuzzTarget& target, unsigned long iterations, unsigned long seed) {
+    std::vector<FuzzInput> corpus;
+    collectInputs(std::string("fuzz-corpus/") + target.name, corpus);
+    collectInputs(std::string("fuzz-worst/") + target.name, corpus);
+
+    std::vector<std::string> pool;
+    for (const auto& input : corpus) pool.push_back(input.data);
+    if (pool.empty()) pool.push_back("");
+
+    std::mt19937 rng(seed);
+    std::string worst;
+    double worstPerByte = 0;
+    int failures = 0;
+
+    for (unsigned long i = 0; i < iterations; i++) {
+        std::string child = mutate(pool[rng() % pool.size()], rng, target.maxLength);
+        FuzzCost cost;
+        std::string failure;
+        if (!runTarget(target, child, cost, failure)) {
+            std::string path = std::string("fuzz-failure-") + target.name + "-" + hexName(child);
+            std::ofstream(path, std::ios::binary) << child;
+            printf("FAIL %s: %s (saved %s)\n", target.name, failure.c_str(), path.c_str());
+            failures++;
+            continue;
+        }
+
+        // Keep children that are the most expensive per byte so far, plus a
+        // few others for diversity
+        double perByte = (double)cost.work / (child.size() + 1);
+        if (child.size() >= MIN_WORST_LENGTH && perByte > worstPerByte) {
+            worstPerByte = perByte;
+            worst = child;
+            pool.push_back(child);
+        } else if (rng() % 64 == 0 && pool.size() < 1024) {
+            pool.push_back(child);
+        }
+    }
+
+    printf("%s: %lu runs, %d failures\n", target.name, iterations, failures);
+    if (!worst.empty()) {
+        std::string small = minimize(target, worst);
+        double exponent = growthExponent(target, small);
+        std::string dir = std::string("fuzz-worst/") + target.name;
+        mkdir("fuzz-worst", 0755);
+        mkdir(dir.c_str(), 0755);
+        std::string path = dir + "/" + hexName(small);
+        std::ofstream(path, std::ios::binary) << small;
+        printf("worst input: %zu bytes, %.1f %s/byte, cost ~ len^%.2f%s -> %s\n", small.size(),
+               (double)stableWork(target, small) / (small.size() + 1), workUnit(), exponent,
+               exponent > SUPERLINEAR_EXPONENT ? " SUPERLINEAR" : "", path.c_str());
+    }
+    return failures ? 1 : 0;
+}
+
+static void usage() {
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "  fuzz-parsers run <file|dir>...\n");
+    fprintf(stderr, "  fuzz-parsers scale <file|dir>...\n");
+    fprintf(stderr, "  fuzz-parsers fuzz <target> [-n ITERATIONS] [-s SEED]\n");
+    fprintf(stderr, "\nTargets:");
+    for (const auto& target : TARGETS) fprintf(stderr, " %s", target.name);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+    TestTimeControl::setTime(1000);
+    std::string mode = argv[1];
+
+    if (mode == "fuzz") {
+        const FuzzTarget* target = findTarget(argv[2]);
+        if (!target) {
+            usage();
+            return 2;
+        }
+        unsigned long iterations = 100000;
+        unsigned long seed = 1;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "-n") == 0) iterations = strtoul(argv[i + 1], nullptr, 10);
+            if (strcmp(argv[i], "-s") == 0) seed = strtoul(argv[i + 1], nullptr, 10);
+        }
+        return fuzzTarget(*target, iterations, seed);
+    }
+
+    std::vector<FuzzInput> inputs;
+    for (int i = 2; i < argc; i++) collectInputs(argv[i], inputs);
+    if (mode == "run") return runInputs(inputs);
+    if (mode == "scale") return scaleInputs(inputs);
+
+    usage();
+    return 2;
+}
+
+#endif // FUZZ_LIBFUZZER
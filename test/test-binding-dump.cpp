@@ -0,0 +1,166 @@
+/*
+ * Binding Dump Testing
+ * Reads DUMP from the loopback device simulator and checks the records,
+ * that the host decoder renders them exactly as SHOW ALL / CHORD LIST do
+ * on the device, and that sync reads bindings back through it
+ */
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../config-hash.h"
+#include "../builtin-profile.h"
+#include "../tools/binding-dump.h"
+#include "../tools/config-file.h"
+#include "../tools/config-sync.h"
+#include "../tools/device-sim.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+static const std::vector<std::string> BASE_CONFIG = {
+    "MAP 0 \"hello\"",
+    "MAP 2 up \"bye\"",
+    "MAP 3 MOVE:0,-4",
+    "CHORD ADD 3,4 \"the\"",
+    "CHORD ADD 5+6 CTRL+SHIFT T",
+    "CHORD MODIFIERS 6",
+};
+
+// Blank EEPROM, apply lines on the device, SAVE and reboot - with the
+// factory profile underneath, which default builds leave out
+void flashDevice(LoopbackDevice& device, const std::vector<std::string>& lines) {
+    EEPROM.clear();
+    setBuiltinProfile(&FACTORY_PROFILE);
+    device.powerCycle();
+
+    std::vector<std::string> commands = lines;
+    commands.push_back("SAVE");
+    DeviceConsole console(device);
+    std::vector<ConsoleReply> replies;
+    std::string error;
+    ASSERT_TRUE(console.run(commands, replies, error), error);
+    device.powerCycle();
+}
+
+std::string runCommand(LoopbackDevice& device, const std::string& command) {
+    DeviceConsole console(device);
+    std::string response, error;
+    ASSERT_TRUE(console.run(command, response, error), error);
+    return response;
+}
+
+//==============================================================================
+// DUMP TESTS
+//==============================================================================
+
+void testRecords(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, BASE_CONFIG);
+    std::string dump = runCommand(device, "DUMP");
+
+    ASSERT_STR_CONTAINS(dump, "M 40\n", "Modifier mask");
+    ASSERT_STR_CONTAINS(dump, "K 0 D 5 68656C6C6F\n", "Key macro bytes");
+    ASSERT_STR_CONTAINS(dump, "K 2 U 3 627965\n", "Release macro");
+    ASSERT_STR_CONTAINS(dump, "K 3 D 3 1D807C\n", "Mouse operands as stored");
+    ASSERT_STR_CONTAINS(dump, "C 18 3 746865\n", "Chord mask and bytes");
+    ASSERT_STR_CONTAINS(dump, "BK 1 D ", "Built-in binding still in effect");
+    ASSERT_STR_NOT_CONTAINS(dump, "BK 0 D ", "Overridden built-in left out");
+    ASSERT_STR_NOT_CONTAINS(dump, "K 0 U", "Empty bindings left out");
+
+    BindingDump parsed;
+    std::string error;
+    bool ok = parseBindingDump(dump, parsed, error);
+    ASSERT_TRUE(ok, error);
+    ASSERT_EQ(parsed.modifierMask, 0x40u, "Modifiers parsed");
+    ASSERT_STR_CONTAINS(dump, "END " + std::to_string(parsed.bindings.size() + 1) + "\n",
+                        "END counts every record");
+}
+
+void testHostRendering(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, BASE_CONFIG);
+
+    std::string onDevice = runCommand(device, "SHOW ALL") + runCommand(device, "CHORD LIST") +
+                           runCommand(device, "CHORD MODIFIERS");
+
+    BindingDump dump;
+    std::string error;
+    bool ok = parseBindingDump(runCommand(device, "DUMP"), dump, error);
+    ASSERT_TRUE(ok, error);
+    ASSERT_STR_EQ(formatBindingDump(dump), onDevice, "Host output matches the device decoder");
+}
+
+void testDamagedDumps(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, BASE_CONFIG);
+    std::string dump = runCommand(device, "DUMP");
+    BindingDump parsed;
+    std::string error;
+
+    std::string shortRecord = dump;
+    shortRecord.erase(shortRecord.find("68656C6C6F"), 2);
+    ASSERT_FALSE(parseBindingDump(shortRecord, parsed, error), "Length mismatch rejected");
+    ASSERT_STR_CONTAINS(error, "K 0 D", "Error names the record");
+
+    std::string lostLine = dump;
+    size_t chord = lostLine.find("C 18 ");
+    lostLine.erase(chord, lostLine.find('\n', chord) + 1 - chord);
+    ASSERT_FALSE(parseBindingDump(lostLine, parsed, error), "Missing record caught by END");
+
+    ASSERT_FALSE(parseBindingDump("Unknown command - type HELP\n", parsed, error), "Older firmware");
+}
+
+void testSyncReadback(const TestCase& test) {
+    LoopbackDevice device;
+    // Control bytes come back as stored, not via their text form
+    std::vector<std::string> lines = BASE_CONFIG;
+    lines.push_back("MAP 4 \"ab\\x0B\"");
+    flashDevice(device, lines);
+
+    HostConfig desired;
+    for (const auto& line : lines) {
+        std::string error;
+        ASSERT_TRUE(applyConfigLine(desired, line.c_str(), error), error);
+    }
+
+    DeviceConsole console(device);
+    HostConfig current;
+    bool exact = false;
+    std::string error;
+    bool ok = readDeviceConfig(console, current, exact, error);
+    ASSERT_TRUE(ok, error);
+    ASSERT_TRUE(exact, "Raw bytes read back exactly");
+    ASSERT_EQ(hostConfigHash(current), hostConfigHash(desired), "Same configuration");
+    ASSERT_EQ(console.commandsSent(), 1, "One DUMP replaces SHOW ALL, CHORD LIST, CHORD MODIFIERS");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Binding Dump Tests" << std::endl;
+    std::cout << "==========================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("DUMP records", "", EXPECT_PASS), testRecords);
+    runner.runTest(TestCase("Host rendering", "", EXPECT_PASS), testHostRendering);
+    runner.runTest(TestCase("Damaged dumps", "", EXPECT_PASS), testDamagedDumps);
+    runner.runTest(TestCase("Sync readback", "", EXPECT_PASS), testSyncReadback);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
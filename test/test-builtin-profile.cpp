@@ -0,0 +1,219 @@
+/*
+ * Built-in Profile Testing
+ * Checks that KP_* literals encode exactly like the MAP encoder, that flash
+ * macros execute like RAM macros, and that MAP / CHORD ADD bindings overlay
+ * the built-in profile
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../macro-encode.h"
+#include "../macro-engine.h"
+#include "../storage.h"
+#include "../chording.h"
+#include "../builtin-profile.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// COMPILE-TIME CHECKS
+//==============================================================================
+
+static_assert(kpMacroValid(KP_CTRL(KP_F12)), "Function key literal should validate");
+static_assert(!kpMacroValid(""), "Empty macro should be rejected");
+static_assert(!kpMacroValid("\x05\x0D"), "F13 should be rejected");
+static_assert(!kpMacroValid("\x0E\x10" "a"), "Multi-modifier mask out of range should be rejected");
+
+//==============================================================================
+// TEST PROFILE
+//==============================================================================
+
+KP_MACRO(TEST_KEY0_DOWN, "hi" KP_ENTER);
+KP_MACRO(TEST_KEY0_UP,   KP_CTRL("z"));
+KP_MACRO(TEST_KEY1_DOWN, KP_F5);
+KP_MACRO(TEST_CHORD,     KP_SHIFT(KP_TAB));
+
+static const BuiltinKey TEST_KEYS[] PROGMEM = {
+    {0, BUILTIN_DOWN, TEST_KEY0_DOWN},
+    {0, BUILTIN_UP,   TEST_KEY0_UP},
+    {1, BUILTIN_DOWN, TEST_KEY1_DOWN},
+};
+
+static const BuiltinChord TEST_CHORDS[] PROGMEM = {
+    {0x0C, TEST_CHORD},         // Keys 2+3
+};
+
+static const BuiltinProfile TEST_PROFILE = {
+    TEST_KEYS, 3, TEST_CHORDS, 1
+};
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+void setupTestEnvironment() {
+    Serial.clear();
+    Keyboard.clearActions();
+    for (int i = 0; i < NUM_SWITCHES; i++) {
+        setSwitchMacro(i, false, nullptr);
+        setSwitchMacro(i, true, nullptr);
+    }
+    chording.clearAllChords();
+    chording.clearAllModifiers();
+    setBuiltinProfile(&TEST_PROFILE);
+}
+
+std::string encode(const char* source) {
+    MacroEncodeResult parsed = macroEncode(source);
+    if (parsed.error != nullptr) {
+        ASSERT_FAIL(std::string("Encoding failed: ") + parsed.error);
+    }
+    std::string bytes = parsed.utf8Sequence;
+    free(parsed.utf8Sequence);
+    return bytes;
+}
+
+std::string showKey(const char* args) {
+    Serial.clear();
+    processCommand((std::string("SHOW ") + args).c_str());
+    return Serial.getFullOutput();
+}
+
+std::string pressChord(uint32_t mask) {
+    Keyboard.clearActions();
+    TestTimeControl::setTime(1000);
+    chording.processChording(mask);
+    TestTimeControl::advanceTime(10);
+    chording.processChording(0);
+    return Keyboard.toString();
+}
+
+//==============================================================================
+// LITERAL TESTS
+//==============================================================================
+
+void testLiteralsMatchEncoder(const TestCase& test) {
+    struct { const char* literal; const char* source; } cases[] = {
+        {KP_CTRL("c"),                  "CTRL C"},
+        {KP_ALT(KP_F4),                 "ALT F4"},
+        {KP_CMD(KP_SPACE),              "CMD SPACE"},
+        {KP_F1 KP_F10 KP_F12,           "F1 F10 F12"},
+        {"ls -l" KP_ENTER,              "\"ls -l\" ENTER"},
+        {KP_UP KP_DOWN KP_LEFT KP_RIGHT, "UP DOWN LEFT RIGHT"},
+        {KP_HOME KP_END KP_PAGEUP KP_PAGEDOWN KP_DELETE, "HOME END PAGEUP PAGEDOWN DELETE"},
+        {KP_TAB KP_ESC KP_BACKSPACE,    "TAB ESC BACKSPACE"},
+        {KP_SHIFT("a"),                 "+SHIFT \"a\" -SHIFT"},
+    };
+    for (const auto& c : cases) {
+        ASSERT_TRUE(std::string(c.literal) == encode(c.source),
+                    std::string("Literal should match encoder for ") + c.source);
+    }
+}
+
+void testFlashExecution(const TestCase& test) {
+    std::string ram = encode("+CTRL +SHIFT \"t\" -SHIFT -CTRL F2 \"x\"");
+    Keyboard.clearActions();
+    executeUTF8Macro((const uint8_t*)ram.c_str(), ram.size());
+    std::string expected = Keyboard.toString();
+
+    KP_MACRO(FLASH_MACRO, KP_CTRL(KP_SHIFT("t")) KP_F2 "x");
+    Keyboard.clearActions();
+    executeUTF8MacroP(FLASH_MACRO);
+    ASSERT_STR_EQ(Keyboard.toString(), expected, "Flash macro should send the same keys");
+
+    Keyboard.clearActions();
+    executeUTF8MacroP(nullptr);
+    ASSERT_STR_EQ(Keyboard.toString(), "", "Missing built-in should send nothing");
+}
+
+//==============================================================================
+// OVERLAY TESTS
+//==============================================================================
+
+void testKeyLookup(const TestCase& test) {
+    setupTestEnvironment();
+    ASSERT_TRUE(findBuiltinKeyMacro(0, false) == TEST_KEY0_DOWN, "Key 0 down should be built in");
+    ASSERT_TRUE(findBuiltinKeyMacro(0, true) == TEST_KEY0_UP, "Key 0 up should be built in");
+    ASSERT_TRUE(findBuiltinKeyMacro(1, true) == nullptr, "Key 1 up is not bound");
+    ASSERT_TRUE(findBuiltinKeyMacro(5, false) == nullptr, "Key 5 is not bound");
+
+    setBuiltinProfile(nullptr);
+    ASSERT_TRUE(findBuiltinKeyMacro(0, false) == nullptr, "No profile - no bindings");
+}
+
+void testShowOverlay(const TestCase& test) {
+    setupTestEnvironment();
+    ASSERT_STR_CONTAINS(showKey("0"), "Key 0 DOWN: (built-in) \"hi\\n\"", "SHOW should list built-in");
+    ASSERT_STR_CONTAINS(showKey("5"), "Key 5 DOWN: (empty)", "Unbound key stays empty");
+
+    processCommand("MAP 0 \"mine\"");
+    ASSERT_STR_CONTAINS(showKey("0 DOWN"), "Key 0 DOWN: \"mine\"", "MAP should overlay built-in");
+
+    processCommand("CLEAR 0");
+    ASSERT_STR_CONTAINS(showKey("0 DOWN"), "(built-in)", "CLEAR should reveal built-in again");
+}
+
+void testBuiltinChord(const TestCase& test) {
+    setupTestEnvironment();
+    ASSERT_EQ(chording.getChordSwitchesMask(), 0x0Cu, "Built-in chord keys should be chord switches");
+    ASSERT_STR_EQ(pressChord(0x0C), "press shift write \\t release shift", "Built-in chord should fire");
+
+    processCommand("CHORD ADD 2,3 \"own\"");
+    ASSERT_STR_EQ(pressChord(0x0C), "write o write w write n", "CHORD ADD should overlay built-in");
+
+    processCommand("CHORD CLEAR");
+    ASSERT_EQ(chording.getChordSwitchesMask(), 0x0Cu, "CHORD CLEAR keeps built-in chords");
+    Serial.clear();
+    processCommand("CHORD LIST");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "2+3: (built-in)", "CHORD LIST should show built-in");
+}
+
+void testFactoryProfile(const TestCase& test) {
+    setupTestEnvironment();
+    setBuiltinProfile(nullptr);
+    setupBuiltinProfile();
+    ASSERT_TRUE(findBuiltinKeyMacro(0, false) == nullptr, "Factory profile off by default");
+
+    setBuiltinProfile(&FACTORY_PROFILE);
+    const char* macro = findBuiltinKeyMacro(0, false);
+    ASSERT_TRUE(macro != nullptr, "Factory profile should bind key 0");
+    for (int i = 0; i < NUM_SWITCHES; i++) {
+        ASSERT_TRUE(findBuiltinKeyMacro(i, false) != nullptr, "Factory profile binds every key");
+    }
+    ASSERT_EQ(chording.getChordSwitchesMask(), 0u, "Factory profile has no chords");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Built-in Profile Tests" << std::endl;
+    std::cout << "==============================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Literals match encoder", "", EXPECT_PASS), testLiteralsMatchEncoder);
+    runner.runTest(TestCase("Flash execution", "", EXPECT_PASS), testFlashExecution);
+    runner.runTest(TestCase("Key lookup", "", EXPECT_PASS), testKeyLookup);
+    runner.runTest(TestCase("SHOW overlay", "", EXPECT_PASS), testShowOverlay);
+    runner.runTest(TestCase("Built-in chord", "", EXPECT_PASS), testBuiltinChord);
+    runner.runTest(TestCase("Factory profile", "", EXPECT_PASS), testFactoryProfile);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/*
+ * Chord Correction Testing
+ * Strikes chords one key away from defined chords and checks that the only
+ * neighbour fires, that ambiguous and distant misses do not, and the
+ * CHORD CORRECT command and counts
+ */
+
+#include "Arduino.h"
+#include "Keyboard.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../chording.h"
+#include "../journal.h"
+#include "../macro-encode.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+#include <string>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+void addTestChord(uint32_t keyMask, const char* macroCommand) {
+    MacroEncodeResult result = macroEncode(macroCommand);
+    if (result.error == nullptr) {
+        chording.addChord(keyMask, result.utf8Sequence);
+        free(result.utf8Sequence);
+    }
+}
+
+// Press the keys together and release them together; returns what was typed
+std::string strike(uint32_t keyMask) {
+    Keyboard.clearActions();
+    chording.processChording(keyMask);
+    TestTimeControl::advanceTime(10);
+    chording.processChording(0);
+    return Keyboard.toString();
+}
+
+void setupTestEnvironment() {
+    TestTimeControl::setTime(1000);
+    chording.clearAllChords();
+    chording.clearAllModifiers();
+    chording.processChording(0);
+    chording.setCorrection(true);
+    chording.resetChordStats();
+
+    addTestChord(0x06, "\"a\"");    // Keys 1+2
+    addTestChord(0x38, "\"b\"");    // Keys 3+4+5
+}
+
+//==============================================================================
+// CORRECTION TESTS
+//==============================================================================
+
+void testExtraAndMissingKey(const TestCase& test) {
+    setupTestEnvironment();
+
+    ASSERT_STR_CONTAINS(strike(0x06), "write a", "Exact chord still fires");
+    ASSERT_EQ(chording.getCorrectedCount(), 0, "Exact match is not a correction");
+
+    ASSERT_STR_CONTAINS(strike(0x0E), "write a", "Extra key 3 dropped");
+    ASSERT_STR_CONTAINS(strike(0x18), "write b", "Missing key 5 added");
+    ASSERT_EQ(chording.getCorrectedCount(), 2, "Both counted as corrections");
+
+    // Chord end, then the macro it ran
+    JournalEntry entry = journalImageEntry(false, journalImageCount(false) - 2);
+    ASSERT_EQ(entry.type, JOURNAL_CHORD_END, "Chord end journaled");
+    ASSERT_EQ(entry.arg, JOURNAL_CHORD_CORRECTED, "Journal marks the correction");
+    ASSERT_EQ(entry.data, 0x18u, "Journal keeps the keys actually pressed");
+}
+
+void testNoUniqueNeighbour(const TestCase& test) {
+    setupTestEnvironment();
+
+    ASSERT_STR_EQ(strike(0x1E), "", "Two keys off fires nothing");
+    ASSERT_STR_EQ(strike(0x02), "", "Lone tap on a chord key stays a tap");
+
+    addTestChord(0x0A, "\"c\"");    // Keys 1+3: 1+2+3 is now one key from two chords
+    ASSERT_STR_EQ(strike(0x0E), "", "Ambiguous miss fires nothing");
+    ASSERT_EQ(chording.getUndefinedCount(), 3, "All left undefined");
+
+    chording.removeChord(0x0A);
+    ASSERT_STR_CONTAINS(strike(0x0E), "write a", "Index follows chord removal");
+
+    chording.setCorrection(false);
+    ASSERT_STR_EQ(strike(0x0E), "", "Off again: miss fires nothing");
+    ASSERT_FALSE(chording.isCorrectionEnabled(), "Index freed");
+}
+
+void testCorrectCommand(const TestCase& test) {
+    setupTestEnvironment();
+    processCommand("CHORD CORRECT OFF");
+
+    strike(0x0E);
+    Serial.clear();
+    processCommand("CHORD CORRECT ON");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Chord correction: on, 0 corrected, 1 undefined",
+                        "ON reports state and counts");
+
+    strike(0x0E);
+    Serial.clear();
+    processCommand("CHORD CORRECT");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "on, 1 corrected, 1 undefined", "Counts updated");
+
+    Serial.clear();
+    processCommand("CHORD CORRECT RESET");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "on, 0 corrected, 0 undefined", "RESET clears counts");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Chord Correction Tests" << std::endl;
+    std::cout << "==============================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Extra and missing key", "", EXPECT_PASS), testExtraAndMissingKey);
+    runner.runTest(TestCase("No unique neighbour", "", EXPECT_PASS), testNoUniqueNeighbour);
+    runner.runTest(TestCase("CHORD CORRECT command", "", EXPECT_PASS), testCorrectCommand);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/*
+ * Chord State Machine Explorer Testing
+ * Runs small explorations of the real chord engine and checks the counts,
+ * latency bounds and that forked workers agree with a single process
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../chording.h"
+#include "../tools/chord-explore.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+ExploreConfig smallConfig() {
+    ExploreConfig config;
+    config.keys = 3;
+    config.chords = {0x03, 0x07};
+    config.depth = 3;
+    return config;
+}
+
+ExploreResult explore(const ExploreConfig& config) {
+    ExploreResult result;
+    std::string error;
+    if (!exploreChords(config, result, error)) {
+        ASSERT_FAIL("Exploration failed: " + error);
+    }
+    return result;
+}
+
+//==============================================================================
+// EXPLORER TESTS
+//==============================================================================
+
+void testSequenceCount(const TestCase& test) {
+    ExploreConfig config = smallConfig();
+    config.delaysMs = {1, 60};
+    ExploreResult result = explore(config);
+
+    // 6 events per step: 6 + 36 + 216 sequences of length 1-3
+    ASSERT_EQ(result.sequences, 258u, "Every prefix should be a sequence");
+    ASSERT_EQ(result.violations, 0u, "No invariant should be violated");
+}
+
+void testLatencyBounds(const TestCase& test) {
+    ExploreConfig config = smallConfig();
+    config.depth = 4;
+    ExploreResult result = explore(config);
+
+    ASSERT_EQ(result.violations, 0u, "No invariant should be violated");
+    const ChordLatency& pair = result.latency[0];
+    const ChordLatency& triple = result.latency[1];
+    ASSERT_TRUE(pair.fires > 0 && triple.fires > 0, "Both chords should fire");
+
+    // Fastest: press, press, release, release 1ms apart
+    ASSERT_EQ(pair.minPressMs, 3u, "Two-key chord fires 3ms after the first press at best");
+    ASSERT_EQ(triple.minPressMs, 5u, "Three-key chord fires 5ms after the first press at best");
+    ASSERT_TRUE(pair.maxPressMs >= CHORD_CANCELLATION_TIMEOUT_MS, "Slow chords are explored");
+}
+
+void testParallelMatchesSerial(const TestCase& test) {
+    ExploreConfig config = smallConfig();
+    ExploreResult serial = explore(config);
+    config.jobs = 3;
+    ExploreResult parallel = explore(config);
+
+    ASSERT_EQ(parallel.sequences, serial.sequences, "Workers should cover every sequence");
+    ASSERT_EQ(parallel.events, serial.events, "Workers should replay every event");
+    for (size_t i = 0; i < serial.latency.size(); i++) {
+        ASSERT_EQ(parallel.latency[i].fires, serial.latency[i].fires, "Fire counts should match");
+        ASSERT_EQ(parallel.latency[i].maxPressMs, serial.latency[i].maxPressMs, "Latency should match");
+    }
+}
+
+void testInvalidChord(const TestCase& test) {
+    ExploreConfig config = smallConfig();
+    config.chords = {0x08};
+    ExploreResult result;
+    std::string error;
+    ASSERT_FALSE(exploreChords(config, result, error), "Chord outside the key range is rejected");
+    ASSERT_STR_CONTAINS(error, "must use keys 0-2", "Error should name the key range");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Chord Explorer Tests" << std::endl;
+    std::cout << "============================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Sequence count", "", EXPECT_PASS), testSequenceCount);
+    runner.runTest(TestCase("Latency bounds", "", EXPECT_PASS), testLatencyBounds);
+    runner.runTest(TestCase("Parallel matches serial", "", EXPECT_PASS), testParallelMatchesSerial);
+    runner.runTest(TestCase("Invalid chord", "", EXPECT_PASS), testInvalidChord);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+/*
+ * Configuration Hash Testing
+ * Verifies CONFIG HASH is order independent, maintained incrementally and
+ * matches the hash the host tools compute from a config file, and that
+ * compiled storage images load back into the same configuration
+ */
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../storage.h"
+#include "../chording.h"
+#include "../config-hash.h"
+#include "../serial-interface.h"
+#include "../tools/config-file.h"
+#include "../tools/config-image.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+void setupTestEnvironment() {
+    Serial.clear();
+    EEPROM.clear();
+
+    for (int i = 0; i < NUM_SWITCHES; i++) {
+        setSwitchMacro(i, false, nullptr);
+        setSwitchMacro(i, true, nullptr);
+    }
+    chording.clearAllChords();
+    chording.clearAllModifiers();
+}
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+void runCommands(const std::vector<std::string>& commands) {
+    for (const auto& cmd : commands) {
+        processCommand(cmd.c_str());
+    }
+}
+
+std::string deviceHash() {
+    Serial.clear();
+    processCommand("CONFIG HASH");
+    std::string output = Serial.getFullOutput();
+    size_t pos = output.find("Config hash: ");
+    if (pos == std::string::npos) return "";
+    return output.substr(pos + 13, 16);
+}
+
+std::string hostHash(const std::vector<std::string>& lines) {
+    HostConfig config;
+    for (const auto& line : lines) {
+        std::string error;
+        if (!applyConfigLine(config, line.c_str(), error)) {
+            ASSERT_FAIL("Host config rejected '" + line + "': " + error);
+        }
+    }
+    char hashText[17];
+    formatConfigHash(hostConfigHash(config), hashText);
+    return hashText;
+}
+
+static const std::vector<std::string> SAMPLE_CONFIG = {
+    "MAP 0 \"hello\"",
+    "MAP 1 CTRL C",
+    "MAP 2 up \"bye\"",
+    "CHORD ADD 3,4 \"the\"",
+    "CHORD ADD 4+5+6 CTRL+SHIFT T",
+    "CHORD MODIFIERS 6",
+};
+
+//==============================================================================
+// HASH TESTS
+//==============================================================================
+
+void testEmptyConfigHash(const TestCase& test) {
+    setupTestEnvironment();
+    ASSERT_STR_EQ(deviceHash(), "0000000000000000", "Empty configuration should hash to zero");
+}
+
+void testHashOutput(const TestCase& test) {
+    setupTestEnvironment();
+    runCommands({"MAP 0 \"x\""});
+    std::string hash = deviceHash();
+    ASSERT_EQ(hash.length(), 16u, "Hash should be 16 hex digits");
+    ASSERT_TRUE(hash != "0000000000000000", "Non-empty configuration should not hash to zero");
+}
+
+void testOrderIndependence(const TestCase& test) {
+    setupTestEnvironment();
+    runCommands(SAMPLE_CONFIG);
+    std::string forward = deviceHash();
+
+    setupTestEnvironment();
+    std::vector<std::string> reversed(SAMPLE_CONFIG.rbegin(), SAMPLE_CONFIG.rend());
+    runCommands(reversed);
+    ASSERT_STR_EQ(deviceHash(), forward, "Hash should not depend on binding order");
+}
+
+void testIncrementalUpdate(const TestCase& test) {
+    setupTestEnvironment();
+    runCommands(SAMPLE_CONFIG);
+    std::string original = deviceHash();
+
+    // Change and restore bindings - hash must track every step
+    runCommands({"MAP 0 \"changed\""});
+    ASSERT_TRUE(deviceHash() != original, "MAP should change the hash");
+    runCommands({"MAP 0 \"hello\""});
+    ASSERT_STR_EQ(deviceHash(), original, "Restoring MAP should restore the hash");
+
+    runCommands({"CHORD REMOVE 3,4"});
+    ASSERT_TRUE(deviceHash() != original, "CHORD REMOVE should change the hash");
+    runCommands({"CHORD ADD 3,4 \"the\""});
+    ASSERT_STR_EQ(deviceHash(), original, "Re-adding chord should restore the hash");
+
+    runCommands({"CHORD MODIFIERS CLEAR"});
+    ASSERT_TRUE(deviceHash() != original, "Modifier change should change the hash");
+    runCommands({"CHORD MODIFIERS 6"});
+    ASSERT_STR_EQ(deviceHash(), original, "Restoring modifiers should restore the hash");
+
+    runCommands({"CLEAR 2 UP", "CLEAR 1", "CLEAR 0", "CHORD CLEAR", "CHORD MODIFIERS CLEAR"});
+    ASSERT_STR_EQ(deviceHash(), "0000000000000000", "Clearing everything should return to zero");
+}
+
+void testHashSurvivesSaveLoad(const TestCase& test) {
+    setupTestEnvironment();
+    runCommands(SAMPLE_CONFIG);
+    std::string original = deviceHash();
+
+    runCommands({"SAVE", "MAP 7 \"scratch\"", "CHORD CLEAR", "LOAD"});
+    ASSERT_STR_EQ(deviceHash(), original, "LOAD should restore the saved hash");
+}
+
+void testHostHashMatchesDevice(const TestCase& test) {
+    setupTestEnvironment();
+    runCommands(SAMPLE_CONFIG);
+    ASSERT_STR_EQ(hostHash(SAMPLE_CONFIG), deviceHash(), "Host tool hash should match device");
+}
+
+void testDirectionsHashDifferently(const TestCase& test) {
+    ASSERT_TRUE(hostHash({"MAP 0 \"a\""}) != hostHash({"MAP 0 up \"a\""}),
+                "Down and up macros should hash differently");
+    ASSERT_TRUE(hostHash({"MAP 0 \"a\""}) != hostHash({"MAP 1 \"a\""}),
+                "Same macro on different keys should hash differently");
+    ASSERT_TRUE(hostHash({"CHORD ADD 0,1 \"a\""}) != hostHash({"CHORD ADD 0,2 \"a\""}),
+                "Same macro on different chords should hash differently");
+}
+
+//==============================================================================
+// CONFIG IMAGE TESTS
+//==============================================================================
+
+void testImageLoadsBack(const TestCase& test) {
+    HostConfig config;
+    for (const auto& line : SAMPLE_CONFIG) {
+        std::string error;
+        ASSERT_TRUE(applyConfigLine(config, line.c_str(), error), error);
+    }
+
+    std::vector<uint8_t> image;
+    uint16_t usedBytes;
+    std::string error;
+    ASSERT_TRUE(buildConfigImage(config, *findBoard("teensy"), image, usedBytes, error), error);
+    ASSERT_EQ(image.size(), 1024u, "Image should cover the board EEPROM");
+
+    // Flash the image onto a blank device and LOAD it
+    setupTestEnvironment();
+    ASSERT_EQ(installConfigImage(image.data(), usedBytes), usedBytes, "Image should install");
+    runCommands({"LOAD"});
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Loaded", "LOAD should accept the image");
+
+    char expected[17];
+    formatConfigHash(hostConfigHash(config), expected);
+    ASSERT_STR_EQ(deviceHash(), expected, "Loaded image should carry the compiled configuration");
+}
+
+void testImageTooLarge(const TestCase& test) {
+    HostConfig config;
+    std::string longText(200, 'x');
+    for (int i = 0; i < NUM_SWITCHES; i++) {
+        config.downMacro[i] = longText;
+    }
+
+    std::vector<uint8_t> image;
+    uint16_t usedBytes;
+    std::string error;
+    ASSERT_FALSE(buildConfigImage(config, *findBoard("teensy"), image, usedBytes, error),
+                 "Oversized configuration should be rejected");
+    ASSERT_STR_CONTAINS(error, "teensy has 1024", "Error should name the board capacity");
+}
+
+void testModifierOnlyChordRejected(const TestCase& test) {
+    HostConfig config;
+    std::string error;
+    ASSERT_TRUE(applyConfigLine(config, "CHORD MODIFIERS 0", error), error);
+    ASSERT_FALSE(applyConfigLine(config, "CHORD ADD 0 \"x\"", error),
+                 "Chord of only modifier keys should be rejected");
+    ASSERT_STR_CONTAINS(error, "non-modifier", "Error should explain the chord rule");
+    ASSERT_FALSE(applyConfigLine(config, "MAP 0 BADKEY", error), "Bad macro should be rejected");
+    ASSERT_STR_CONTAINS(error, "Parse error", "Error should come from the encoder");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Configuration Hash Tests" << std::endl;
+    std::cout << "================================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Empty config hash", "", EXPECT_PASS), testEmptyConfigHash);
+    runner.runTest(TestCase("Hash output format", "", EXPECT_PASS), testHashOutput);
+    runner.runTest(TestCase("Order independence", "", EXPECT_PASS), testOrderIndependence);
+    runner.runTest(TestCase("Incremental update", "", EXPECT_PASS), testIncrementalUpdate);
+    runner.runTest(TestCase("Hash survives SAVE/LOAD", "", EXPECT_PASS), testHashSurvivesSaveLoad);
+    runner.runTest(TestCase("Host hash matches device", "", EXPECT_PASS), testHostHashMatchesDevice);
+    runner.runTest(TestCase("Binding identity in hash", "", EXPECT_PASS), testDirectionsHashDifferently);
+    runner.runTest(TestCase("Compiled image loads back", "", EXPECT_PASS), testImageLoadsBack);
+    runner.runTest(TestCase("Oversized image rejected", "", EXPECT_PASS), testImageTooLarge);
+    runner.runTest(TestCase("Chord rules validated", "", EXPECT_PASS), testModifierOnlyChordRejected);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
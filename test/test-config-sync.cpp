@@ -0,0 +1,268 @@
+/*
+ * Configuration Sync Testing
+ * Runs the host sync against the loopback device simulator and checks that
+ * only differing bindings are sent, in a valid order, with a single SAVE
+ */
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../config-hash.h"
+#include "../tools/config-file.h"
+#include "../tools/config-sync.h"
+#include "../tools/device-sim.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+HostConfig makeConfig(const std::vector<std::string>& lines) {
+    HostConfig config;
+    for (const auto& line : lines) {
+        std::string error;
+        if (!applyConfigLine(config, line.c_str(), error)) {
+            ASSERT_FAIL("Config rejected '" + line + "': " + error);
+        }
+    }
+    return config;
+}
+
+// Blank EEPROM, apply lines on the device, SAVE and reboot
+void flashDevice(LoopbackDevice& device, const std::vector<std::string>& lines) {
+    EEPROM.clear();
+    device.powerCycle();
+
+    std::vector<std::string> commands = lines;
+    commands.push_back("SAVE");
+    DeviceConsole console(device);
+    std::vector<ConsoleReply> replies;
+    std::string error;
+    ASSERT_TRUE(console.run(commands, replies, error), error);
+    device.powerCycle();
+}
+
+std::string deviceHash(LoopbackDevice& device) {
+    DeviceConsole console(device);
+    std::string response, error;
+    ASSERT_TRUE(console.run("CONFIG HASH", response, error), error);
+    size_t pos = response.find("Config hash: ");
+    return pos == std::string::npos ? "" : response.substr(pos + 13, 16);
+}
+
+std::string configHash(const HostConfig& config) {
+    char hashText[17];
+    formatConfigHash(hostConfigHash(config), hashText);
+    return hashText;
+}
+
+bool logContains(const LoopbackDevice& device, const std::string& prefix) {
+    for (const auto& line : device.commandLog()) {
+        if (line.compare(0, prefix.size(), prefix) == 0) return true;
+    }
+    return false;
+}
+
+static const std::vector<std::string> BASE_CONFIG = {
+    "MAP 0 \"hello\"",
+    "MAP 1 CTRL C",
+    "MAP 2 up \"bye\"",
+    "CHORD ADD 3,4 \"the\"",
+    "CHORD ADD 5+6 CTRL+SHIFT T",
+    "CHORD MODIFIERS 6",
+};
+
+//==============================================================================
+// RENDERING TESTS
+//==============================================================================
+
+void testRenderRoundTrip(const TestCase& test) {
+    const char* sources[] = {
+        "\"a\\bb\\x0b\"", "UP \"x\"", "CTRL+ALT DELETE", "\"tab\\there\\e\"", "\"\xC3\xA9t\xC3\xA9\"",
+    };
+    for (const char* source : sources) {
+        HostConfig config = makeConfig({std::string("MAP 0 ") + source});
+        std::string text;
+        ASSERT_TRUE(renderMacro(config.downMacro[0], text), std::string("Should render ") + source);
+        for (char c : text) {
+            ASSERT_TRUE(c >= 32 && c <= 126, "Rendered text should be console-safe: " + text);
+        }
+    }
+}
+
+//==============================================================================
+// SYNC TESTS
+//==============================================================================
+
+void testAlreadyInSync(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, BASE_CONFIG);
+
+    DeviceConsole console(device);
+    SyncReport report;
+    std::string error;
+    ASSERT_TRUE(syncDevice(console, makeConfig(BASE_CONFIG), SyncOptions(), report, error), error);
+    ASSERT_TRUE(report.upToDate, "Matching device should be reported up to date");
+    ASSERT_EQ(device.commandLog().size(), 2u, "Only CONFIG HASH and SAVE should be sent");
+    ASSERT_TRUE(report.saved, "Matching device should still be saved");
+}
+
+void testUnsavedMatchIsSaved(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, BASE_CONFIG);
+
+    // Live config matches the desired one, EEPROM still holds the old one
+    std::vector<std::string> wanted = BASE_CONFIG;
+    wanted[0] = "MAP 0 \"howdy\"";
+    HostConfig desired = makeConfig(wanted);
+    DeviceConsole console(device);
+    std::string response, error;
+    ASSERT_TRUE(console.run(wanted[0], response, error), error);
+    ASSERT_STR_EQ(deviceHash(device), configHash(desired), "Live config should match desired");
+
+    SyncReport report;
+    ASSERT_TRUE(syncDevice(console, desired, SyncOptions(), report, error), error);
+    ASSERT_TRUE(report.upToDate, "Live match should be reported up to date");
+    ASSERT_TRUE(report.ops.empty(), "No bindings should be sent");
+
+    device.powerCycle();
+    ASSERT_STR_EQ(deviceHash(device), configHash(desired), "Unsaved match should survive a reboot");
+}
+
+void testMinimalDiff(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, BASE_CONFIG);
+
+    std::vector<std::string> wanted = BASE_CONFIG;
+    wanted[0] = "MAP 0 \"howdy\"";
+    HostConfig desired = makeConfig(wanted);
+
+    DeviceConsole console(device);
+    SyncReport report;
+    std::string error;
+    ASSERT_TRUE(syncDevice(console, desired, SyncOptions(), report, error), error);
+    ASSERT_EQ(report.ops.size(), 1u, "Only the changed binding should be sent");
+    ASSERT_STR_EQ(report.ops[0].command, "MAP 0 DOWN \"howdy\"", "Changed binding command");
+    ASSERT_TRUE(report.exactReadback, "Device state should read back exactly");
+    ASSERT_EQ(device.saveCount(), 1, "Exactly one SAVE");
+
+    // Only what was saved survives a reboot
+    device.powerCycle();
+    ASSERT_STR_EQ(deviceHash(device), configHash(desired), "Saved config should match desired");
+}
+
+void testOperationOrder(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, BASE_CONFIG);
+
+    HostConfig desired = makeConfig({
+        "MAP 1 CTRL C",
+        "MAP 2 \"new\"",
+        "CHORD ADD 3,4 \"then\"",
+        "CHORD ADD 0+7 \"uses new modifier\"",
+        "CHORD MODIFIERS 0,6",
+    });
+
+    DeviceConsole console(device);
+    SyncReport report;
+    std::string error;
+    ASSERT_TRUE(syncDevice(console, desired, SyncOptions(), report, error), error);
+
+    std::vector<std::string> expected = {
+        "CHORD REMOVE 3+4",
+        "CHORD REMOVE 5+6",
+        "CHORD MODIFIERS 0+6",
+        "CHORD ADD 3+4 \"then\"",
+        "CHORD ADD 0+7 \"uses new modifier\"",
+        "CLEAR 0 DOWN",
+        "MAP 2 DOWN \"new\"",
+        "CLEAR 2 UP",
+    };
+    ASSERT_EQ(report.ops.size(), expected.size(), "Operation count");
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_STR_EQ(report.ops[i].command, expected[i], "Operation " + std::to_string(i));
+    }
+
+    device.powerCycle();
+    ASSERT_STR_EQ(deviceHash(device), configHash(desired), "Saved config should match desired");
+}
+
+void testDryRun(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, BASE_CONFIG);
+    std::string before = deviceHash(device);
+
+    SyncOptions options;
+    options.dryRun = true;
+    DeviceConsole console(device);
+    SyncReport report;
+    std::string error;
+    ASSERT_TRUE(syncDevice(console, makeConfig({"MAP 8 \"x\""}), options, report, error), error);
+    ASSERT_TRUE(report.ops.size() > 0, "Dry run should still plan operations");
+    ASSERT_FALSE(logContains(device, "MAP"), "Dry run should not send MAP");
+    ASSERT_FALSE(logContains(device, "CHORD REMOVE"), "Dry run should not send CHORD REMOVE");
+    ASSERT_EQ(device.saveCount(), 0, "Dry run should not SAVE");
+    ASSERT_STR_EQ(deviceHash(device), before, "Dry run should leave the device unchanged");
+}
+
+void testCommandTooLong(const TestCase& test) {
+    LoopbackDevice device;
+    flashDevice(device, {});
+
+    HostConfig desired;
+    desired.downMacro[0] = std::string(130, 'x');
+
+    DeviceConsole console(device);
+    SyncReport report;
+    std::string error;
+    ASSERT_FALSE(syncDevice(console, desired, SyncOptions(), report, error),
+                 "Binding longer than the console line should be refused");
+    ASSERT_STR_CONTAINS(error, "too long", "Error should explain the limit");
+    ASSERT_EQ(device.saveCount(), 0, "Nothing should be saved");
+}
+
+void testInexactPlanResendsAll(const TestCase& test) {
+    HostConfig current = makeConfig(BASE_CONFIG);
+    HostConfig desired = makeConfig(BASE_CONFIG);
+
+    std::vector<SyncOp> ops;
+    std::string error;
+    ASSERT_TRUE(planSync(current, desired, true, ops, error), error);
+    ASSERT_EQ(ops.size(), 0u, "Identical trusted configs need no operations");
+
+    ASSERT_TRUE(planSync(current, desired, false, ops, error), error);
+    ASSERT_STR_EQ(ops[0].command, "CHORD CLEAR", "Untrusted readback should clear chords first");
+    ASSERT_EQ(ops.size(), 7u, "CHORD CLEAR, modifiers, 2 chords and 3 key bindings");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Configuration Sync Tests" << std::endl;
+    std::cout << "================================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Render round trip", "", EXPECT_PASS), testRenderRoundTrip);
+    runner.runTest(TestCase("Already in sync", "", EXPECT_PASS), testAlreadyInSync);
+    runner.runTest(TestCase("Unsaved match is saved", "", EXPECT_PASS), testUnsavedMatchIsSaved);
+    runner.runTest(TestCase("Minimal diff", "", EXPECT_PASS), testMinimalDiff);
+    runner.runTest(TestCase("Operation order", "", EXPECT_PASS), testOperationOrder);
+    runner.runTest(TestCase("Dry run", "", EXPECT_PASS), testDryRun);
+    runner.runTest(TestCase("Command too long", "", EXPECT_PASS), testCommandTooLong);
+    runner.runTest(TestCase("Inexact readback plan", "", EXPECT_PASS), testInexactPlanResendsAll);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+/*
+ * Host Event Channel Testing
+ * Round-trips event frames, splits them from console text the way the
+ * host listener does (including frames cut across reads and damaged
+ * frames), and checks the EVENTS command, undefined chord events and
+ * the press / release pair a lone tap on a chord key sends
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../host-events.h"
+#include "../chording.h"
+#include "../macro-encode.h"
+#include "../serial-interface.h"
+#include "../tools/event-stream.h"
+
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+std::string frameBytes(uint8_t type, uint32_t data, uint32_t timeUs) {
+    HostEvent event = { type, data, timeUs };
+    uint8_t frame[HOST_EVENT_FRAME_SIZE];
+    encodeHostEvent(event, frame);
+    return std::string((const char*)frame, HOST_EVENT_FRAME_SIZE);
+}
+
+//==============================================================================
+// FRAME TESTS
+//==============================================================================
+
+void testRoundTrip(const TestCase& test) {
+    std::string frame = frameBytes(HOST_EVENT_CHORD, 0x1FF, 0xFFFFFFFF);
+    ASSERT_EQ((uint8_t)frame[0], HOST_EVENT_SYNC, "Starts with the sync byte");
+    for (size_t i = 1; i < frame.size(); i++) {
+        ASSERT_TRUE((uint8_t)frame[i] >= 0x80, "No text byte inside a frame");
+    }
+
+    HostEvent event;
+    ASSERT_TRUE(decodeHostEvent((const uint8_t*)frame.data(), event), "Decodes");
+    ASSERT_EQ(event.type, HOST_EVENT_CHORD, "Type kept");
+    ASSERT_EQ(event.data, 0x1FFu, "Keys kept");
+    ASSERT_EQ(event.timeUs, 0xFFFFFFFFu, "Full 32-bit time kept");
+
+    frame[5] ^= 0x01;
+    ASSERT_FALSE(decodeHostEvent((const uint8_t*)frame.data(), event), "Check catches a changed bit");
+}
+
+void testStreamSplit(const TestCase& test) {
+    std::string stream = "keypad> " + frameBytes(HOST_EVENT_PRESS, 4, 1000) + "Chord 0+1 added\r\n" +
+                         frameBytes(HOST_EVENT_RELEASE, 4, 2500);
+
+    // Fed in 5-byte reads, so both frames are split
+    HostEventReader reader;
+    std::vector<HostEvent> events;
+    std::string text;
+    for (size_t i = 0; i < stream.size(); i += 5) {
+        reader.feed(stream.substr(i, 5), events, text);
+    }
+    ASSERT_EQ(events.size(), 2u, "Both frames found");
+    ASSERT_STR_EQ(formatHostEvent(events[0]), "press 4", "First event");
+    ASSERT_STR_EQ(formatHostEvent(events[1]), "release 4", "Second event");
+    ASSERT_EQ(events[1].timeUs - events[0].timeUs, 1500u, "Device times kept");
+    ASSERT_STR_EQ(text, "keypad> Chord 0+1 added\r\n", "Text passes through untouched");
+
+    // A damaged frame is dropped and the next one still found
+    std::string damaged = frameBytes(HOST_EVENT_PRESS, 1, 0);
+    damaged[3] = 'x';
+    events.clear();
+    reader.feed(damaged + frameBytes(HOST_EVENT_CHORD, 3, 0), events, text);
+    ASSERT_EQ(reader.dropped(), 1u, "Damaged frame counted");
+    ASSERT_EQ(events.size(), 1u, "Resynchronized on the next frame");
+    ASSERT_STR_EQ(formatHostEvent(events[0]), "chord 0+1", "Chord keys formatted");
+}
+
+//==============================================================================
+// CHANNEL TESTS
+//==============================================================================
+
+void testEventsCommand(const TestCase& test) {
+    Serial.clear();
+    sendHostEvent(HOST_EVENT_PRESS, 2);
+    ASSERT_FALSE(Serial.hasOutput(), "Nothing sent while off");
+
+    processCommand("EVENTS ON");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Host events: on, 0 sent", "ON confirmed");
+
+    Serial.clear();
+    TestTimeControl::setTime(5);
+    sendHostEvent(HOST_EVENT_PRESS, 2);
+    std::string output = Serial.takeOutput();
+    ASSERT_EQ(output.size(), (size_t)HOST_EVENT_FRAME_SIZE, "One frame written");
+    HostEvent event;
+    ASSERT_TRUE(decodeHostEvent((const uint8_t*)output.data(), event), "Frame decodes");
+    ASSERT_EQ(event.timeUs, 5000u, "Stamped with micros()");
+
+    processCommand("EVENTS OFF");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Host events: off, 1 sent", "OFF keeps the count");
+    TestTimeControl::useRealTime();
+}
+
+void testUndefinedChordHook(const TestCase& test) {
+    static uint32_t reported;
+    reported = 0;
+    undefinedChordHook = [](uint32_t keyMask) { reported = keyMask; };
+
+    MacroEncodeResult encoded = macroEncode("\"x\"");
+    chording.clearAllChords();
+    chording.addChord(0x03, encoded.utf8Sequence);
+    free(encoded.utf8Sequence);
+
+    chording.processChording(0x03);
+    chording.processChording(0);
+    ASSERT_EQ(reported, 0u, "Defined chord is not reported");
+
+    chording.processChording(0x01);
+    chording.processChording(0);
+    ASSERT_EQ(reported, 0x01u, "Undefined chord reported with its keys");
+    undefinedChordHook = nullptr;
+}
+
+// Host copy of the undefined chord hook and key release path in keypaddle.ino
+// (every key is unbound here)
+static void hostSendChordEvent(uint32_t keyMask) {
+    if ((keyMask & (keyMask - 1)) == 0) {
+        uint8_t keyIndex = 0;
+        while (keyMask >>= 1) keyIndex++;
+        sendHostEvent(HOST_EVENT_PRESS, keyIndex);
+        return;
+    }
+    sendHostEvent(HOST_EVENT_CHORD, keyMask);
+}
+
+static void hostSwitches(uint32_t& last, uint32_t current) {
+    if (!chording.processChording(current)) {
+        uint32_t released = last & ~current;
+        for (uint8_t i = 0; i < NUM_SWITCHES; i++) {
+            if (released & (1UL << i)) sendHostEvent(HOST_EVENT_RELEASE, i);
+        }
+    }
+    last = current;
+}
+
+void testLoneTapEvents(const TestCase& test) {
+    undefinedChordHook = hostSendChordEvent;
+    MacroEncodeResult encoded = macroEncode("\"x\"");
+    chording.clearAllChords();
+    chording.addChord(0x03, encoded.utf8Sequence);
+    free(encoded.utf8Sequence);
+
+    setHostEvents(true);
+    Serial.clear();
+    uint32_t last = 0;
+    hostSwitches(last, 0x01);
+    hostSwitches(last, 0);
+    std::string output = Serial.takeOutput();
+    setHostEvents(false);
+    undefinedChordHook = nullptr;
+
+    HostEventReader reader;
+    std::vector<HostEvent> events;
+    std::string text;
+    reader.feed(output, events, text);
+    ASSERT_EQ(events.size(), 2u, "One press and one release");
+    ASSERT_STR_EQ(formatHostEvent(events[0]), "press 0", "Lone tap sends its press");
+    ASSERT_STR_EQ(formatHostEvent(events[1]), "release 0", "Then its release");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Host Event Channel Tests" << std::endl;
+    std::cout << "================================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Frame round trip", "", EXPECT_PASS), testRoundTrip);
+    runner.runTest(TestCase("Stream split", "", EXPECT_PASS), testStreamSplit);
+    runner.runTest(TestCase("EVENTS command", "", EXPECT_PASS), testEventsCommand);
+    runner.runTest(TestCase("Undefined chord hook", "", EXPECT_PASS), testUndefinedChordHook);
+    runner.runTest(TestCase("Lone tap events", "", EXPECT_PASS), testLoneTapEvents);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
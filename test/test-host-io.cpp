@@ -0,0 +1,197 @@
+/*
+ * Host Firmware I/O Testing
+ * Checks the kphost switch script and socket input, the EEPROM file and
+ * the pseudo-terminal console against the Serial mock
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+#include "../tools/host-io.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+std::string tempPath(const char* name) {
+    return std::string("/tmp/test-host-io-") + std::to_string(getpid()) + "-" + name;
+}
+
+void writeFile(const std::string& path, const std::string& text) {
+    std::ofstream(path) << text;
+}
+
+// Read whatever arrives within a short wait
+std::string readAvailable(int fd) {
+    std::string data;
+    char buffer[256];
+    for (int i = 0; i < 50; i++) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            data.append(buffer, n);
+            continue;
+        }
+        if (!data.empty()) break;
+        usleep(1000);
+    }
+    return data;
+}
+
+//==============================================================================
+// SWITCH INPUT TESTS
+//==============================================================================
+
+void testSwitchScript(const TestCase& test) {
+    uint32_t switches;
+    ASSERT_TRUE(parseSwitchState("0+2", switches), "Key list should parse");
+    ASSERT_EQ(switches, 0x5u, "Keys 0 and 2 should be set");
+    ASSERT_TRUE(parseSwitchState("none", switches), "NONE should parse");
+    ASSERT_EQ(switches, 0u, "NONE releases everything");
+    ASSERT_FALSE(parseSwitchState("zero", switches), "Words are not key lists");
+
+    std::string path = tempPath("script");
+    writeFile(path, "# roll\n10 0\n 30  0,1  # both\n50 NONE\n\n80 EXIT\n");
+    std::vector<SwitchScriptStep> steps;
+    std::string error;
+    ASSERT_TRUE(loadSwitchScript(path.c_str(), steps, error), "Script should load");
+    ASSERT_EQ(steps.size(), (size_t)4, "Comments and blank lines are skipped");
+    ASSERT_EQ(steps[1].atMs, 30u, "Step time");
+    ASSERT_EQ(steps[1].switches, 0x3u, "Step switches");
+    ASSERT_TRUE(steps[3].exit, "EXIT step");
+    ASSERT_EQ(steps[3].switches, 0u, "EXIT keeps the previous state");
+
+    writeFile(path, "20 0\n10 NONE\n");
+    ASSERT_FALSE(loadSwitchScript(path.c_str(), steps, error), "Backwards time should fail");
+    ASSERT_STR_CONTAINS(error, ":2: time goes backwards", "Error names the line");
+
+    writeFile(path, "20 x\n");
+    ASSERT_FALSE(loadSwitchScript(path.c_str(), steps, error), "Bad keys should fail");
+    unlink(path.c_str());
+}
+
+void testSwitchSocket(const TestCase& test) {
+    std::string path = tempPath("sock");
+    std::string error;
+    uint32_t switches = 0;
+    {
+        SwitchSocket socket;
+        ASSERT_TRUE(socket.listen(path.c_str(), error), "Socket should listen");
+
+        int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, path.c_str());
+        ASSERT_EQ(connect(client, (struct sockaddr*)&addr, sizeof(addr)), 0, "Client should connect");
+
+        ASSERT_TRUE(write(client, "3\n1+", 4) == 4, "Client write");
+        for (int i = 0; i < 50 && switches != 0x8; i++) {
+            socket.poll(switches);
+            usleep(1000);
+        }
+        ASSERT_EQ(switches, 0x8u, "Complete line applies");
+
+        ASSERT_TRUE(write(client, "2\nbogus\n", 8) == 8, "Client write");
+        for (int i = 0; i < 50 && switches != 0x6; i++) {
+            socket.poll(switches);
+            usleep(1000);
+        }
+        ASSERT_EQ(switches, 0x6u, "Split line joins, invalid line is ignored");
+        close(client);
+    }
+    ASSERT_TRUE(access(path.c_str(), F_OK) != 0, "Socket file removed on close");
+}
+
+//==============================================================================
+// EEPROM AND CONSOLE TESTS
+//==============================================================================
+
+void testEepromFile(const TestCase& test) {
+    std::string path = tempPath("eeprom");
+    std::string error;
+    unlink(path.c_str());
+
+    EEPROM.fill(0x12);
+    ASSERT_TRUE(loadEepromFile(path.c_str(), error), "Missing file is a fresh device");
+    ASSERT_TRUE(EEPROM.isErased(), "Fresh device EEPROM is erased");
+
+    EEPROM.write(0, 0xCA);
+    EEPROM.write(EEPROM.length() - 1, 0x55);
+    ASSERT_TRUE(saveEepromFile(path.c_str(), error), "Save should succeed");
+    EEPROM.clear();
+    ASSERT_TRUE(loadEepromFile(path.c_str(), error), "Load should succeed");
+    ASSERT_EQ(EEPROM.read(0), 0xCA, "First byte restored");
+    ASSERT_EQ(EEPROM.read(EEPROM.length() - 1), 0x55, "Last byte restored");
+
+    writeFile(path, "AB");
+    ASSERT_TRUE(loadEepromFile(path.c_str(), error), "Short file loads");
+    ASSERT_EQ(EEPROM.read(1), 'B', "Short file fills the start");
+    ASSERT_EQ(EEPROM.read(2), 0xFF, "Rest stays erased");
+    unlink(path.c_str());
+}
+
+void testConsolePty(const TestCase& test) {
+    std::string link = tempPath("tty");
+    std::string error;
+    {
+        ConsolePty console;
+        ASSERT_TRUE(console.open(link.c_str(), error), "Pseudo-terminal should open");
+
+        int client = open(link.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+        ASSERT_TRUE(client >= 0, "Client opens the link");
+
+        Serial.clear();
+        ASSERT_TRUE(write(client, "STAT\r\n", 6) == 6, "Client write");
+        for (int i = 0; i < 50 && !Serial.available(); i++) {
+            console.receive();
+            usleep(1000);
+        }
+        std::string received;
+        while (Serial.available()) received += Serial.read();
+        ASSERT_STR_EQ(received, "STAT\r\n", "Bytes reach the Serial mock raw");
+
+        Serial.clear();
+        Serial.println("OK");
+        Serial.print("keypad> ");
+        console.transmit();
+        ASSERT_STR_EQ(readAvailable(client), "OK\r\nkeypad> ", "Lines end in CR LF");
+        close(client);
+    }
+    ASSERT_TRUE(access(link.c_str(), F_OK) != 0, "Link removed on close");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Host Firmware I/O Tests" << std::endl;
+    std::cout << "===============================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Switch script", "", EXPECT_PASS), testSwitchScript);
+    runner.runTest(TestCase("Switch socket", "", EXPECT_PASS), testSwitchSocket);
+    runner.runTest(TestCase("EEPROM file", "", EXPECT_PASS), testEepromFile);
+    runner.runTest(TestCase("Console pty", "", EXPECT_PASS), testConsolePty);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
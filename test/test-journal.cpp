@@ -0,0 +1,247 @@
+/*
+ * Event Journal Testing
+ * Checks the RAM ring and its image, the EEPROM copy, the chord decisions
+ * recorded by the chording engine, the JOURNAL command and the kpjournal
+ * decoder
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../journal.h"
+#include "../macro-engine.h"
+#include "../storage.h"
+#include "../chording.h"
+#include "../serial-interface.h"
+#include "../tools/journal-dump.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+void setupTestEnvironment() {
+    Serial.clear();
+    Keyboard.clearActions();
+    chording.clearAllChords();
+    chording.clearAllModifiers();
+    chording.processChording(0);
+    TestTimeControl::setTime(1000);
+    clearJournal();
+}
+
+std::string command(const char* cmd) {
+    Serial.clear();
+    processCommand(cmd);
+    return Serial.getFullOutput();
+}
+
+// Switch edge as keypaddle.ino's loop() sees it
+void switchEdge(uint32_t state, uint32_t advanceMs) {
+    TestTimeControl::advanceTime(advanceMs);
+    journalRecord(JOURNAL_SWITCHES, 0, state);
+    chording.processChording(state);
+}
+
+std::string journalLog() {
+    std::string log;
+    for (uint8_t i = 0; i < journalImageCount(false); i++) {
+        log += formatJournalEntry(journalImageEntry(false, i)).c_str();
+        log += "\n";
+    }
+    return log;
+}
+
+//==============================================================================
+// RING AND EEPROM TESTS
+//==============================================================================
+
+void testRingWrap(const TestCase& test) {
+    setupTestEnvironment();
+    for (uint32_t i = 0; i < JOURNAL_ENTRIES + 5; i++) {
+        TestTimeControl::advanceTime(10);
+        journalRecord(JOURNAL_SWITCHES, 0, i);
+    }
+
+    ASSERT_EQ(journalImageCount(false), JOURNAL_ENTRIES, "Ring should hold the newest entries");
+    ASSERT_EQ(journalImageEntry(false, 0).data, 5u, "Oldest entries are overwritten first");
+    ASSERT_EQ(journalImageEntry(false, JOURNAL_ENTRIES - 1).data, JOURNAL_ENTRIES + 4,
+              "Newest entry is last");
+
+    ASSERT_EQ(journalImageByte(false, 0), 'K', "Image magic");
+    ASSERT_EQ(journalImageByte(false, 1), 'J', "Image magic");
+    ASSERT_EQ(journalImageByte(false, 2), JOURNAL_VERSION, "Image version");
+    ASSERT_EQ(journalImageByte(false, 3), JOURNAL_ENTRIES, "Image count");
+
+    // First entry: time 1060 = 0x0424, type, arg, data 5 little-endian
+    const uint8_t expected[] = { 0x24, 0x04, JOURNAL_SWITCHES, 0, 5, 0, 0, 0 };
+    for (int i = 0; i < JOURNAL_ENTRY_SIZE; i++) {
+        ASSERT_EQ(journalImageByte(false, JOURNAL_HEADER_SIZE + i), expected[i], "Entry byte layout");
+    }
+}
+
+void testEepromCopy(const TestCase& test) {
+    setupTestEnvironment();
+    ASSERT_EQ(journalImageCount(true), 0, "Cleared journal has no EEPROM copy");
+
+    journalRecord(JOURNAL_SWITCHES, 0, 0x3);
+    journalRecord(JOURNAL_SWITCHES, 0, 0);
+    saveJournal();
+    journalRecord(JOURNAL_SWITCHES, 0, 0x4);
+
+    ASSERT_EQ(journalImageCount(true), 2, "Saved copy keeps the entries at save time");
+    ASSERT_EQ(journalImageEntry(true, 0).data, 0x3u, "Saved entries in order");
+    for (uint16_t i = 0; i < JOURNAL_HEADER_SIZE + 2 * JOURNAL_ENTRY_SIZE; i++) {
+        ASSERT_EQ(EEPROM.read(JOURNAL_EEPROM_START + i), journalImageByte(true, i),
+                  "Copy lives in the reserved EEPROM tail");
+    }
+
+    // Configuration saves stay below the journal region
+    processCommand("MAP 0 \"a long enough macro to land somewhere in eeprom\"");
+    saveToStorage();
+    ASSERT_EQ(journalImageCount(true), 2, "Configuration save leaves the journal alone");
+
+    clearJournal();
+    ASSERT_EQ(journalImageCount(false), 0, "Clear empties the ring");
+    ASSERT_EQ(journalImageCount(true), 0, "Clear erases the EEPROM copy");
+    processCommand("MAP 0 \"\"");
+}
+
+void testOlderConfiguration(const TestCase& test) {
+    setupTestEnvironment();
+
+    // Saved before the journal: key 0's macro runs into the region
+    EEPROM.clear();
+    uint32_t magic = EEPROM_MAGIC_VALUE;
+    EEPROM.put(EEPROM_MAGIC_ADDR, magic);
+    uint16_t offset = EEPROM_DATA_START;
+    size_t length = JOURNAL_EEPROM_START + 10 - offset;
+    for (size_t i = 0; i < length; i++) EEPROM.write(offset++, 'a');
+    for (int i = 0; i < 2 * NUM_SWITCHES; i++) EEPROM.write(offset++, 0);
+
+    ASSERT_FALSE(journalRegionFree(), "Region holds configuration");
+    ASSERT_TRUE(loadFromStorage() > 0, "Read to the end of EEPROM");
+    ASSERT_EQ(strlen(macros[0].downMacro), length, "Macro not truncated");
+    ASSERT_FALSE(saveJournal(), "Journal save refused");
+    ASSERT_EQ(EEPROM.read(JOURNAL_EEPROM_START), 'a', "Configuration left intact");
+
+    processCommand("MAP 0 \"short\"");
+    ASSERT_TRUE(saveToStorage() > 0, "SAVE rewrites it below the region");
+    ASSERT_TRUE(journalRegionFree(), "Region handed to the journal");
+    ASSERT_TRUE(saveJournal(), "Journal saves again");
+    processCommand("MAP 0 \"\"");
+}
+
+//==============================================================================
+// CHORD EVENT TESTS
+//==============================================================================
+
+void testChordOutcomes(const TestCase& test) {
+    setupTestEnvironment();
+    processCommand("CHORD ADD 0+1 \"ab\"");
+
+    switchEdge(0x1, 10);
+    switchEdge(0x3, 10);
+    switchEdge(0x2, 10);
+    switchEdge(0x0, 10);
+    ASSERT_STR_EQ(Keyboard.toString(), "write a write b", "Chord should fire");
+    std::string log = journalLog();
+    ASSERT_STR_CONTAINS(log, "switches 0\nchord start 0\n", "Chord start recorded");
+    ASSERT_STR_CONTAINS(log, "chord 0+1 fired\nmacro 2 bytes 61 62\n", "Fired chord and its macro");
+
+    clearJournal();
+
+    switchEdge(0x1, 100);
+    switchEdge(0x0, 10);
+    ASSERT_STR_CONTAINS(journalLog(), "chord 0 undefined\n", "Chord without a macro recorded");
+
+    // Release, then re-press after the execution window closed
+    clearJournal();
+    switchEdge(0x3, 100);
+    switchEdge(0x1, 10);
+    switchEdge(0x3, 100);
+    switchEdge(0x0, 10);
+    ASSERT_STR_CONTAINS(journalLog(), "chord recapture 0+1\nswitches none\nchord 0+1 fired\n",
+                        "Recapture recorded");
+
+    clearJournal();
+    switchEdge(0x1, 100);
+    switchEdge(0x21, 10);
+    switchEdge(0x0, 10);
+    ASSERT_STR_CONTAINS(journalLog(), "chord cancel by 5\nswitches none\nchord 0 cancelled\n",
+                        "Cancellation recorded");
+}
+
+//==============================================================================
+// COMMAND AND DECODER TESTS
+//==============================================================================
+
+void testJournalCommand(const TestCase& test) {
+    setupTestEnvironment();
+    ASSERT_STR_CONTAINS(command("JOURNAL"), "Journal empty", "Empty ring");
+    ASSERT_STR_CONTAINS(command("JOURNAL SAVED"), "No saved journal", "No EEPROM copy");
+
+    switchEdge(0x5, 0);
+    switchEdge(0x0, 40);
+    std::string shown = command("JOURNAL");
+    ASSERT_STR_CONTAINS(shown, "+0ms switches 0+2", "Times relative to the oldest");
+    ASSERT_STR_CONTAINS(shown, "+40ms switches none", "Second edge");
+
+    ASSERT_STR_CONTAINS(command("JOURNAL SAVE"), "Saved 2 events", "SAVE reports the count");
+    ASSERT_STR_CONTAINS(command("JOURNAL SAVED"), "+40ms switches none", "Saved copy shown");
+
+    // The decoder skips the echoed prompt and reads the hex lines back
+    std::string dump = "keypad> JOURNAL DUMP\n" + command("JOURNAL DUMP SAVED") + "\nkeypad> ";
+    ASSERT_STR_CONTAINS(dump, "4B4A0102", "Dump starts with the image header");
+
+    std::vector<uint8_t> image;
+    std::vector<JournalEvent> events;
+    std::string error;
+    ASSERT_TRUE(parseJournalDump(dump, image, error), "Dump should parse");
+    ASSERT_TRUE(decodeJournalImage(image, events, error), error.c_str());
+    ASSERT_EQ(events.size(), 2u, "Both events decoded");
+    ASSERT_EQ(events[1].ms, 40u, "Times unwrapped from the oldest");
+    ASSERT_STR_EQ(journalToScript(events), "0 0+2\n40 NONE\n1040 EXIT\n", "Replay script");
+
+    image[3] = 3;
+    ASSERT_FALSE(decodeJournalImage(image, events, error), "Truncated image rejected");
+
+    ASSERT_STR_CONTAINS(command("JOURNAL CLEAR"), "Journal cleared", "CLEAR confirms");
+    ASSERT_STR_CONTAINS(command("JOURNAL BOGUS"), "Usage:", "Unknown subcommand shows usage");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Event Journal Tests" << std::endl;
+    std::cout << "===========================" << std::endl << std::endl;
+
+    setupStorage();
+    setupChording();
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Ring wrap and image", "", EXPECT_PASS), testRingWrap);
+    runner.runTest(TestCase("EEPROM copy", "", EXPECT_PASS), testEepromCopy);
+    runner.runTest(TestCase("Older configuration", "", EXPECT_PASS), testOlderConfiguration);
+    runner.runTest(TestCase("Chord outcomes", "", EXPECT_PASS), testChordOutcomes);
+    runner.runTest(TestCase("JOURNAL command and decoder", "", EXPECT_PASS), testJournalCommand);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
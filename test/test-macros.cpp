@@ -95,6 +95,8 @@ std::vector<TestCase> createAdvancedTests() {
         TestCase("Newline escape", "\"line1\\nline2\"", "\"line1\\nline2\""),
         TestCase("Tab escape", "\"text\\ttabbed\"", "\"text\\ttabbed\""),
         TestCase("All escapes", "\"\\n\\r\\t\\a\\e\\\"\\\\\"", "\"\\n\\r\\t\\a\\e\\\"\\\\\""),
+        TestCase("Backspace escape", "\"a\\bb\"", "\"a\\bb\""),
+        TestCase("Hex escape", "\"\\x0b\\x7e\"", "\"\\x0B~\""),
         
         // Mixed keywords and text
         // TestCase("Keyword with text", "CTRL \"abc\"", "+CTRL \"abc\" -CTRL"),
@@ -122,6 +124,8 @@ std::vector<TestCase> createErrorTests() {
         TestCase("Empty input", "", EXPECT_FAIL),
         TestCase("Modifier without key", "CTRL+SHIFT", EXPECT_FAIL),
         TestCase("Empty modifier", "+", EXPECT_FAIL),
+        TestCase("Escaped opcode without operand", "\"ab\\x1D\"", EXPECT_FAIL),
+        TestCase("Escaped function key", "\"\\x05\\x01\"", EXPECT_FAIL),
     };
 }
 
@@ -0,0 +1,227 @@
+/*
+ * Mouse Keys Testing
+ * Round-trips the mouse operations through the encoder and decoder, then
+ * runs the mouse task on the scheduler against the Mouse mock to check
+ * that motion is coalesced into at most one report per poll, clicks follow
+ * the motion before them, and held motion follows the acceleration curve
+ */
+
+#include "Arduino.h"
+#include "Mouse.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../macro-encode.h"
+#include "../macro-decode.h"
+#include "../macro-engine.h"
+#include "../mouse-keys.h"
+#include "../scheduler.h"
+
+#include <iostream>
+#include <cstring>
+#include <string>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+std::string encode(const char* command) {
+    MacroEncodeResult result = macroEncode(command);
+    std::string encoded = result.utf8Sequence ? result.utf8Sequence : "";
+    free(result.utf8Sequence);
+    return encoded;
+}
+
+bool rejected(const char* command) {
+    MacroEncodeResult result = macroEncode(command);
+    free(result.utf8Sequence);
+    return result.error != nullptr;
+}
+
+void run(const char* command) {
+    std::string encoded = encode(command);
+    executeUTF8Macro((const uint8_t*)encoded.c_str(), encoded.length());
+}
+
+// A key press as handleKeyEvent() runs it
+void pressKey(uint8_t key, const char* command) {
+    uint8_t outer = beginMouseKeyMacro(key);
+    run(command);
+    endMouseKeyMacro(outer);
+}
+
+// Loop passes every passUs, as loop() runs the scheduler
+void runFor(uint32_t ms, uint32_t passUs) {
+    uint32_t end = micros() + ms * 1000;
+    while ((int32_t)(micros() - end) < 0) {
+        runScheduler();
+        TestTimeControl::advanceMicros(passUs);
+    }
+}
+
+// Shortest gap between consecutive reports, in microseconds
+uint32_t minReportGap() {
+    const std::vector<MockMouse::Report>& reports = Mouse.getReports();
+    uint32_t gap = UINT32_MAX;
+    for (size_t i = 1; i < reports.size(); i++) {
+        if (reports[i].timeUs - reports[i - 1].timeUs < gap) gap = reports[i].timeUs - reports[i - 1].timeUs;
+    }
+    return gap;
+}
+
+int totalX() {
+    int x = 0;
+    for (const MockMouse::Report& report : Mouse.getReports()) x += report.x;
+    return x;
+}
+
+void setupTestEnvironment() {
+    static bool registered = false;
+    if (!registered) {
+        TestTimeControl::setTime(1000);
+        setupMouseKeys();
+        addTask("mouse", loopMouseKeys, MOUSE_PERIOD_US, MOUSE_BUDGET_US);
+        registered = true;
+    }
+    updateMouseKeys(0);
+    runFor(5, 100);
+    Mouse.clearReports();
+    resetMouseKeyStats();
+}
+
+//==============================================================================
+// ENCODING TESTS
+//==============================================================================
+
+void testRoundTrip(const TestCase& test) {
+    std::string encoded = encode("MOVE:10,-5 SCROLL:-3 CLICK MOUSEDOWN:LEFT+RIGHT MOUSEUP:middle CTRL CLICK:RIGHT MOVE:0,0");
+    ASSERT_EQ(encoded.size(), 18u, "Every operation and operand kept, no NUL");
+    ASSERT_EQ((uint8_t)encoded[0], UTF8_MOUSE_MOVE, "Move opcode");
+    ASSERT_EQ((uint8_t)encoded[2], UTF8_MOUSE_OFFSET - 5, "Negative offset stored above zero");
+
+    String decoded = macroDecode((const uint8_t*)encoded.c_str(), encoded.length());
+    ASSERT_STR_EQ(decoded.c_str(),
+                  "MOVE:10,-5 SCROLL:-3 CLICK:LEFT MOUSEDOWN:LEFT+RIGHT MOUSEUP:MIDDLE +CTRL CLICK:RIGHT -CTRL MOVE:0,0",
+                  "Decoded to canonical names");
+    ASSERT_TRUE(encode(decoded.c_str()) == encoded, "Decoded text encodes to the same bytes");
+
+    ASSERT_TRUE(rejected("MOVE:128,0"), "Offset out of range rejected");
+    ASSERT_TRUE(rejected("MOVE:3"), "Missing offset rejected");
+    ASSERT_TRUE(rejected("CLICK:THUMB"), "Unknown button rejected");
+}
+
+//==============================================================================
+// REPORT TESTS
+//==============================================================================
+
+void testCoalescing(const TestCase& test) {
+    setupTestEnvironment();
+
+    run("MOVE:10,0 MOVE:10,0 MOVE:10,5 SCROLL:1");
+    ASSERT_TRUE(Mouse.getReports().empty(), "Nothing sent while the macro runs");
+    runFor(3, 100);
+    ASSERT_STR_EQ(Mouse.toString(), "move 30,5 scroll 1", "Four steps in one report");
+    ASSERT_EQ(mouseKeyStats().steps, 4u, "Steps counted");
+
+    // 2000 pixels need 16 reports of at most 127, one per poll
+    Mouse.clearReports();
+    std::string command;
+    for (int i = 0; i < 20; i++) command += "MOVE:100,0 ";
+    run(command.c_str());
+    runFor(30, 100);
+    ASSERT_EQ(Mouse.getReports().size(), 16u, "Split over full reports");
+    ASSERT_EQ(totalX(), 2000, "No motion lost");
+    ASSERT_TRUE(minReportGap() >= MOUSE_PERIOD_US, "At most one report per poll");
+}
+
+void testClickAfterMotion(const TestCase& test) {
+    setupTestEnvironment();
+
+    run("MOVE:5,5 CLICK MOUSEDOWN:RIGHT MOVE:20,0");
+    ASSERT_STR_EQ(Mouse.toString(), "move 5,5; buttons left; buttons none; buttons right",
+                  "Motion sent before the click, drag motion left pending");
+    runFor(2, 100);
+    ASSERT_STR_CONTAINS(Mouse.toString(), "buttons right; move 20,0", "Drag motion in the next poll");
+    run("MOUSEUP:RIGHT");
+
+    // All pending motion goes out before a click, even past one report
+    Mouse.clearReports();
+    run("MOVE:100,0 MOVE:100,0 CLICK");
+    ASSERT_STR_EQ(Mouse.toString(), "move 127,0; move 73,0; buttons left; buttons none",
+                  "Whole move before the click");
+    runFor(2, 100);
+    ASSERT_STR_EQ(Mouse.toString(), "move 127,0; move 73,0; buttons left; buttons none",
+                  "Nothing left for the next poll");
+
+    // An abort lets go of the dragged button
+    Mouse.clearReports();
+    macroPollHook = []() { abortMacro(); };
+    run("MOUSEDOWN:LEFT \"x\"");
+    macroPollHook = nullptr;
+    ASSERT_FALSE(Mouse.isPressed(MOUSE_LEFT), "Aborted macro's button released");
+}
+
+void testHeldMotion(const TestCase& test) {
+    setupTestEnvironment();
+
+    ASSERT_EQ(mouseStepRate(MOUSE_DELAY_MS - 1), 0, "Nothing before the delay");
+    ASSERT_EQ(mouseStepRate(MOUSE_DELAY_MS), MOUSE_MIN_RATE, "Starts at the minimum rate");
+    uint16_t half = mouseStepRate(MOUSE_DELAY_MS + MOUSE_ACCEL_MS / 2);
+    ASSERT_TRUE(half > MOUSE_MIN_RATE && half < (MOUSE_MIN_RATE + MOUSE_MAX_RATE) / 2, "Quadratic ramp");
+    ASSERT_EQ(mouseStepRate(MOUSE_DELAY_MS + MOUSE_ACCEL_MS), MOUSE_MAX_RATE, "Full rate after the ramp");
+
+    pressKey(2, "MOVE:4,0");
+    updateMouseKeys(0x04);
+    runFor(MOUSE_DELAY_MS - 10, 100);
+    ASSERT_EQ(totalX(), 4, "First step at once, then a pause");
+
+    runFor(MOUSE_ACCEL_MS + 10, 100);
+    // 4 px steps along MIN + (MAX - MIN) t^2 over the ramp: 4 * (20 + 230 / 3)
+    int ramp = totalX() - 4;
+    ASSERT_TRUE(ramp > 370 && ramp < 410, "Distance follows the curve");
+
+    Mouse.clearReports();
+    runFor(100, 100);
+    ASSERT_EQ(Mouse.getReports().size(), 100u, "A report every poll at full speed");
+    ASSERT_TRUE(minReportGap() >= MOUSE_PERIOD_US, "Never two in one poll");
+    ASSERT_EQ(totalX(), 100 * 4 * MOUSE_MAX_RATE / 1000, "Full speed");
+
+    updateMouseKeys(0);
+    Mouse.clearReports();
+    runFor(50, 100);
+    ASSERT_TRUE(Mouse.getReports().empty(), "Stops with the key");
+
+    // A chord or release macro moves once
+    run("MOVE:4,0");
+    runFor(MOUSE_DELAY_MS + 100, 100);
+    ASSERT_EQ(totalX(), 4, "Not held outside a press macro");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Mouse Keys Tests" << std::endl;
+    std::cout << "========================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Encode and decode", "", EXPECT_PASS), testRoundTrip);
+    runner.runTest(TestCase("Coalescing", "", EXPECT_PASS), testCoalescing);
+    runner.runTest(TestCase("Click after motion", "", EXPECT_PASS), testClickAfterMotion);
+    runner.runTest(TestCase("Held motion", "", EXPECT_PASS), testHeldMotion);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
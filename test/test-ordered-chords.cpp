@@ -0,0 +1,189 @@
+/*
+ * Ordered Chord Testing
+ * Plays the same keys in different orders and checks that pressed-first
+ * and released-first chords fire over the unordered one, that keys changing
+ * in one scan fall back to it, and the key list syntax through CHORD
+ * commands and EEPROM
+ */
+
+#include "Arduino.h"
+#include "Keyboard.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../chording.h"
+#include "../builtin-profile.h"
+#include "../macro-encode.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+void addTestChord(uint32_t keyMask, const char* macroCommand) {
+    MacroEncodeResult result = macroEncode(macroCommand);
+    if (result.error == nullptr) {
+        chording.addChord(keyMask, result.utf8Sequence);
+        free(result.utf8Sequence);
+    }
+}
+
+// Switch states 10ms apart, ending with all released; returns what was typed
+std::string play(const std::vector<uint32_t>& states) {
+    Keyboard.clearActions();
+    for (uint32_t state : states) {
+        chording.processChording(state);
+        TestTimeControl::advanceTime(10);
+    }
+    chording.processChording(0);
+    return Keyboard.toString();
+}
+
+std::string command(const char* text) {
+    Serial.clear();
+    processCommand(text);
+    return Serial.getFullOutput();
+}
+
+void setupTestEnvironment() {
+    TestTimeControl::setTime(1000);
+    chording.clearAllChords();
+    chording.clearAllModifiers();
+    chording.setBuiltinChords(nullptr, 0);
+    chording.setCorrection(false);
+    chording.processChording(0);
+
+    addTestChord(0x03, "\"a\"");                                // 0+1
+    addTestChord(orderedChordKey(0x03, 0, false), "\"b\"");     // 0>1
+    addTestChord(orderedChordKey(0x03, 1, false), "\"c\"");     // 1>0
+}
+
+//==============================================================================
+// ORDER TESTS
+//==============================================================================
+
+void testKeySyntax(const TestCase& test) {
+    uint32_t key = parseChordKeys("2>0+1");
+    ASSERT_EQ(key, orderedChordKey(0x07, 2, false), "Lead key pressed first");
+    ASSERT_STR_EQ(formatKeyMask(key).c_str(), "2>0+1", "Formatted back");
+
+    key = parseChordKeys("3^1,5");
+    ASSERT_EQ(key, orderedChordKey(0x2A, 3, true), "Lead key released first");
+    ASSERT_STR_EQ(formatKeyMask(key).c_str(), "3^1+5", "Formatted back");
+
+    ASSERT_EQ(parseChordKeys("0+1"), 0x03u, "Unordered list unchanged");
+    ASSERT_EQ(parseChordKeys("2>2+1"), 0u, "Lead key listed twice");
+    ASSERT_EQ(parseChordKeys("2>"), 0u, "Lead key alone");
+    ASSERT_EQ(parseChordKeys(">0+1"), 0u, "No lead key");
+    ASSERT_EQ(parseChordKeys("9>0"), 0u, "Lead key out of range");
+}
+
+void testPressOrder(const TestCase& test) {
+    setupTestEnvironment();
+
+    ASSERT_STR_EQ(play({0x01, 0x03}), "write b", "0 then 1");
+    ASSERT_STR_EQ(play({0x02, 0x03}), "write c", "1 then 0");
+    ASSERT_STR_EQ(play({0x03}), "write a", "Same scan has no order");
+
+    // Extra key: the lead must be part of the chord actually played
+    addTestChord(0x07, "\"d\"");
+    ASSERT_STR_EQ(play({0x01, 0x07}), "write d", "0>1 does not cover 0+1+2");
+
+    chording.removeChord(0x03);
+    ASSERT_STR_EQ(play({0x01, 0x03}), "write b", "Ordered chord without the unordered one");
+    ASSERT_STR_EQ(play({0x03}), "", "Nothing to fall back to");
+}
+
+void testReleaseOrder(const TestCase& test) {
+    setupTestEnvironment();
+    chording.removeChord(orderedChordKey(0x03, 0, false));
+    chording.removeChord(orderedChordKey(0x03, 1, false));
+    addTestChord(orderedChordKey(0x03, 0, true), "\"e\"");   // 0^1
+
+    ASSERT_STR_EQ(play({0x03, 0x02}), "write e", "0 released first");
+    ASSERT_STR_EQ(play({0x03, 0x01}), "write a", "1 released first");
+    ASSERT_STR_EQ(play({0x03}), "write a", "Released in one scan");
+
+    addTestChord(orderedChordKey(0x03, 1, false), "\"c\"");
+    ASSERT_STR_EQ(play({0x02, 0x03, 0x02}), "write c", "Press order wins over release order");
+    ASSERT_STR_EQ(play({0x01, 0x03, 0x02}), "write e", "Release order when no press order matches");
+}
+
+void testCommandsAndStorage(const TestCase& test) {
+    setupTestEnvironment();
+    chording.clearAllChords();
+    command("CHORD MODIFIERS CLEAR");
+
+    ASSERT_STR_CONTAINS(command("CHORD ADD 2>0+1 \"x\""), "Chord 2>0+1 added", "Ordered chord added");
+    ASSERT_STR_CONTAINS(command("CHORD ADD 0+1+2 \"y\""), "added", "Same keys unordered");
+    ASSERT_STR_CONTAINS(command("CHORD ADD 2>1+0 \"z\""), "already defined", "Same ordered chord");
+    ASSERT_STR_CONTAINS(command("CHORD ADD 1>1 \"z\""), "Invalid key list", "Bad ordered list");
+
+    uint64_t hash = chording.getChordHash();
+    command("SAVE");
+    chording.clearAllChords();
+    command("LOAD");
+    ASSERT_EQ(chording.getChordHash(), hash, "Ordered chord reloaded from EEPROM");
+    ASSERT_STR_CONTAINS(command("CHORD LIST"), "  2>0+1: \"x\"", "Listed with its order");
+
+    ASSERT_STR_CONTAINS(command("CHORD REMOVE 2>0+1"), "Chord 2>0+1 removed", "Removed by key list");
+    ASSERT_TRUE(chording.isChordDefined(0x07), "Unordered chord kept");
+
+    // Correction indexes key masks only
+    addTestChord(orderedChordKey(0x18, 3, false), "\"w\"");
+    ASSERT_TRUE(chording.setCorrection(true), "Index built with ordered chords present");
+    ASSERT_STR_EQ(play({0x0F}), "write y", "Unordered neighbour corrected");
+    chording.setCorrection(false);
+}
+
+void testBuiltinOrder(const TestCase& test) {
+    setupTestEnvironment();
+    static const char BUILTIN_Z[] = "z";
+    static const BuiltinChord BUILTINS[] = {
+        {orderedChordKey(0x30, 4, false), BUILTIN_Z},     // 4>5
+    };
+    chording.setBuiltinChords(BUILTINS, 1);
+    addTestChord(0x30, "\"u\"");                           // 4+5
+
+    ASSERT_STR_EQ(play({0x10, 0x30}), "write z", "Built-in ordered chord beats unordered one");
+    ASSERT_STR_EQ(play({0x20, 0x30}), "write u", "Other order falls back");
+
+    addTestChord(orderedChordKey(0x30, 4, false), "\"v\"");
+    ASSERT_STR_EQ(play({0x10, 0x30}), "write v", "Own ordered chord overrides the built-in one");
+    chording.setBuiltinChords(nullptr, 0);
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Ordered Chord Tests" << std::endl;
+    std::cout << "===========================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Key list syntax", "", EXPECT_PASS), testKeySyntax);
+    runner.runTest(TestCase("Press order", "", EXPECT_PASS), testPressOrder);
+    runner.runTest(TestCase("Release order", "", EXPECT_PASS), testReleaseOrder);
+    runner.runTest(TestCase("Built-in ordered chords", "", EXPECT_PASS), testBuiltinOrder);
+    runner.runTest(TestCase("Commands and storage", "", EXPECT_PASS), testCommandsAndStorage);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/*
+ * Macro Preemption Testing
+ * Drives the executor's poll hook to abort a running macro and to run a
+ * priority macro inside one, checking the keyboard actions and that
+ * modifiers are released and restored, plus the PREEMPT command
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../macro-encode.h"
+#include "../macro-engine.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+#include <string>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+static int polls = 0;
+static int actAtPoll = 0;             // Poll on which the hook acts
+static std::string nestedMacro;       // Run by the hook; empty = abort instead
+
+void testPollHook() {
+    if (++polls != actAtPoll) return;
+    if (nestedMacro.empty()) {
+        abortMacro();
+    } else {
+        executeUTF8Macro((const uint8_t*)nestedMacro.c_str(), nestedMacro.length());
+    }
+}
+
+std::string encode(const char* command) {
+    MacroEncodeResult result = macroEncode(command);
+    std::string encoded = result.utf8Sequence ? result.utf8Sequence : "";
+    free(result.utf8Sequence);
+    return encoded;
+}
+
+std::string run(const char* command) {
+    std::string encoded = encode(command);
+    Keyboard.clearActions();
+    executeUTF8Macro((const uint8_t*)encoded.c_str(), encoded.length());
+    return Keyboard.toString();
+}
+
+void setupTestEnvironment(int poll, const char* nested) {
+    macroPollHook = testPollHook;
+    polls = 0;
+    actAtPoll = poll;
+    nestedMacro = nested ? encode(nested) : "";
+    resetMacroPreemptStats();
+}
+
+//==============================================================================
+// PREEMPTION TESTS
+//==============================================================================
+
+void testAbort(const TestCase& test) {
+    setupTestEnvironment(3, nullptr);
+
+    std::string actions = run("+CTRL \"abcdef\"");
+    ASSERT_STR_EQ(actions, "press ctrl write a write b release ctrl",
+                  "Stops before the third action and releases ctrl");
+    ASSERT_EQ(macroPreemptStats().aborts, 1, "Abort counted");
+    ASSERT_FALSE(isMacroRunning(), "Nothing running after abort");
+
+    // The next macro runs in full
+    actAtPoll = 0;
+    actions = run("\"xy\"");
+    ASSERT_STR_EQ(actions, "write x write y", "Abort does not stick");
+}
+
+void testPriorityMacro(const TestCase& test) {
+    setupTestEnvironment(2, "CTRL C");
+
+    std::string actions = run("+SHIFT \"abc\" -SHIFT");
+    ASSERT_STR_EQ(actions,
+                  "press shift write a release shift "
+                  "press ctrl write c release ctrl "
+                  "press shift write b write c release shift",
+                  "Shift lifted for the priority macro and pressed again");
+    ASSERT_EQ(macroPreemptStats().preemptions, 1, "Preemption counted");
+}
+
+void testAbortAfterPreemption(const TestCase& test) {
+    setupTestEnvironment(2, "+ALT");
+
+    // The priority macro leaves alt held; the abort releases it too
+    std::string actions = run("+SHIFT \"abc\"");
+    ASSERT_STR_CONTAINS(actions, "release shift press alt release alt press shift",
+                        "Alt released, shift restored after the priority macro");
+
+    setupTestEnvironment(3, nullptr);
+    actions = run("+CTRL +SHIFT \"ab\"");
+    ASSERT_STR_EQ(actions, "press ctrl press shift write a release ctrl release shift",
+                  "Both held modifiers released on abort");
+}
+
+void testPreemptCommand(const TestCase& test) {
+    macroPollHook = nullptr;
+
+    Serial.clear();
+    processCommand("PREEMPT ABORT 0,8");
+    ASSERT_EQ(macroAbortKeys, 0x101u, "Abort gesture set");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Abort keys: 0+8", "Gesture shown");
+
+    processCommand("PREEMPT PRIORITY 3");
+    ASSERT_EQ(macroPriorityKeys, 0x08u, "Priority keys set");
+
+    Serial.clear();
+    processCommand("PREEMPT ABORT NONE");
+    ASSERT_EQ(macroAbortKeys, 0u, "Gesture cleared");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Priority keys: 3", "Priority keys kept");
+
+    Serial.clear();
+    processCommand("PREEMPT PRIORITY x");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Invalid key list", "Bad list rejected");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Macro Preemption Tests" << std::endl;
+    std::cout << "==============================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Abort", "", EXPECT_PASS), testAbort);
+    runner.runTest(TestCase("Priority macro", "", EXPECT_PASS), testPriorityMacro);
+    runner.runTest(TestCase("Abort after preemption", "", EXPECT_PASS), testAbortAfterPreemption);
+    runner.runTest(TestCase("PREEMPT command", "", EXPECT_PASS), testPreemptCommand);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
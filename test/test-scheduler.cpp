@@ -0,0 +1,180 @@
+/*
+ * Task Scheduler Testing
+ * Runs tasks against controlled time and checks fixed-rate due times,
+ * input task priority and yields, overrun and missed-period accounting,
+ * and the TASKS report
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../scheduler.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+static std::string order;
+static uint32_t inputCost = 0;
+static uint32_t workCost = 0;
+static int workYields = 0;
+
+void inputTask() {
+    order += "I";
+    TestTimeControl::advanceMicros(inputCost);
+}
+
+// Long work that yields between steps, like EEPROM writes
+void workTask() {
+    order += "W";
+    for (int i = 0; i <= workYields; i++) {
+        TestTimeControl::advanceMicros(workCost);
+        if (i < workYields) schedulerYield();
+    }
+}
+
+void otherTask() {
+    order += "O";
+}
+
+// Registered once: tasks cannot be removed, so tests share these three and
+// time only moves forward
+void setupTestEnvironment() {
+    static bool registered = false;
+    if (!registered) {
+        TestTimeControl::setTime(1000);
+        addTask("input", inputTask, 1000, 200);
+        addTask("work", workTask, 5000, 2000);
+        addTask("other", otherTask, 5000, 100);
+        registered = true;
+    }
+    order.clear();
+    inputCost = 0;
+    workCost = 0;
+    workYields = 0;
+    resetSchedulerStats();
+}
+
+// Run loop() passes every 100us for the given time
+void runFor(uint32_t us) {
+    uint32_t end = micros() + us;
+    while ((int32_t)(micros() - end) < 0) {
+        runScheduler();
+        TestTimeControl::advanceMicros(100);
+    }
+}
+
+//==============================================================================
+// SCHEDULING TESTS
+//==============================================================================
+
+void testFixedRate(const TestCase& test) {
+    setupTestEnvironment();
+    runFor(1000);           // Align every task to a fresh due time
+    order.clear();
+    resetSchedulerStats();
+
+    runFor(10000);
+    ASSERT_EQ(schedulerTask(0).runs, 10u, "Input runs every 1000us");
+    ASSERT_EQ(schedulerTask(1).runs, 2u, "Work runs every 5000us");
+    ASSERT_EQ(schedulerTask(0).missed, 0, "Nothing falls behind");
+    ASSERT_TRUE(schedulerTask(0).maxLateUs < 100, "Input starts within one loop pass");
+
+    inputCost = 50;
+    runFor(10000);
+    ASSERT_EQ(schedulerTask(0).runs, 20u, "Run time does not stretch the period");
+    ASSERT_EQ(schedulerTask(0).overruns, 0, "50us fits the 200us budget");
+}
+
+void testInputPriority(const TestCase& test) {
+    setupTestEnvironment();
+    runFor(5000);
+    order.clear();
+
+    // Work overruns by far; input is due again before other gets its turn
+    workCost = 1500;
+    TestTimeControl::advanceMicros(5000);
+    runScheduler();
+    ASSERT_STR_EQ(order, "IWIO", "Input runs first and again after each task");
+    ASSERT_EQ(schedulerTask(1).overruns, 0, "1500us is within the work budget");
+
+    workCost = 3000;
+    runFor(5000);
+    ASSERT_EQ(schedulerTask(1).overruns, 1, "3000us overruns the work budget");
+    ASSERT_TRUE(schedulerTask(1).maxRunUs >= 3000, "Longest run recorded");
+    ASSERT_TRUE(schedulerTask(0).maxLateUs >= 2000, "Input was held up by the work task");
+}
+
+void testYieldAndMissed(const TestCase& test) {
+    setupTestEnvironment();
+    runFor(5000);
+    order.clear();
+    resetSchedulerStats();
+
+    // Ten 1ms steps: input gets in at each yield instead of waiting 10ms
+    workCost = 1000;
+    workYields = 9;
+    runFor(5000);
+    ASSERT_STR_CONTAINS(order, "WIIIIIIIII", "Input runs at each of work's yields");
+    ASSERT_TRUE(schedulerTask(0).maxLateUs <= 1100, "Input never waits more than a step");
+    ASSERT_TRUE(schedulerTask(1).missed >= 1, "Work fell a period behind");
+
+    // Yield from inside the input task must not re-enter it
+    order.clear();
+    workYields = 0;
+    TestTimeControl::advanceMicros(5000);
+    schedulerYield();
+    schedulerYield();
+    ASSERT_STR_EQ(order, "I", "Yield runs input once when due");
+}
+
+void testTasksCommand(const TestCase& test) {
+    setupTestEnvironment();
+    runFor(3000);
+
+    Serial.clear();
+    processCommand("TASKS");
+    std::string report = Serial.getFullOutput();
+    ASSERT_STR_CONTAINS(report, "Task      Period  Budget    Runs", "Header");
+    ASSERT_STR_CONTAINS(report, "\ninput       1000     200", "Input row");
+    ASSERT_STR_CONTAINS(report, "\nwork        5000    2000", "Work row");
+
+    Serial.clear();
+    processCommand("TASKS RESET");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Task statistics reset", "RESET confirms");
+    ASSERT_EQ(schedulerTask(0).runs, 0u, "RESET clears counts");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Task Scheduler Tests" << std::endl;
+    std::cout << "============================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Fixed rate", "", EXPECT_PASS), testFixedRate);
+    runner.runTest(TestCase("Input priority", "", EXPECT_PASS), testInputPriority);
+    runner.runTest(TestCase("Yield and missed periods", "", EXPECT_PASS), testYieldAndMissed);
+    runner.runTest(TestCase("TASKS command", "", EXPECT_PASS), testTasksCommand);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
@@ -299,6 +299,25 @@ void testStatCommand(const TestCase& test) {
     ASSERT_STR_CONTAINS(output, "0x", "Should show hex switch state");
 }
 
+void testBenchCommand(const TestCase& test) {
+    setupTestEnvironment();
+    TestTimeControl::useRealTime();
+    Keyboard.clearActions();
+    Serial.clear();
+    
+    processCommand("BENCH");
+    
+    std::string output = Serial.getFullOutput();
+    ASSERT_STR_CONTAINS(output, "Benchmark (", "BENCH should show a header");
+    ASSERT_STR_CONTAINS(output, "encode: ", "BENCH should time encoding");
+    ASSERT_STR_CONTAINS(output, "decode: ", "BENCH should time decoding");
+    ASSERT_STR_CONTAINS(output, "chord lookup: ", "BENCH should time chord lookup");
+    ASSERT_STR_CONTAINS(output, "switch scan: ", "BENCH should time the switch scan");
+    ASSERT_STR_CONTAINS(output, "execute (dry run): ", "BENCH should time execution");
+    ASSERT_STR_CONTAINS(output, " us/op", "BENCH should report per operation");
+    ASSERT_TRUE(Keyboard.getActions().empty(), "Dry run should not send keys");
+}
+
 //==============================================================================
 // ERROR HANDLING TESTS
 //==============================================================================
@@ -542,6 +561,8 @@ int main(int argc, char* argv[]) {
     std::cout << std::endl << "STAT Command Tests:" << std::endl;
     TestCase statTest("STAT command", "STAT", "STAT_OUTPUT");
     runner.runTest(statTest, testStatCommand);
+    TestCase benchTest("BENCH command", "BENCH", "BENCH_OUTPUT");
+    runner.runTest(benchTest, testBenchCommand);
     
     std::cout << std::endl << "Error Handling Tests:" << std::endl;
     auto errorTests = createErrorHandlingTests();
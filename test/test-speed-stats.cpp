@@ -0,0 +1,183 @@
+/*
+ * Typing Speed Telemetry Testing
+ * Types through the macro executor and chords through the chord engine on
+ * controlled time, then checks the windowed counts, rates, how old buckets
+ * leave the window, the trace hook and the SPEED command
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../speed-stats.h"
+#include "../journal.h"
+#include "../chording.h"
+#include "../macro-encode.h"
+#include "../macro-engine.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+static std::vector<uint32_t> traced;
+
+void traceHook(bool gesture, uint32_t data) {
+    traced.push_back(gesture ? data : data | 0x80000000);
+}
+
+void type(const char* command) {
+    MacroEncodeResult encoded = macroEncode(command);
+    executeUTF8Macro((const uint8_t*)encoded.utf8Sequence, strlen(encoded.utf8Sequence));
+    free(encoded.utf8Sequence);
+}
+
+// Press keys, hold for holdMs, release them all
+void chord(uint32_t keys, uint32_t holdMs) {
+    chording.processChording(keys);
+    TestTimeControl::advanceTime(holdMs);
+    chording.processChording(0);
+}
+
+void setupTestEnvironment() {
+    TestTimeControl::setTime(100000);
+    resetSpeedStats();
+    traced.clear();
+    speedTraceHook = traceHook;
+
+    MacroEncodeResult encoded = macroEncode("\"the \"");
+    chording.clearAllChords();
+    chording.addChord(0x03, encoded.utf8Sequence);
+    free(encoded.utf8Sequence);
+    Keyboard.clearActions();
+}
+
+//==============================================================================
+// COUNTER TESTS
+//==============================================================================
+
+void testCharsAndChords(const TestCase& test) {
+    setupTestEnvironment();
+
+    type("\"hello\" +CTRL -CTRL F5");
+    chord(0x03, 40);
+    TestTimeControl::advanceTime(1000);
+    chord(0x01, 20);                    // Undefined
+    chording.processChording(0x01);     // Cancelled by key 5
+    chording.processChording(0x21);
+    TestTimeControl::advanceTime(60);
+    chording.processChording(0);
+    TestTimeControl::advanceTime(1880);
+
+    SpeedWindow window = speedWindow(SPEED_WINDOW_MS);
+    ASSERT_EQ(window.spanMs, 3000u, "Span limited to the time since reset");
+    ASSERT_EQ(window.chars, 9u, "Written characters counted, not modifiers or F keys");
+    ASSERT_EQ(window.chords, 1, "Only the fired chord counted as a chord");
+    ASSERT_EQ(window.gestures, 3, "Every gesture counted");
+    ASSERT_EQ(window.cancelled, 1, "Cancellation counted");
+    ASSERT_EQ(window.gestureMs, 120u, "Gesture durations summed");
+
+    ASSERT_EQ(traced.size(), 5u, "Two macros and three gestures traced");
+    ASSERT_EQ(traced[0], 0x80000005u, "First macro typed 5");
+    ASSERT_EQ(traced[1], ((uint32_t)JOURNAL_CHORD_FIRED << 24) | 40, "Fired gesture traced");
+    ASSERT_EQ(traced[2], 0x80000004u, "Then the chord macro typed 4");
+    ASSERT_EQ(traced[4], ((uint32_t)JOURNAL_CHORD_CANCELLED << 24) | 60, "Cancelled gesture traced");
+}
+
+void testGestureAfterCancellation(const TestCase& test) {
+    setupTestEnvironment();
+
+    chording.processChording(0x01);
+    chording.processChording(0x21);     // Cancelled by key 5
+    TestTimeControl::advanceTime(CHORD_CANCELLATION_TIMEOUT_MS + 100);
+    chording.processChording(0x01);     // Timed out: building again from key 0
+    TestTimeControl::advanceTime(10);
+    chording.processChording(0x03);
+    TestTimeControl::advanceTime(30);
+    chording.processChording(0);
+
+    ASSERT_EQ(traced.size(), 2u, "Fired gesture and its macro traced");
+    ASSERT_EQ(traced[0], ((uint32_t)JOURNAL_CHORD_FIRED << 24) | 40,
+              "Gesture timed from the return to building, not the first press");
+}
+
+void testSlidingWindow(const TestCase& test) {
+    setupTestEnvironment();
+
+    type("\"abcd\"");
+    TestTimeControl::advanceTime(SPEED_BUCKET_MS * 3);
+    type("\"xy\"");
+
+    SpeedWindow recent = speedWindow(10000);
+    SpeedWindow minute = speedWindow(SPEED_WINDOW_MS);
+    ASSERT_EQ(recent.chars, 2u, "Old bucket outside the short window");
+    ASSERT_EQ(recent.spanMs, (uint32_t)SPEED_BUCKET_MS, "Short window spans the buckets summed");
+    ASSERT_EQ(minute.chars, 6u, "Both in the long window");
+
+    TestTimeControl::advanceTime(SPEED_WINDOW_MS - SPEED_BUCKET_MS);
+    minute = speedWindow(SPEED_WINDOW_MS);
+    ASSERT_EQ(minute.chars, 2u, "Oldest bucket has slid out");
+
+    TestTimeControl::advanceTime(SPEED_WINDOW_MS * 10);
+    minute = speedWindow(SPEED_WINDOW_MS);
+    ASSERT_EQ(minute.chars, 0u, "Long idle empties the ring");
+    ASSERT_EQ(minute.spanMs, (uint32_t)(SPEED_WINDOW_MS - SPEED_BUCKET_MS),
+              "Window reaches back over the whole ring, newest bucket just started");
+}
+
+void testSpeedCommand(const TestCase& test) {
+    setupTestEnvironment();
+    speedTraceHook = nullptr;
+
+    // 160 characters and 20 chords in 10 seconds: 192 WPM, 120 chords/min
+    for (int i = 0; i < 20; i++) {
+        type("\"abcd\"");
+        chord(0x03, 50);
+        TestTimeControl::advanceTime(450);
+    }
+
+    Serial.clear();
+    processCommand("SPEED");
+    std::string output = Serial.getFullOutput();
+    ASSERT_STR_CONTAINS(output, "Last 5s: 80 chars, 192 WPM, 120 chords/min, 0/10 gestures cancelled, avg gesture 50ms",
+                        "Short window covers the last full bucket");
+    ASSERT_STR_CONTAINS(output, "Last 10s: 160 chars, 192 WPM, 120 chords/min, 0/20 gestures cancelled",
+                        "Long window limited to the time since reset");
+
+    processCommand("SPEED RESET");
+    ASSERT_EQ(speedWindow(SPEED_WINDOW_MS).chars, 0u, "Reset clears counts");
+    TestTimeControl::useRealTime();
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Typing Speed Telemetry Tests" << std::endl;
+    std::cout << "====================================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Characters and chords", "", EXPECT_PASS), testCharsAndChords);
+    runner.runTest(TestCase("Gesture after cancellation", "", EXPECT_PASS), testGestureAfterCancellation);
+    runner.runTest(TestCase("Sliding window", "", EXPECT_PASS), testSlidingWindow);
+    runner.runTest(TestCase("SPEED command", "", EXPECT_PASS), testSpeedCommand);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
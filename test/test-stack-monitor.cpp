@@ -0,0 +1,106 @@
+/*
+ * Stack Monitor Testing
+ * Checks the painted high-water mark against known stack use, per-command
+ * peaks recorded through processCommand, and the STAT report
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../stack-monitor.h"
+#include "../macro-encode.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+std::string command(const char* cmd) {
+    Serial.clear();
+    processCommand(cmd);
+    return Serial.getFullOutput();
+}
+
+// Well past anything the host C library uses, inside the host window
+#define DEEP_BYTES 20000
+
+// Touches the bottom of a buffer of the given size
+void __attribute__((noinline)) useStack(size_t bytes) {
+    volatile uint8_t buffer[DEEP_BYTES + 64];
+    buffer[sizeof(buffer) - bytes] = 0;
+}
+
+//==============================================================================
+// MEASUREMENT TESTS
+//==============================================================================
+
+void testHighWaterMark(const TestCase& test) {
+    uint16_t before = stackPeak();
+    ASSERT_TRUE(before < DEEP_BYTES, "Nothing deep has run yet");
+
+    useStack(DEEP_BYTES);
+    uint16_t after = stackPeak();
+    ASSERT_TRUE(after >= DEEP_BYTES, "Peak covers the deepest write");
+    ASSERT_TRUE(after < DEEP_BYTES + 4096, "Peak stays close to the deepest write");
+    ASSERT_TRUE(stackMinFree() <= 32768 - DEEP_BYTES, "Free gap shrinks with use");
+
+    useStack(100);
+    ASSERT_EQ(stackPeak(), after, "Peak never drops");
+}
+
+void testCommandPeaks(const TestCase& test) {
+    useStack(DEEP_BYTES);
+    command("MAP 0 \"a\"");
+    command("SHOW 0");
+    command("MAP 0 \"bc\"");
+    command("BOGUS");
+
+    ASSERT_EQ(stackCommandCount(), 2, "Known commands get one slot each");
+    ASSERT_STR_EQ(stackCommandName(0), "MAP", "First slot");
+    ASSERT_STR_EQ(stackCommandName(1), "SHOW", "Second slot");
+    ASSERT_TRUE(stackCommandPeak(0) >= MAX_MACRO_LENGTH, "MAP includes the encode buffer");
+    ASSERT_TRUE(stackCommandPeak(0) < DEEP_BYTES, "Stack used between commands is not charged to them");
+    ASSERT_TRUE(stackPeak() >= DEEP_BYTES, "but still counts toward the overall peak");
+}
+
+void testStatReport(const TestCase& test) {
+    std::string stat = command("STAT");
+    ASSERT_STR_CONTAINS(stat, "Stack: peak ", "Overall peak reported");
+    ASSERT_STR_CONTAINS(stat, " bytes, min free ", "Free gap reported");
+    ASSERT_STR_CONTAINS(stat, "Command stack: MAP ", "Per-command peaks reported");
+    ASSERT_STR_CONTAINS(command("STAT"), ", STAT ", "STAT records itself");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Stack Monitor Tests" << std::endl;
+    std::cout << "===========================" << std::endl << std::endl;
+
+    setupStackMonitor();
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("High-water mark", "", EXPECT_PASS), testHighWaterMark);
+    runner.runTest(TestCase("Command peaks", "", EXPECT_PASS), testCommandPeaks);
+    runner.runTest(TestCase("STAT report", "", EXPECT_PASS), testStatReport);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
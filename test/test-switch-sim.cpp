@@ -0,0 +1,211 @@
+/*
+ * Switch Input Simulation Testing
+ * Drives SIM timelines through a host copy of the loop() switch path and
+ * checks step injection, roll expansion and per-step latency reporting
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../macro-engine.h"
+#include "../macro-encode.h"
+#include "../storage.h"
+#include "../chording.h"
+#include "../builtin-profile.h"
+#include "../switch-sim.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+#define LOOP_PASS_US 200        // Simulated loop() period
+#define SCAN_US      50         // Time from switch read to chord processing
+
+static uint32_t lastSwitchState = 0;
+
+// Host copy of the loop() switch path in keypaddle.ino
+void loopPass() {
+    uint32_t current = simSwitches(loopSwitches());
+    TestTimeControl::advanceMicros(SCAN_US);
+
+    if (current != lastSwitchState) {
+        if (!processChording(current)) {
+            uint32_t changed = current ^ lastSwitchState;
+            for (int i = 0; i < NUM_SWITCHES; i++) {
+                if (!(changed & (1UL << i))) continue;
+                bool up = !(current & (1UL << i));
+                char* macro = up ? macros[i].upMacro : macros[i].downMacro;
+                if (macro) executeUTF8Macro((const uint8_t*)macro, strlen(macro));
+            }
+        }
+        lastSwitchState = current;
+    }
+    TestTimeControl::advanceMicros(LOOP_PASS_US - SCAN_US);
+}
+
+// Run loop passes until the simulation finishes (bounded)
+void runToCompletion() {
+    for (int i = 0; i < 100000 && simIsRunning(); i++) {
+        loopPass();
+    }
+}
+
+void setupTestEnvironment() {
+    Serial.clear();
+    Keyboard.clearActions();
+    for (int i = 0; i < NUM_SWITCHES; i++) {
+        setSwitchMacro(i, false, nullptr);
+        setSwitchMacro(i, true, nullptr);
+    }
+    chording.clearAllChords();
+    chording.clearAllModifiers();
+    setBuiltinProfile(nullptr);
+    simClear();
+    lastSwitchState = 0;
+    TestTimeControl::setTime(1000);
+}
+
+std::string command(const char* cmd) {
+    Serial.clear();
+    processCommand(cmd);
+    return Serial.getFullOutput();
+}
+
+//==============================================================================
+// TIMELINE TESTS
+//==============================================================================
+
+void testStepValidation(const TestCase& test) {
+    setupTestEnvironment();
+    ASSERT_STR_CONTAINS(command("SIM ADD 0 1"), "Step 0 added", "First step should be accepted");
+    ASSERT_STR_CONTAINS(command("SIM ADD 1000 NONE"), "Step 1 added", "NONE should release all keys");
+    ASSERT_STR_CONTAINS(command("SIM ADD 500 2"), "rejected", "Out of order step should be rejected");
+    ASSERT_STR_CONTAINS(command("SIM ADD 2000 x"), "Invalid key list", "Bad key list should be rejected");
+    ASSERT_STR_CONTAINS(command("SIM ADD"), "Usage", "Missing offset should show usage");
+    ASSERT_EQ(simStepCount(), 2, "Only valid steps should be stored");
+
+    for (int i = simStepCount(); i < SIM_MAX_STEPS; i++) {
+        ASSERT_TRUE(simAddStep(2000 + i, 0), "Timeline should fill to SIM_MAX_STEPS");
+    }
+    ASSERT_FALSE(simAddStep(99999, 0), "Full timeline should reject steps");
+}
+
+void testRollExpansion(const TestCase& test) {
+    setupTestEnvironment();
+    ASSERT_STR_CONTAINS(command("SIM ROLL 2,0 5000 30000"), "4 steps", "Two-key roll is four steps");
+
+    std::string list = command("SIM LIST");
+    ASSERT_STR_CONTAINS(list, "#0 +0us 2", "Key 2 pressed first");
+    ASSERT_STR_CONTAINS(list, "#1 +5000us 0+2", "Key 0 pressed one gap later");
+    ASSERT_STR_CONTAINS(list, "#2 +35000us 0", "Key 2 released after the hold");
+    ASSERT_STR_CONTAINS(list, "#3 +40000us none", "Key 0 released last");
+
+    ASSERT_STR_CONTAINS(command("SIM ROLL 1 1000"), "6 steps", "Roll appends after the last step");
+    ASSERT_STR_CONTAINS(command("SIM LIST"), "#4 +41000us 1", "Appended roll starts one gap later");
+}
+
+//==============================================================================
+// RUN TESTS
+//==============================================================================
+
+void testChordLatency(const TestCase& test) {
+    setupTestEnvironment();
+    processCommand("CHORD ADD 0+1 \"ab\"");
+    processCommand("SIM ROLL 0,1 5000 30000");
+
+    ASSERT_STR_CONTAINS(command("SIM RUN 3"), "SIM running 3 runs", "Run should start");
+    ASSERT_TRUE(simIsRunning(), "Simulation should be active");
+    Serial.clear();
+    runToCompletion();
+    ASSERT_FALSE(simIsRunning(), "Simulation should finish by itself");
+
+    ASSERT_STR_EQ(Keyboard.toString(),
+                  "write a write b write a write b write a write b",
+                  "Chord should fire once per run");
+
+    std::string report = Serial.getFullOutput();
+    ASSERT_STR_CONTAINS(report, "SIM complete: 3 runs", "Report should print when the run ends");
+    ASSERT_STR_CONTAINS(report, "#0 0: no output", "Chord press produces no output");
+    ASSERT_STR_CONTAINS(report, "#3 none: 3 outputs, latency min 50 avg 50 max 50us",
+                        "Final release should carry the chord latency");
+    ASSERT_STR_CONTAINS(report, "max injection lag", "Report should include loop lag");
+
+    ASSERT_STR_CONTAINS(command("SIM REPORT"), "SIM complete: 3 runs", "SIM REPORT repeats the report");
+    ASSERT_TRUE(macroOutputHook == nullptr, "Output hook should be removed after the run");
+}
+
+void testKeyMacroAndStop(const TestCase& test) {
+    setupTestEnvironment();
+    processCommand("MAP 4 \"x\"");
+    simAddStep(0, 1UL << 4);
+    simAddStep(1000, 0);
+    ASSERT_TRUE(simStart(100), "Run should start");
+
+    // Macro polling peeks; the step is still there for the next loop pass
+    ASSERT_EQ(simPeek(0), 0u, "Peek does not inject a due step");
+    loopPass();
+    ASSERT_EQ(simPeek(0), 1UL << 4, "Peek sees the injected step");
+
+    for (int i = 0; i < 9; i++) loopPass();
+    ASSERT_STR_CONTAINS(command("SIM REPORT"), "SIM running: run 1 of 100", "Report shows progress");
+    ASSERT_STR_EQ(Keyboard.toString(), "write x", "Key macro should fire on injected press");
+
+    command("SIM STOP");
+    ASSERT_FALSE(simIsRunning(), "SIM STOP should end the run");
+    ASSERT_EQ(simSwitches(0x20), 0x20u, "Hardware state passes through when idle");
+}
+
+static int outputsSeen = 0;
+
+void testOutputHook(const TestCase& test) {
+    setupTestEnvironment();
+    macroOutputHook = []() { outputsSeen++; };
+
+    MacroEncodeResult typed = macroEncode("\"ab\"");
+    executeUTF8Macro((const uint8_t*)typed.utf8Sequence, strlen(typed.utf8Sequence));
+    ASSERT_EQ(outputsSeen, 1, "Once per macro, at its first report");
+
+    // Motion is coalesced into a later report, so nothing is sent yet
+    MacroEncodeResult moved = macroEncode("MOVE:4,0");
+    executeUTF8Macro((const uint8_t*)moved.utf8Sequence, strlen(moved.utf8Sequence));
+    ASSERT_EQ(outputsSeen, 1, "Macro without HID output is not counted");
+
+    macroOutputHook = nullptr;
+    free(typed.utf8Sequence);
+    free(moved.utf8Sequence);
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running Switch Simulation Tests" << std::endl;
+    std::cout << "===============================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Step validation", "", EXPECT_PASS), testStepValidation);
+    runner.runTest(TestCase("Roll expansion", "", EXPECT_PASS), testRollExpansion);
+    runner.runTest(TestCase("Chord latency", "", EXPECT_PASS), testChordLatency);
+    runner.runTest(TestCase("Key macro and stop", "", EXPECT_PASS), testKeyMacroAndStop);
+    runner.runTest(TestCase("Output hook", "", EXPECT_PASS), testOutputHook);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+/*
+ * USB Frame Tracking Testing
+ * Uses the host frame model (a frame every 1000us, polled at its start) to
+ * check frame detection, queue-to-poll measurement of macro reports and
+ * phase-locking the input task ahead of each frame
+ */
+
+#include "Arduino.h"
+#include "micro-test.h"
+
+// Include the actual implementation files from parent directory
+#include "../config.h"
+#include "../usb-frame.h"
+#include "../scheduler.h"
+#include "../macro-engine.h"
+#include "../serial-interface.h"
+
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+//==============================================================================
+// TEST HELPER FUNCTIONS
+//==============================================================================
+
+// Mock implementation for switches (since we're not testing hardware)
+uint32_t loopSwitches() {
+    return 0;
+}
+
+static std::vector<uint32_t> inputRuns;   // Offset into the frame of each run
+
+void inputTask() {
+    inputRuns.push_back(micros() % 1000);
+}
+
+// Host copy of loop() in keypaddle.ino
+void loopPass() {
+    if (loopUsbFrame()) {
+        alignTask(0, usbFrameStartUs() + USB_FRAME_US - USB_SOF_LEAD_US);
+    }
+    runScheduler();
+}
+
+void runFor(uint32_t us, uint32_t passUs) {
+    uint32_t end = micros() + us;
+    while ((int32_t)(micros() - end) < 0) {
+        loopPass();
+        TestTimeControl::advanceMicros(passUs);
+    }
+}
+
+void setupTestEnvironment() {
+    static bool registered = false;
+    if (!registered) {
+        TestTimeControl::setTime(1000);
+        addTask("input", inputTask, INPUT_PERIOD_US, INPUT_BUDGET_US);
+        registered = true;
+    }
+    runFor(2000, 10);
+    inputRuns.clear();
+    resetSchedulerStats();
+    resetUsbFrameStats();
+    Keyboard.clearActions();
+}
+
+//==============================================================================
+// FRAME TESTS
+//==============================================================================
+
+void testFrameDetection(const TestCase& test) {
+    setupTestEnvironment();
+    runFor(10000, 10);
+    ASSERT_EQ(usbFrameStats().frames, 10u, "One frame start per millisecond");
+    ASSERT_EQ(usbFrameStartUs() % 1000, 0u, "Frame start seen on the pass it happened");
+}
+
+void testPhaseLock(const TestCase& test) {
+    setupTestEnvironment();
+    runFor(10000, 10);
+
+    ASSERT_EQ(inputRuns.size(), 10u, "Input keeps its 1 kHz rate");
+    for (uint32_t offset : inputRuns) {
+        ASSERT_EQ(offset, USB_FRAME_US - USB_SOF_LEAD_US, "Input runs the lead time before each frame");
+    }
+    ASSERT_EQ(schedulerTask(0).missed, 0, "Aligning never skips a period");
+}
+
+void testSlowLoop(const TestCase& test) {
+    setupTestEnvironment();
+
+    // Passes longer than a frame see a new frame every time; aligning must
+    // not keep pushing the scan into the future
+    runFor(11000, 1100);
+    ASSERT_TRUE(inputRuns.size() >= 9, "Input still runs about once per pass");
+}
+
+void testQueueToPoll(const TestCase& test) {
+    setupTestEnvironment();
+
+    // A report queued at the input task's slot waits the lead time
+    runFor((1750 - micros() % 1000) % 1000, 10);
+    executeUTF8Macro((const uint8_t*)"a", 1);
+    runFor(1000, 10);
+    ASSERT_EQ(usbFrameStats().reports, 1u, "Report taken at the next frame");
+    ASSERT_EQ(usbFrameStats().maxWaitUs, USB_SOF_LEAD_US, "Waited only the lead time");
+
+    // Queued just after a poll, it waits almost a full frame
+    runFor((1010 - micros() % 1000) % 1000, 10);
+    executeUTF8Macro((const uint8_t*)"b", 1);
+    runFor(1000, 10);
+    ASSERT_EQ(usbFrameStats().reports, 2u, "Second report taken");
+    ASSERT_EQ(usbFrameStats().maxWaitUs, 990u, "Late queue waits most of a frame");
+    ASSERT_EQ(usbFrameStats().minWaitUs, USB_SOF_LEAD_US, "Minimum kept");
+
+    Serial.clear();
+    processCommand("TASKS");
+    ASSERT_STR_CONTAINS(Serial.getFullOutput(), "Queue to poll: 2 reports, min 250 avg 620 max 990us",
+                        "TASKS reports the waits");
+}
+
+//==============================================================================
+// MAIN TEST RUNNER
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+    bool verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    std::cout << "Running USB Frame Tracking Tests" << std::endl;
+    std::cout << "================================" << std::endl << std::endl;
+
+    TestRunner runner(verbose);
+
+    runner.runTest(TestCase("Frame detection", "", EXPECT_PASS), testFrameDetection);
+    runner.runTest(TestCase("Phase lock", "", EXPECT_PASS), testPhaseLock);
+    runner.runTest(TestCase("Slow loop passes", "", EXPECT_PASS), testSlowLoop);
+    runner.runTest(TestCase("Queue to poll", "", EXPECT_PASS), testQueueToPoll);
+
+    std::cout << std::endl;
+    runner.printSummary();
+
+    return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/*
+ * Binding Dump Decoding Implementation
+ */
+
+#include "binding-dump.h"
+#include "../macro-decode.h"
+#include "../chording.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+//==============================================================================
+// DECODING
+//==============================================================================
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+static bool parseMask(const std::string& field, uint32_t& mask) {
+  if (field.empty()) return false;
+  char* end;
+  mask = strtoul(field.c_str(), &end, 16);
+  return *end == '\0';
+}
+
+// "<len> <hex>" - the hex must hold exactly len bytes
+static bool parseBytes(std::istringstream& fields, std::string& bytes) {
+  unsigned length;
+  std::string hex;
+  if (!(fields >> length)) return false;
+  fields >> hex;
+  if (hex.size() != length * 2) return false;
+  bytes.clear();
+  for (size_t i = 0; i < hex.size(); i += 2) {
+    int high = hexValue(hex[i]), low = hexValue(hex[i + 1]);
+    if (high < 0 || low < 0) return false;
+    bytes += (char)(high * 16 + low);
+  }
+  return true;
+}
+
+bool parseBindingDump(const std::string& text, BindingDump& dump, std::string& error) {
+  dump = BindingDump();
+  unsigned records = 0;
+
+  std::istringstream lines(text);
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(lines, line)) {
+    lineNumber++;
+    std::istringstream fields(line);
+    std::string tag;
+    fields >> tag;
+
+    if (tag == "END") {
+      unsigned expected;
+      if (!(fields >> expected) || expected != records) {
+        error = "DUMP ended after " + std::to_string(records) + " of its records";
+        return false;
+      }
+      return true;
+    }
+
+    DumpedBinding binding = {};
+    binding.builtin = tag.size() == 2 && tag[0] == 'B';
+    if (binding.builtin) tag = tag.substr(1);
+
+    std::string field;
+    bool valid;
+    if (tag == "M") {
+      valid = (fields >> field) && parseMask(field, dump.modifierMask);
+    } else if (tag == "K") {
+      int key = -1;
+      std::string direction;
+      valid = (fields >> key >> direction) && key >= 0 && key < NUM_SWITCHES &&
+              (direction == "D" || direction == "U") && parseBytes(fields, binding.bytes);
+      binding.key = key;
+      binding.up = direction == "U";
+    } else if (tag == "C") {
+      binding.chord = true;
+      valid = (fields >> field) && parseMask(field, binding.keyMask) && binding.keyMask != 0 &&
+              parseBytes(fields, binding.bytes);
+    } else {
+      continue;   // Echo, prompt
+    }
+
+    if (!valid) {
+      error = "Bad DUMP record on line " + std::to_string(lineNumber) + ": " + line;
+      return false;
+    }
+    if (tag != "M") dump.bindings.push_back(binding);
+    records++;
+  }
+
+  error = "No DUMP output found";
+  return false;
+}
+
+//==============================================================================
+// OUTPUT
+//==============================================================================
+
+static std::string decode(const std::string& bytes) {
+  return macroDecode((const uint8_t*)bytes.data(), bytes.size()).c_str();
+}
+
+std::string formatBindingDump(const BindingDump& dump) {
+  std::string out;
+
+  for (int key = 0; key < NUM_SWITCHES; key++) {
+    for (int up = 0; up <= 1; up++) {
+      out += "Key " + std::to_string(key) + (up ? " UP: " : " DOWN: ");
+      const DumpedBinding* found = nullptr;
+      for (const auto& binding : dump.bindings) {
+        if (!binding.chord && binding.key == key && binding.up == (bool)up) found = &binding;
+      }
+      if (!found) {
+        out += "(empty)\n";
+      } else {
+        out += (found->builtin ? "(built-in) " : "") + decode(found->bytes) + "\n";
+      }
+    }
+  }
+
+  int defined = 0;
+  for (const auto& binding : dump.bindings) {
+    if (binding.chord && !binding.builtin) defined++;
+  }
+  out += "Defined chords: " + std::to_string(defined) + "\n\n";
+
+  bool anyChord = false;
+  for (const auto& binding : dump.bindings) {
+    if (!binding.chord) continue;
+    out += std::string("  ") + formatKeyMask(binding.keyMask).c_str() + ": " +
+           (binding.builtin ? "(built-in) " : "") + decode(binding.bytes) + "\n";
+    anyChord = true;
+  }
+  if (!anyChord) out += "  (no chords defined)\n";
+
+  out += "Modifier keys: ";
+  bool first = true;
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    if (!(dump.modifierMask & (1UL << i))) continue;
+    if (!first) out += ", ";
+    out += std::to_string(i);
+    first = false;
+  }
+  out += first ? "none\n" : "\n";
+  return out;
+}
+
+void bindingDumpToConfig(const BindingDump& dump, HostConfig& config) {
+  config = HostConfig();
+  config.modifierMask = dump.modifierMask;
+  for (const auto& binding : dump.bindings) {
+    if (binding.builtin) continue;
+    if (binding.chord) {
+      config.chords[binding.keyMask] = binding.bytes;
+    } else if (binding.up) {
+      config.upMacro[binding.key] = binding.bytes;
+    } else {
+      config.downMacro[binding.key] = binding.bytes;
+    }
+  }
+}
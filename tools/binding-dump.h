@@ -0,0 +1,50 @@
+/*
+ * Binding Dump Decoding Interface
+ *
+ * Reads the output of DUMP (raw UTF-8+ bindings as length-framed hex
+ * records) and renders it with the firmware decoder on the host, so the
+ * device can be built without one (MACRO_DECODER 0).
+ */
+
+#ifndef BINDING_DUMP_H
+#define BINDING_DUMP_H
+
+#include "config-file.h"
+
+#include <string>
+#include <vector>
+
+//==============================================================================
+// DECODING
+//==============================================================================
+
+struct DumpedBinding {
+  bool chord;               // Chord (keyMask) or key macro (key, up)
+  bool builtin;             // Built-in profile binding with no override
+  uint8_t key;
+  bool up;
+  uint32_t keyMask;
+  std::string bytes;        // Encoded UTF-8+
+};
+
+struct BindingDump {
+  uint32_t modifierMask = 0;
+  std::vector<DumpedBinding> bindings;
+};
+
+// Console text from DUMP: records are checked against their length and the
+// END count, anything else (echo, prompt) is skipped. False if no END line
+// was seen, as with firmware that predates DUMP.
+bool parseBindingDump(const std::string& text, BindingDump& dump, std::string& error);
+
+//==============================================================================
+// OUTPUT
+//==============================================================================
+
+// SHOW ALL followed by CHORD LIST, as a device with the decoder prints them
+std::string formatBindingDump(const BindingDump& dump);
+
+// The saved configuration: user bindings and modifiers, no built-ins
+void bindingDumpToConfig(const BindingDump& dump, HostConfig& config);
+
+#endif // BINDING_DUMP_H
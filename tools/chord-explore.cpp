@@ -0,0 +1,365 @@
+/*
+ * Chord State Machine Explorer Implementation
+ *
+ * Depth-first over events, branching the engine with its runtime snapshot
+ * instead of replaying prefixes. Workers take every jobs-th first event
+ * and report back over a pipe.
+ */
+
+#include "chord-explore.h"
+#include "../chording.h"
+#include "../macro-engine.h"
+
+#include <cstdio>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define MAX_EXAMPLES 5
+
+//==============================================================================
+// EXPLORER
+//==============================================================================
+
+// Set by the macro output hook while processChording runs
+static uint32_t firedMask = 0;
+static uint8_t firedCount = 0;
+
+static void noteFire() {
+  firedMask = chording.getCurrentChord();
+  firedCount++;
+}
+
+struct PathState {
+  ChordRuntimeState engine;
+  uint32_t now;
+  uint32_t switches;
+  uint32_t gestureStart;          // First press of the current gesture
+  uint32_t firstRelease;
+  bool released;
+  uint32_t pressedUnion;          // Every key pressed in the gesture
+  uint8_t fires;
+};
+
+struct Event {
+  uint8_t key;
+  uint32_t delayMs;
+};
+
+class Explorer {
+public:
+  Explorer(const ExploreConfig& config, const std::vector<uint32_t>& delays, ExploreResult& result)
+      : config(config), delays(delays), result(result) {}
+
+  void run(unsigned worker, unsigned jobs) {
+    path.now = 1000;
+    path.switches = 0;
+    path.released = false;
+    path.pressedUnion = 0;
+    path.fires = 0;
+    path.gestureStart = path.firstRelease = 0;
+    path.engine = chording.saveRuntimeState();
+
+    unsigned index = 0;
+    for (uint8_t key = 0; key < config.keys; key++) {
+      for (uint32_t delay : delays) {
+        if (index++ % jobs == worker) branch({key, delay}, 1);
+      }
+    }
+  }
+
+private:
+  const ExploreConfig& config;
+  const std::vector<uint32_t>& delays;
+  ExploreResult& result;
+  PathState path;
+  std::vector<Event> events;
+
+  void branch(Event event, uint8_t depth) {
+    PathState saved = path;
+    events.push_back(event);
+    step(event);
+
+    // Every prefix is itself a sequence: close it, then extend it
+    finish();
+    if (depth < config.depth) {
+      for (uint8_t key = 0; key < config.keys; key++) {
+        for (uint32_t delay : delays) branch({key, delay}, depth + 1);
+      }
+    }
+
+    events.pop_back();
+    path = saved;
+    chording.restoreRuntimeState(path.engine);
+  }
+
+  // Release whatever is still held, one key per millisecond
+  void finish() {
+    PathState saved = path;
+    size_t mark = events.size();
+    for (uint8_t key = 0; key < config.keys; key++) {
+      if (path.switches & (1UL << key)) {
+        events.push_back({key, 1});
+        step(events.back());
+      }
+    }
+    result.sequences++;
+    events.resize(mark);
+    path = saved;
+    chording.restoreRuntimeState(path.engine);
+  }
+
+  void step(const Event& event) {
+    uint32_t bit = 1UL << event.key;
+    path.now += event.delayMs;
+    TestTimeControl::setTime(path.now);
+
+    if (path.switches == 0) {
+      path.gestureStart = path.now;
+      path.released = false;
+      path.pressedUnion = 0;
+      path.fires = 0;
+    }
+    path.switches ^= bit;
+    if (path.switches & bit) {
+      path.pressedUnion |= bit;
+    } else if (!path.released) {
+      path.firstRelease = path.now;
+      path.released = true;
+    }
+
+    firedMask = 0;
+    firedCount = 0;
+    processChording(path.switches);
+    path.engine = chording.saveRuntimeState();
+    result.events++;
+
+    if (firedCount > 0) {
+      Keyboard.clearActions();
+      checkFire();
+    }
+    if (path.switches == 0 && (chording.getCurrentState() != CHORD_IDLE ||
+                               chording.getCurrentChord() != 0 ||
+                               chording.isExecutionWindowActive())) {
+      violation("engine not idle after all keys released");
+    }
+  }
+
+  void checkFire() {
+    path.fires += firedCount;
+    if (path.fires > 1) {
+      violation("chord fired more than once in a gesture");
+    }
+    if (!chording.isChordDefined(firedMask) || (firedMask & ~path.pressedUnion) != 0) {
+      violation(("undefined or unpressed chord " + std::string(formatKeyMask(firedMask).c_str()) +
+                 " fired").c_str());
+    }
+
+    for (auto& chord : result.latency) {
+      if (chord.keyMask != firedMask) continue;
+      uint32_t press = path.now - path.gestureStart;
+      uint32_t release = path.released ? path.now - path.firstRelease : 0;
+      chord.fires++;
+      if (press < chord.minPressMs) chord.minPressMs = press;
+      if (press > chord.maxPressMs) chord.maxPressMs = press;
+      if (release > chord.maxReleaseMs) chord.maxReleaseMs = release;
+    }
+  }
+
+  void violation(const char* what) {
+    result.violations++;
+    if (result.examples.size() >= MAX_EXAMPLES) return;
+
+    // "+0@1 +1@49 -0@1 ...": key pressed (+) or released (-) after delay ms
+    std::string text;
+    uint32_t switches = 0;
+    for (const Event& e : events) {
+      switches ^= 1UL << e.key;
+      text += (switches & (1UL << e.key)) ? "+" : "-";
+      text += std::to_string(e.key) + "@" + std::to_string(e.delayMs) + " ";
+    }
+    result.examples.push_back(text + ": " + what);
+  }
+};
+
+//==============================================================================
+// WORKER TRANSPORT
+//==============================================================================
+
+static bool writeAll(int fd, const void* data, size_t size) {
+  const char* p = (const char*)data;
+  while (size > 0) {
+    ssize_t n = write(fd, p, size);
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+static bool readAll(int fd, void* data, size_t size) {
+  char* p = (char*)data;
+  while (size > 0) {
+    ssize_t n = read(fd, p, size);
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+static void sendResult(int fd, const ExploreResult& result) {
+  writeAll(fd, &result.sequences, sizeof(result.sequences));
+  writeAll(fd, &result.events, sizeof(result.events));
+  writeAll(fd, &result.violations, sizeof(result.violations));
+  for (const auto& chord : result.latency) writeAll(fd, &chord, sizeof(chord));
+
+  uint32_t count = result.examples.size();
+  writeAll(fd, &count, sizeof(count));
+  for (const auto& text : result.examples) {
+    uint32_t length = text.size();
+    writeAll(fd, &length, sizeof(length));
+    writeAll(fd, text.data(), length);
+  }
+}
+
+// Merge one worker's result into total
+static bool receiveResult(int fd, ExploreResult& total) {
+  ExploreResult part;
+  part.latency = total.latency;
+  if (!readAll(fd, &part.sequences, sizeof(part.sequences)) ||
+      !readAll(fd, &part.events, sizeof(part.events)) ||
+      !readAll(fd, &part.violations, sizeof(part.violations))) {
+    return false;
+  }
+  for (auto& chord : part.latency) {
+    if (!readAll(fd, &chord, sizeof(chord))) return false;
+  }
+  uint32_t count;
+  if (!readAll(fd, &count, sizeof(count))) return false;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t length;
+    if (!readAll(fd, &length, sizeof(length))) return false;
+    std::string text(length, '\0');
+    if (!readAll(fd, &text[0], length)) return false;
+    if (total.examples.size() < MAX_EXAMPLES) total.examples.push_back(text);
+  }
+
+  total.sequences += part.sequences;
+  total.events += part.events;
+  total.violations += part.violations;
+  for (size_t i = 0; i < total.latency.size(); i++) {
+    ChordLatency& sum = total.latency[i];
+    const ChordLatency& add = part.latency[i];
+    sum.fires += add.fires;
+    if (add.minPressMs < sum.minPressMs) sum.minPressMs = add.minPressMs;
+    if (add.maxPressMs > sum.maxPressMs) sum.maxPressMs = add.maxPressMs;
+    if (add.maxReleaseMs > sum.maxReleaseMs) sum.maxReleaseMs = add.maxReleaseMs;
+  }
+  return true;
+}
+
+//==============================================================================
+// EXPLORATION
+//==============================================================================
+
+std::vector<uint32_t> defaultExploreDelays(uint32_t windowMs) {
+  return {1, windowMs - 1, windowMs, windowMs + 1,
+          CHORD_CANCELLATION_TIMEOUT_MS - 1, CHORD_CANCELLATION_TIMEOUT_MS};
+}
+
+static bool setupEngine(const ExploreConfig& config, std::string& error) {
+  if (config.keys == 0 || config.keys > NUM_SWITCHES) {
+    error = "Key count must be 1-" + std::to_string(NUM_SWITCHES);
+    return false;
+  }
+  uint32_t keyRange = (1UL << config.keys) - 1;
+
+  chording.clearAllChords();
+  chording.clearAllModifiers();
+  chording.setBuiltinChords(nullptr, 0);
+  chording.setExecutionWindowMs(config.windowMs);
+  for (uint8_t i = 0; i < config.keys; i++) {
+    if (config.modifierMask & (1UL << i)) chording.setModifierKey(i, true);
+  }
+
+  for (uint32_t mask : config.chords) {
+    if (mask == 0 || (mask & ~keyRange) || (mask & ~config.modifierMask) == 0) {
+      error = "Chord " + std::string(formatKeyMask(mask).c_str()) +
+              " must use keys 0-" + std::to_string(config.keys - 1) +
+              " and at least one non-modifier key";
+      return false;
+    }
+    if (!chording.addChord(mask, "x")) {
+      error = "Out of memory adding chords";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool exploreChords(const ExploreConfig& config, ExploreResult& result, std::string& error) {
+  result = ExploreResult();
+  for (uint32_t mask : config.chords) {
+    ChordLatency chord;
+    chord.keyMask = mask;
+    result.latency.push_back(chord);
+  }
+  if (!setupEngine(config, error)) return false;
+
+  std::vector<uint32_t> delays = config.delaysMs.empty() ? defaultExploreDelays(config.windowMs)
+                                                         : config.delaysMs;
+
+  // Start from a freshly idle engine
+  TestTimeControl::setTime(1000);
+  processChording(0);
+  macroOutputHook = noteFire;
+
+  unsigned jobs = config.jobs > 0 ? config.jobs : 1;
+  if (jobs == 1) {
+    Explorer(config, delays, result).run(0, 1);
+    macroOutputHook = nullptr;
+    return true;
+  }
+
+  std::vector<pid_t> workers;
+  std::vector<int> pipes;
+  for (unsigned w = 0; w < jobs; w++) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+      error = "pipe failed";
+      break;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(fds[0]);
+      ExploreResult part;
+      part.latency = result.latency;
+      Explorer(config, delays, part).run(w, jobs);
+      sendResult(fds[1], part);
+      close(fds[1]);
+      _exit(0);
+    }
+    close(fds[1]);
+    if (pid < 0) {
+      close(fds[0]);
+      error = "fork failed";
+      break;
+    }
+    workers.push_back(pid);
+    pipes.push_back(fds[0]);
+  }
+
+  bool ok = error.empty();
+  for (size_t w = 0; w < workers.size(); w++) {
+    if (!receiveResult(pipes[w], result)) {
+      ok = false;
+      if (error.empty()) error = "Worker " + std::to_string(w) + " failed";
+    }
+    close(pipes[w]);
+    int status;
+    waitpid(workers[w], &status, 0);
+  }
+  macroOutputHook = nullptr;
+  return ok;
+}
@@ -0,0 +1,63 @@
+/*
+ * Chord State Machine Explorer Interface
+ *
+ * Runs the firmware ChordingEngine over every switch-event sequence up to a
+ * bounded length: each event toggles one key after one of a few delays
+ * chosen around the execution window and cancellation timeout. As in
+ * loop(), the engine only sees switch changes. Keys still held when a
+ * sequence ends are then released, so every sequence ends at idle.
+ *
+ * Checked after every event:
+ *   - at most one chord fires per gesture (all-released to all-released)
+ *   - a fired chord is defined and all its keys were pressed in the gesture
+ *   - with every key released the engine is idle with nothing captured
+ */
+
+#ifndef CHORD_EXPLORE_H
+#define CHORD_EXPLORE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// EXPLORATION SETUP
+//==============================================================================
+
+struct ExploreConfig {
+  uint8_t keys = 4;                         // Keys 0..keys-1 take part
+  std::vector<uint32_t> chords;             // Chord key masks
+  uint32_t modifierMask = 0;
+  uint32_t windowMs = 50;                   // Execution window
+  std::vector<uint32_t> delaysMs;           // Empty = around window and timeout
+  uint8_t depth = 5;                        // Events per sequence
+  unsigned jobs = 1;                        // Worker processes
+};
+
+// 1, window-1, window, window+1, timeout-1, timeout
+std::vector<uint32_t> defaultExploreDelays(uint32_t windowMs);
+
+//==============================================================================
+// RESULTS
+//==============================================================================
+
+struct ChordLatency {
+  uint32_t keyMask = 0;
+  uint64_t fires = 0;
+  uint32_t minPressMs = UINT32_MAX;       // First key press to execution
+  uint32_t maxPressMs = 0;
+  uint32_t maxReleaseMs = 0;              // First key release to execution
+};
+
+struct ExploreResult {
+  uint64_t sequences = 0;
+  uint64_t events = 0;
+  uint64_t violations = 0;
+  std::vector<std::string> examples;      // First few violating sequences
+  std::vector<ChordLatency> latency;      // One per configured chord
+};
+
+// Explore in config.jobs forked workers; false with error on setup failure
+bool exploreChords(const ExploreConfig& config, ExploreResult& result, std::string& error);
+
+#endif // CHORD_EXPLORE_H
@@ -0,0 +1,195 @@
+/*
+ * Host Configuration File Implementation
+ *
+ * Line syntax and validation follow the serial commands so a file that
+ * loads here replays cleanly on a device.
+ */
+
+#include "config-file.h"
+#include "../macro-encode.h"
+#include "../chording.h"
+#include "../config-hash.h"
+#include "../commands/cmd-parsing.h"
+
+#include <fstream>
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static const char* skipSpace(const char* p) {
+  while (isspace(*p)) p++;
+  return p;
+}
+
+// Match a case-insensitive keyword followed by whitespace or end of line
+static bool matchWord(const char** pos, const char* word) {
+  size_t len = strlen(word);
+  if (strncasecmp(*pos, word, len) != 0) return false;
+  if ((*pos)[len] != '\0' && !isspace((*pos)[len])) return false;
+  *pos = skipSpace(*pos + len);
+  return true;
+}
+
+static bool encodeMacro(const char* text, std::string& encoded, std::string& error) {
+  MacroEncodeResult parsed = macroEncode(text);
+  if (parsed.error != nullptr) {
+    error = std::string("Parse error: ") + parsed.error;
+    return false;
+  }
+  encoded = parsed.utf8Sequence;
+  free(parsed.utf8Sequence);
+  return true;
+}
+
+static bool applyChordLine(HostConfig& config, const char* args, std::string& error) {
+  if (matchWord(&args, "ADD")) {
+    const char* spacePos = args;
+    while (*spacePos && !isspace(*spacePos)) spacePos++;
+    if (*spacePos == '\0') {
+      error = "Usage: CHORD ADD <keys> <macro>";
+      return false;
+    }
+
+    std::string keyList(args, spacePos - args);
+    uint32_t keyMask = parseChordKeys(keyList.c_str());
+    if (keyMask == 0) {
+      error = "Invalid key list";
+      return false;
+    }
+    if (config.chords.count(keyMask)) {
+      error = "Chord pattern already defined - use CHORD REMOVE first";
+      return false;
+    }
+    if ((keyMask & CHORD_KEYS_MASK & ~config.modifierMask) == 0) {
+      error = "Chord must have at least 1 non-modifier key";
+      return false;
+    }
+
+    std::string encoded;
+    if (!encodeMacro(skipSpace(spacePos), encoded, error)) return false;
+    if (encoded.empty()) {
+      error = "Missing macro sequence";
+      return false;
+    }
+    config.chords[keyMask] = encoded;
+    return true;
+  }
+  if (matchWord(&args, "REMOVE")) {
+    uint32_t keyMask = parseChordKeys(args);
+    if (keyMask == 0 || config.chords.erase(keyMask) == 0) {
+      error = "Chord not found";
+      return false;
+    }
+    return true;
+  }
+  if (matchWord(&args, "CLEAR")) {
+    config.chords.clear();
+    return true;
+  }
+  if (matchWord(&args, "MODIFIERS")) {
+    if (matchWord(&args, "CLEAR")) {
+      config.modifierMask = 0;
+      return true;
+    }
+    uint32_t modifierMask = parseKeyList(args);
+    if (modifierMask == 0 && *args != '0') {
+      error = "Invalid modifier key list";
+      return false;
+    }
+    config.modifierMask = modifierMask;
+    return true;
+  }
+
+  error = "Unsupported CHORD subcommand";
+  return false;
+}
+
+//==============================================================================
+// CONFIG FILE INTERFACE
+//==============================================================================
+
+bool applyConfigLine(HostConfig& config, const char* line, std::string& error) {
+  const char* pos = skipSpace(line);
+  if (*pos == '\0' || *pos == '#') return true;
+
+  bool isMap = matchWord(&pos, "MAP");
+  if (isMap || matchWord(&pos, "CLEAR")) {
+    int switchNum, direction;
+    const char* remaining;
+
+    // Errors go back through error only: the loopback simulator may be
+    // sharing Serial
+    if (!scanSwitchAndDirection(pos, &switchNum, &direction, &remaining)) {
+      error = "Invalid key 0-" + std::to_string(NUM_SWITCHES - 1);
+      return false;
+    }
+
+    if (!isMap) {
+      if (direction != DIRECTION_UP) config.downMacro[switchNum].clear();
+      if (direction != DIRECTION_DOWN) config.upMacro[switchNum].clear();
+      return true;
+    }
+
+    std::string encoded;
+    if (!encodeMacro(remaining, encoded, error)) return false;
+    if (direction == DIRECTION_UP) {
+      config.upMacro[switchNum] = encoded;
+    } else {
+      config.downMacro[switchNum] = encoded;
+    }
+    return true;
+  }
+  if (matchWord(&pos, "CHORD")) {
+    return applyChordLine(config, pos, error);
+  }
+  if (matchWord(&pos, "SAVE")) {
+    return true;
+  }
+
+  error = "Unsupported command";
+  return false;
+}
+
+bool loadConfigFile(const char* path, HostConfig& config, std::vector<ConfigError>& errors) {
+  std::ifstream in(path);
+  if (!in) {
+    errors.push_back({0, std::string("Cannot open ") + path});
+    return false;
+  }
+
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(in, line)) {
+    lineNumber++;
+    std::string error;
+    if (!applyConfigLine(config, line.c_str(), error)) {
+      errors.push_back({lineNumber, error});
+    }
+  }
+
+  // Modifiers may be set after the chords that use them
+  for (const auto& chord : config.chords) {
+    if ((chord.first & CHORD_KEYS_MASK & ~config.modifierMask) == 0) {
+      errors.push_back({0, "Chord " + std::string(formatKeyMask(chord.first)) +
+                           " has no non-modifier key"});
+    }
+  }
+
+  return errors.empty();
+}
+
+uint64_t hostConfigHash(const HostConfig& config) {
+  uint64_t keyMacroHash = 0;
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    keyMacroHash += configHashEntry(CONFIG_HASH_KEY_DOWN, i, config.downMacro[i].c_str());
+    keyMacroHash += configHashEntry(CONFIG_HASH_KEY_UP, i, config.upMacro[i].c_str());
+  }
+
+  uint64_t chordHash = 0;
+  for (const auto& chord : config.chords) {
+    chordHash += configHashEntry(CONFIG_HASH_CHORD, chord.first, chord.second.c_str());
+  }
+
+  return configHashCombine(keyMacroHash, chordHash, config.modifierMask);
+}
@@ -0,0 +1,50 @@
+/*
+ * Host Configuration File Interface
+ *
+ * Reads text configuration files made of the same MAP / CHORD lines the
+ * serial console accepts and holds the result as encoded UTF-8+ bindings.
+ * Built on the host against the test mocks, using the firmware encoder.
+ */
+
+#ifndef CONFIG_FILE_H
+#define CONFIG_FILE_H
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../config.h"
+
+//==============================================================================
+// HOST CONFIGURATION MODEL
+//==============================================================================
+
+struct HostConfig {
+  std::string downMacro[NUM_SWITCHES];       // Encoded UTF-8+, empty = unset
+  std::string upMacro[NUM_SWITCHES];
+  std::map<uint32_t, std::string> chords;    // Key mask -> encoded UTF-8+
+  uint32_t modifierMask = 0;
+};
+
+struct ConfigError {
+  int line;                                  // 1-based line number, 0 = whole file
+  std::string message;
+};
+
+//==============================================================================
+// CONFIG FILE INTERFACE
+//==============================================================================
+
+// Apply one console-style line to config
+// Accepts MAP, CLEAR, CHORD ADD/REMOVE/CLEAR/MODIFIERS, SAVE (ignored),
+// blank lines and '#' comments. Returns false and sets error on failure.
+bool applyConfigLine(HostConfig& config, const char* line, std::string& error);
+
+// Read a config file, collecting every error rather than stopping at the first
+bool loadConfigFile(const char* path, HostConfig& config, std::vector<ConfigError>& errors);
+
+// Configuration hash, identical to CONFIG HASH on a device carrying config
+uint64_t hostConfigHash(const HostConfig& config);
+
+#endif // CONFIG_FILE_H
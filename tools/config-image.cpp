@@ -0,0 +1,156 @@
+/*
+ * Host Configuration Image Implementation
+ *
+ * The image is produced by the same saveToStorage()/saveChords() code the
+ * firmware runs for SAVE, so LOAD on the device reads it back unchanged.
+ */
+
+#include "config-image.h"
+#include "../storage.h"
+#include "../chordStorage.h"
+#include "../chording.h"
+
+//==============================================================================
+// TARGET BOARDS
+//==============================================================================
+
+static const BoardInfo BOARDS[] = {
+  // ATmega32U4 EEPROM, written as an avrdude/teensy .eep image
+  {"teensy",  1024, 0x00000000, 0},
+  // arduino-pico EEPROM emulation: last 4K sector of flash
+  {"pico",    4096, 0x10000000, 2UL << 20},
+  {"kb2040",  4096, 0x10000000, 8UL << 20},
+};
+
+static const int NUM_BOARDS = sizeof(BOARDS) / sizeof(BOARDS[0]);
+
+const BoardInfo* findBoard(const char* name) {
+  for (int i = 0; i < NUM_BOARDS; i++) {
+    if (strcasecmp(name, BOARDS[i].name) == 0) return &BOARDS[i];
+  }
+  return nullptr;
+}
+
+uint32_t boardHexAddress(const BoardInfo& board, uint32_t flashSize) {
+  if (board.flashBase == 0) return 0;
+  if (flashSize < board.eepromSize) return 0;
+  return board.flashBase + flashSize - board.eepromSize;
+}
+
+std::string boardNames() {
+  std::string names;
+  for (int i = 0; i < NUM_BOARDS; i++) {
+    if (i > 0) names += ", ";
+    names += BOARDS[i].name;
+  }
+  return names;
+}
+
+//==============================================================================
+// IMAGE BUILDER
+//==============================================================================
+
+// Replace the firmware globals with config so the storage code can save it
+static void installHostConfig(const HostConfig& config) {
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    setSwitchMacro(i, false, config.downMacro[i].empty() ? nullptr : strdup(config.downMacro[i].c_str()));
+    setSwitchMacro(i, true, config.upMacro[i].empty() ? nullptr : strdup(config.upMacro[i].c_str()));
+  }
+
+  chording.clearAllChords();
+  chording.clearAllModifiers();
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    if (config.modifierMask & (1UL << i)) {
+      chording.setModifierKey(i, true);
+    }
+  }
+  for (const auto& chord : config.chords) {
+    chording.addChord(chord.first, chord.second.c_str());
+  }
+}
+
+bool buildConfigImage(const HostConfig& config, const BoardInfo& board,
+                      std::vector<uint8_t>& image, uint16_t& usedBytes, std::string& error) {
+  if (board.eepromSize > EEPROM.length()) {
+    error = "EEPROM mock is smaller than the board EEPROM";
+    return false;
+  }
+
+  installHostConfig(config);
+  EEPROM.clear();
+
+  uint16_t chordOffset = saveToStorage();
+  uint16_t finalOffset = 0;
+  if (chordOffset != 0) {
+    finalOffset = saveChords(chordOffset, chording.getModifierMask(),
+                             [](void (*callback)(uint32_t keyMask, const char* macro)) {
+                               chording.forEachChord(callback);
+                             });
+  }
+
+  // The board keeps the tail of its EEPROM for the event journal
+  uint16_t available = board.eepromSize - JOURNAL_IMAGE_SIZE;
+  uint16_t end = storageEnd();
+  if (chordOffset == 0 || finalOffset >= end || finalOffset > available) {
+    error = "Configuration needs " + std::to_string(chordOffset == 0 ? end : finalOffset) +
+            " bytes, " + board.name + " has " + std::to_string(board.eepromSize) + " (" +
+            std::to_string(available) + " after the event journal)";
+    return false;
+  }
+
+  const uint8_t* memory = EEPROM.getRawMemory();
+  image.assign(memory, memory + board.eepromSize);
+  usedBytes = finalOffset;
+  return true;
+}
+
+//==============================================================================
+// OUTPUT FORMATS
+//==============================================================================
+
+void writeImageBinary(FILE* out, const std::vector<uint8_t>& image) {
+  fwrite(image.data(), 1, image.size(), out);
+}
+
+static void writeHexRecord(FILE* out, uint8_t type, uint16_t address, const uint8_t* data, uint8_t length) {
+  uint8_t checksum = length + (address >> 8) + (address & 0xFF) + type;
+  fprintf(out, ":%02X%04X%02X", length, address, type);
+  for (uint8_t i = 0; i < length; i++) {
+    fprintf(out, "%02X", data[i]);
+    checksum += data[i];
+  }
+  fprintf(out, "%02X\n", (uint8_t)(-checksum));
+}
+
+void writeImageIntelHex(FILE* out, const std::vector<uint8_t>& image, uint32_t baseAddress) {
+  uint32_t upper = 0xFFFFFFFF;
+  for (size_t pos = 0; pos < image.size(); pos += 16) {
+    uint32_t address = baseAddress + pos;
+    if ((address >> 16) != upper) {
+      upper = address >> 16;
+      uint8_t ext[2] = {(uint8_t)(upper >> 8), (uint8_t)upper};
+      writeHexRecord(out, 0x04, 0, ext, 2);
+    }
+    uint8_t length = (uint8_t)std::min<size_t>(16, image.size() - pos);
+    writeHexRecord(out, 0x00, address & 0xFFFF, &image[pos], length);
+  }
+  writeHexRecord(out, 0x01, 0, nullptr, 0);
+}
+
+void writeImageHeader(FILE* out, const std::vector<uint8_t>& image, uint16_t usedBytes,
+                      const char* source, const BoardInfo& board) {
+  fprintf(out, "/*\n");
+  fprintf(out, " * Configuration image generated by kpconfig - do not edit\n");
+  fprintf(out, " *\n");
+  fprintf(out, " * Source: %s\n", source);
+  fprintf(out, " * Board:  %s (%u of %u EEPROM bytes)\n", board.name, usedBytes, board.eepromSize);
+  fprintf(out, " */\n\n");
+  fprintf(out, "#ifndef CONFIG_IMAGE_H\n#define CONFIG_IMAGE_H\n\n");
+  fprintf(out, "#define CONFIG_IMAGE_SIZE %u\n\n", usedBytes);
+  fprintf(out, "static const uint8_t CONFIG_IMAGE[CONFIG_IMAGE_SIZE] PROGMEM = {");
+  for (uint16_t i = 0; i < usedBytes; i++) {
+    fprintf(out, "%s0x%02X", (i % 12 == 0) ? "\n  " : " ", image[i]);
+    if (i + 1 < usedBytes) fprintf(out, ",");
+  }
+  fprintf(out, "\n};\n\n#endif // CONFIG_IMAGE_H\n");
+}
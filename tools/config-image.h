@@ -0,0 +1,55 @@
+/*
+ * Host Configuration Image Interface
+ *
+ * Builds the EEPROM image a device would hold after replaying a config and
+ * running SAVE, using the firmware storage code against the EEPROM mock.
+ */
+
+#ifndef HOST_CONFIG_IMAGE_H
+#define HOST_CONFIG_IMAGE_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "config-file.h"
+
+//==============================================================================
+// TARGET BOARDS
+//==============================================================================
+
+struct BoardInfo {
+  const char* name;
+  uint16_t eepromSize;        // Board EEPROM; the journal keeps the last JOURNAL_IMAGE_SIZE
+  uint32_t flashBase;         // XIP flash address, 0 if the EEPROM is not in flash
+  uint32_t flashSize;         // Default flash size (--flash-size overrides)
+};
+
+// Returns nullptr for an unknown board name
+const BoardInfo* findBoard(const char* name);
+
+// Load address for Intel HEX output. Flash-backed EEPROM is the last
+// eepromSize bytes of a flashSize flash with no filesystem partition;
+// 0 if flashSize cannot hold it.
+uint32_t boardHexAddress(const BoardInfo& board, uint32_t flashSize);
+
+// Comma separated list of supported board names, for usage messages
+std::string boardNames();
+
+//==============================================================================
+// IMAGE INTERFACE
+//==============================================================================
+
+// Build the storage image for config. image receives the full EEPROM
+// contents for the board (unused bytes erased to 0xFF); usedBytes is the
+// length actually occupied. Returns false with error set if it does not fit.
+bool buildConfigImage(const HostConfig& config, const BoardInfo& board,
+                      std::vector<uint8_t>& image, uint16_t& usedBytes, std::string& error);
+
+// Output formats
+void writeImageBinary(FILE* out, const std::vector<uint8_t>& image);
+void writeImageIntelHex(FILE* out, const std::vector<uint8_t>& image, uint32_t baseAddress);
+void writeImageHeader(FILE* out, const std::vector<uint8_t>& image, uint16_t usedBytes,
+                      const char* source, const BoardInfo& board);
+
+#endif // HOST_CONFIG_IMAGE_H
@@ -0,0 +1,320 @@
+/*
+ * Host Configuration Sync Implementation
+ *
+ * Device state is read back as raw bytes with DUMP, or on firmware without
+ * it in the same human-readable form SHOW prints, re-encoded with the
+ * firmware encoder; CONFIG HASH confirms both the readback and the final
+ * result.
+ */
+
+#include "config-sync.h"
+#include "binding-dump.h"
+#include "../macro-encode.h"
+#include "../macro-decode.h"
+#include "../chording.h"
+#include "../config-hash.h"
+
+#include <cstdio>
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static bool encodeText(const std::string& text, std::string& encoded) {
+  MacroEncodeResult parsed = macroEncode(text.c_str());
+  if (parsed.error != nullptr) return false;
+  encoded = parsed.utf8Sequence;
+  free(parsed.utf8Sequence);
+  return true;
+}
+
+static std::string keyList(uint32_t keyMask) {
+  return std::string(formatKeyMask(keyMask));
+}
+
+static std::string hashText(uint64_t hash) {
+  char text[17];
+  formatConfigHash(hash, text);
+  return text;
+}
+
+// "Config hash: XXXXXXXXXXXXXXXX" -> hex digits, empty for older firmware
+static std::string parseHashReply(const std::string& response) {
+  static const char LABEL[] = "Config hash: ";
+  size_t pos = response.find(LABEL);
+  if (pos == std::string::npos) return "";
+  return response.substr(pos + sizeof(LABEL) - 1, 16);
+}
+
+static std::vector<std::string> splitLines(const std::string& text) {
+  std::vector<std::string> lines;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t eol = text.find('\n', pos);
+    if (eol == std::string::npos) eol = text.size();
+    lines.push_back(text.substr(pos, eol - pos));
+    pos = eol + 1;
+  }
+  return lines;
+}
+
+static bool addOp(std::vector<SyncOp>& ops, const std::string& command, const char* expect,
+                  std::string& error) {
+  if (command.size() > DEVICE_MAX_COMMAND) {
+    error = "Command too long for the device console (" + std::to_string(command.size()) +
+            " chars): " + command.substr(0, 40) + "... - use kpconfig compile instead";
+    return false;
+  }
+  ops.push_back({command, expect});
+  return true;
+}
+
+static bool addMapOp(std::vector<SyncOp>& ops, int key, bool up, const std::string& encoded,
+                     std::string& error) {
+  std::string text;
+  if (!renderMacro(encoded, text)) {
+    error = "Key " + std::to_string(key) + (up ? " UP" : " DOWN") +
+            " binding cannot be sent over the console";
+    return false;
+  }
+  // Direction is always explicit - a macro starting with UP would otherwise be read as one
+  return addOp(ops, "MAP " + std::to_string(key) + (up ? " UP " : " DOWN ") + text, "OK", error);
+}
+
+//==============================================================================
+// SYNC PLAN
+//==============================================================================
+
+bool renderMacro(const std::string& encoded, std::string& text) {
+  String readable = macroDecode((const uint8_t*)encoded.data(), encoded.size());
+
+  // The console only accepts printable ASCII - pass other bytes as \xHH
+  text.clear();
+  for (const char* p = readable.c_str(); *p; p++) {
+    uint8_t c = (uint8_t)*p;
+    if (c < 32 || c > 126) {
+      char hex[5];
+      snprintf(hex, sizeof(hex), "\\x%02X", c);
+      text += hex;
+    } else {
+      text += (char)c;
+    }
+  }
+
+  std::string check;
+  return encodeText(text, check) && check == encoded;
+}
+
+bool planSync(const HostConfig& current, const HostConfig& desired, bool exact,
+              std::vector<SyncOp>& ops, std::string& error) {
+  ops.clear();
+
+  // Removals first so replaced chords can be re-added
+  if (!exact) {
+    if (!current.chords.empty()) ops.push_back({"CHORD CLEAR", "cleared"});
+  } else {
+    for (const auto& chord : current.chords) {
+      auto want = desired.chords.find(chord.first);
+      if (want == desired.chords.end() || want->second != chord.second) {
+        ops.push_back({"CHORD REMOVE " + keyList(chord.first), "removed"});
+      }
+    }
+  }
+
+  // Modifiers before additions - CHORD ADD validates against them
+  if (!exact || current.modifierMask != desired.modifierMask) {
+    if (desired.modifierMask == 0) {
+      ops.push_back({"CHORD MODIFIERS CLEAR", "cleared"});
+    } else {
+      ops.push_back({"CHORD MODIFIERS " + keyList(desired.modifierMask), "set to"});
+    }
+  }
+
+  for (const auto& chord : desired.chords) {
+    auto have = current.chords.find(chord.first);
+    if (exact && have != current.chords.end() && have->second == chord.second) continue;
+
+    std::string text;
+    if (!renderMacro(chord.second, text)) {
+      error = "Chord " + keyList(chord.first) + " binding cannot be sent over the console";
+      return false;
+    }
+    if (!addOp(ops, "CHORD ADD " + keyList(chord.first) + " " + text, "added", error)) {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    const std::string& wantDown = desired.downMacro[i];
+    const std::string& wantUp = desired.upMacro[i];
+    bool downDiffers = (!exact && !wantDown.empty()) || wantDown != current.downMacro[i];
+    bool upDiffers = (!exact && !wantUp.empty()) || wantUp != current.upMacro[i];
+
+    // One CLEAR covers both directions
+    if (downDiffers && upDiffers && wantDown.empty() && wantUp.empty()) {
+      ops.push_back({"CLEAR " + std::to_string(i), "Cleared"});
+      continue;
+    }
+    if (downDiffers) {
+      if (wantDown.empty()) {
+        ops.push_back({"CLEAR " + std::to_string(i) + " DOWN", "Cleared"});
+      } else if (!addMapOp(ops, i, false, wantDown, error)) {
+        return false;
+      }
+    }
+    if (upDiffers) {
+      if (wantUp.empty()) {
+        ops.push_back({"CLEAR " + std::to_string(i) + " UP", "Cleared"});
+      } else if (!addMapOp(ops, i, true, wantUp, error)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+// DEVICE SYNC
+//==============================================================================
+
+bool readDeviceConfig(DeviceConsole& console, HostConfig& config, bool& exact,
+                      std::string& error) {
+  // Raw bytes need no decoder on the device and always read back exactly
+  std::string response;
+  if (!console.run("DUMP", response, error)) return false;
+  BindingDump dump;
+  std::string dumpError;
+  if (parseBindingDump(response, dump, dumpError)) {
+    bindingDumpToConfig(dump, config);
+    exact = true;
+    return true;
+  }
+  if (response.find("Unknown command") == std::string::npos) {
+    error = dumpError;
+    return false;
+  }
+
+  std::vector<ConsoleReply> replies;
+  if (!console.run({"SHOW ALL", "CHORD LIST", "CHORD MODIFIERS"}, replies, error)) {
+    return false;
+  }
+
+  config = HostConfig();
+  exact = true;
+
+  // Key N DOWN: <macro> / Key N UP: (empty)
+  for (const auto& line : splitLines(replies[0].response)) {
+    int key;
+    char direction[5];
+    int textStart = 0;
+    if (sscanf(line.c_str(), "Key %d %4[A-Z]: %n", &key, direction, &textStart) < 2 ||
+        textStart == 0 || key < 0 || key >= NUM_SWITCHES) {
+      continue;
+    }
+    // Built-in profile bindings are not part of the configuration
+    std::string text = line.substr(textStart);
+    if (text == "(empty)" || text.compare(0, 10, "(built-in)") == 0) continue;
+
+    std::string encoded;
+    if (!encodeText(text, encoded)) {
+      exact = false;
+      continue;
+    }
+    if (strcmp(direction, "UP") == 0) {
+      config.upMacro[key] = encoded;
+    } else {
+      config.downMacro[key] = encoded;
+    }
+  }
+
+  // "  0+1: <macro>" per chord
+  for (const auto& line : splitLines(replies[1].response)) {
+    if (line.compare(0, 2, "  ") != 0 || line.compare(0, 3, "  (") == 0) continue;
+    size_t colon = line.find(": ");
+    if (colon == std::string::npos || line.compare(colon + 2, 10, "(built-in)") == 0) continue;
+
+    uint32_t keyMask = parseChordKeys(line.substr(2, colon - 2).c_str());
+    std::string encoded;
+    if (keyMask == 0 || !encodeText(line.substr(colon + 2), encoded)) {
+      exact = false;
+      continue;
+    }
+    config.chords[keyMask] = encoded;
+  }
+
+  // "Modifier keys: 1, 6" or "Modifier keys: none"
+  const std::string& modifiers = replies[2].response;
+  size_t label = modifiers.find("Modifier keys: ");
+  if (label == std::string::npos) {
+    error = "Unexpected CHORD MODIFIERS reply";
+    return false;
+  }
+  std::string list = splitLines(modifiers.substr(label + 15))[0];
+  if (list != "none") config.modifierMask = parseKeyList(list.c_str());
+
+  return true;
+}
+
+static bool saveDevice(DeviceConsole& console, const SyncOptions& options, SyncReport& report,
+                       std::string& error) {
+  if (!options.save) return true;
+  std::string response;
+  if (!console.run("SAVE", response, error)) return false;
+  if (response.find("Saved") == std::string::npos) {
+    error = "SAVE failed: " + splitLines(response + "\n")[0];
+    return false;
+  }
+  report.saved = true;
+  return true;
+}
+
+bool syncDevice(DeviceConsole& console, const HostConfig& desired, const SyncOptions& options,
+                SyncReport& report, std::string& error) {
+  report = SyncReport();
+  std::string wantHash = hashText(hostConfigHash(desired));
+
+  std::string response;
+  if (!console.run("CONFIG HASH", response, error)) return false;
+  report.deviceHash = parseHashReply(response);
+  if (report.deviceHash == wantHash) {
+    // CONFIG HASH is the live config, which may never have been saved.
+    // SAVE only rewrites bytes that differ, so it costs nothing if it was.
+    report.upToDate = true;
+    if (options.dryRun) return true;
+    return saveDevice(console, options, report, error);
+  }
+
+  HostConfig current;
+  if (!readDeviceConfig(console, current, report.exactReadback, error)) return false;
+  if (!report.deviceHash.empty() && report.deviceHash != hashText(hostConfigHash(current))) {
+    report.exactReadback = false;
+  }
+
+  if (!planSync(current, desired, report.exactReadback, report.ops, error)) return false;
+  if (options.dryRun) return true;
+
+  std::vector<std::string> commands;
+  for (const auto& op : report.ops) commands.push_back(op.command);
+
+  std::vector<ConsoleReply> replies;
+  if (!console.run(commands, replies, error)) return false;
+  for (size_t i = 0; i < replies.size(); i++) {
+    if (replies[i].response.find(report.ops[i].expect) == std::string::npos) {
+      error = "'" + replies[i].command + "' failed: " + splitLines(replies[i].response + "\n")[0];
+      return false;
+    }
+  }
+
+  // Only commit to EEPROM once the device provably holds the desired config
+  if (!report.deviceHash.empty()) {
+    if (!console.run("CONFIG HASH", response, error)) return false;
+    if (parseHashReply(response) != wantHash) {
+      error = "Device hash " + parseHashReply(response) + " does not match " + wantHash +
+              " after sync - not saved";
+      return false;
+    }
+  }
+
+  return saveDevice(console, options, report, error);
+}
@@ -0,0 +1,67 @@
+/*
+ * Host Configuration Sync Interface
+ *
+ * Brings a device to a desired configuration with the fewest console
+ * commands: read back the device bindings, diff them against the config
+ * and send only the MAP / CLEAR / CHORD operations that differ, followed
+ * by a single SAVE. CONFIG HASH reflects the live configuration, so a
+ * device that already matches is sent nothing but the SAVE, in case the
+ * match was never saved.
+ */
+
+#ifndef CONFIG_SYNC_H
+#define CONFIG_SYNC_H
+
+#include <string>
+#include <vector>
+
+#include "config-file.h"
+#include "device-link.h"
+
+//==============================================================================
+// SYNC PLAN
+//==============================================================================
+
+struct SyncOp {
+  std::string command;
+  const char* expect;       // Text present in the device reply on success
+};
+
+// Render encoded UTF-8+ as macro syntax the device encodes back to exactly
+// the same bytes. False if no console-safe text exists (or it is too long).
+bool renderMacro(const std::string& encoded, std::string& text);
+
+// Operations taking a device holding current to desired, in the order
+// CHORD REMOVE, CHORD MODIFIERS, CHORD ADD, MAP / CLEAR. With exact false
+// the readback of current is not trusted: chords are cleared and every
+// desired binding is sent.
+bool planSync(const HostConfig& current, const HostConfig& desired, bool exact,
+              std::vector<SyncOp>& ops, std::string& error);
+
+//==============================================================================
+// DEVICE SYNC
+//==============================================================================
+
+// Read the device configuration via DUMP, or on older firmware via SHOW ALL,
+// CHORD LIST and CHORD MODIFIERS. exact is false if some binding read back
+// as text did not re-encode to what the device holds.
+bool readDeviceConfig(DeviceConsole& console, HostConfig& config, bool& exact,
+                      std::string& error);
+
+struct SyncOptions {
+  bool dryRun = false;      // Plan only, send nothing that changes the device
+  bool save = true;         // Finish with SAVE
+};
+
+struct SyncReport {
+  bool upToDate = false;    // CONFIG HASH already matched, nothing read, only SAVE sent
+  bool exactReadback = true;
+  std::string deviceHash;   // Before sync, empty if the firmware lacks CONFIG HASH
+  std::vector<SyncOp> ops;  // Planned (and unless dryRun, applied) operations
+  bool saved = false;
+};
+
+bool syncDevice(DeviceConsole& console, const HostConfig& desired, const SyncOptions& options,
+                SyncReport& report, std::string& error);
+
+#endif // CONFIG_SYNC_H
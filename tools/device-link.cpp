@@ -0,0 +1,178 @@
+/*
+ * Host Device Link Implementation
+ *
+ * Commands are written up to window ahead of their replies so a sync is
+ * bounded by device processing time rather than round trips.
+ */
+
+#include "device-link.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+static const char PROMPT[] = "keypad> ";
+
+//==============================================================================
+// SERIAL PORT LINK
+//==============================================================================
+
+SerialPortLink::SerialPortLink() : fd(-1) {}
+
+SerialPortLink::~SerialPortLink() {
+  close();
+}
+
+bool SerialPortLink::open(const char* path, std::string& error) {
+  fd = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (fd < 0) {
+    error = std::string("Cannot open ") + path + ": " + strerror(errno);
+    return false;
+  }
+
+  struct termios tio;
+  if (tcgetattr(fd, &tio) != 0) {
+    error = std::string(path) + " is not a serial port";
+    close();
+    return false;
+  }
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, B115200);
+  cfsetospeed(&tio, B115200);
+  tio.c_cflag |= CLOCAL | CREAD;
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = 0;
+  tcsetattr(fd, TCSANOW, &tio);
+  tcflush(fd, TCIOFLUSH);
+  return true;
+}
+
+void SerialPortLink::close() {
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+bool SerialPortLink::write(const std::string& data) {
+  size_t done = 0;
+  while (done < data.size()) {
+    ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+    if (n < 0) {
+      if (errno != EAGAIN && errno != EINTR) return false;
+      struct pollfd pfd = {fd, POLLOUT, 0};
+      poll(&pfd, 1, 100);
+      continue;
+    }
+    done += n;
+  }
+  return true;
+}
+
+int SerialPortLink::read(std::string& data, int timeoutMs) {
+  struct pollfd pfd = {fd, POLLIN, 0};
+  int ready = poll(&pfd, 1, timeoutMs);
+  if (ready < 0) return errno == EINTR ? 0 : -1;
+  if (ready == 0) return 0;
+  if (pfd.revents & (POLLHUP | POLLERR)) return -1;
+
+  char buffer[256];
+  ssize_t n = ::read(fd, buffer, sizeof(buffer));
+  if (n < 0) return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+  data.append(buffer, n);
+  return (int)n;
+}
+
+//==============================================================================
+// COMMAND CONSOLE
+//==============================================================================
+
+DeviceConsole::DeviceConsole(DeviceLink& link, int window, int timeoutMs)
+  : link(link), window(window < 1 ? 1 : window), timeoutMs(timeoutMs), sent(0) {}
+
+bool DeviceConsole::run(const std::vector<std::string>& commands,
+                        std::vector<ConsoleReply>& replies, std::string& error) {
+  size_t next = 0;
+  for (size_t i = 0; i < commands.size(); i++) {
+    // Keep up to window commands in flight
+    while (next < commands.size() && next < i + window) {
+      if (!link.write(commands[next] + "\n")) {
+        error = "Device link lost";
+        return false;
+      }
+      sent++;
+      next++;
+    }
+
+    ConsoleReply reply;
+    reply.command = commands[i];
+    if (!waitForReply(commands[i], reply.response, error)) return false;
+    replies.push_back(reply);
+  }
+  return true;
+}
+
+bool DeviceConsole::run(const std::string& command, std::string& response, std::string& error) {
+  std::vector<ConsoleReply> replies;
+  if (!run(std::vector<std::string>(1, command), replies, error)) return false;
+  response = replies[0].response;
+  return true;
+}
+
+bool DeviceConsole::waitForReply(const std::string& command, std::string& response,
+                                 std::string& error) {
+  // The device echoes "> <command>" on its own line once the line is complete
+  std::string marker = "> " + command + "\n";
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+  for (;;) {
+    size_t start = received.find(marker);
+    size_t end = std::string::npos;
+    if (start != std::string::npos) {
+      end = received.find(PROMPT, start + marker.size());
+    }
+
+    if (end != std::string::npos) {
+      std::string text = received.substr(start + marker.size(),
+                                         end - start - marker.size());
+      received.erase(0, end + strlen(PROMPT));
+
+      // Drop switch state reports interleaved by key presses during a sync
+      response.clear();
+      size_t pos = 0;
+      while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos) eol = text.size() - 1;
+        std::string line = text.substr(pos, eol + 1 - pos);
+        if (line.compare(0, 11, "Switches 0x") != 0) response += line;
+        pos = eol + 1;
+      }
+      return true;
+    }
+
+    int remaining = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+    if (remaining <= 0) {
+      error = "Timed out waiting for reply to '" + command + "'";
+      return false;
+    }
+
+    std::string chunk;
+    int n = link.read(chunk, remaining);
+    if (n < 0) {
+      error = "Device link lost";
+      return false;
+    }
+    for (char c : chunk) {
+      if (c != '\r') received += c;
+    }
+  }
+}
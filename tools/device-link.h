@@ -0,0 +1,86 @@
+/*
+ * Host Device Link Interface
+ *
+ * Byte stream to a keypad console (USB serial port or the in-process
+ * loopback simulator) and the command/response framing on top of it.
+ * A response is the text the device prints between echoing "> <command>"
+ * and its next "keypad> " prompt.
+ */
+
+#ifndef DEVICE_LINK_H
+#define DEVICE_LINK_H
+
+#include <string>
+#include <vector>
+
+//==============================================================================
+// BYTE STREAM
+//==============================================================================
+
+class DeviceLink {
+public:
+  virtual ~DeviceLink() {}
+
+  // Queue bytes for the device; false if the link is gone
+  virtual bool write(const std::string& data) = 0;
+
+  // Append whatever the device has sent, waiting up to timeoutMs for the
+  // first byte. Returns the number of bytes appended, -1 if the link is gone.
+  virtual int read(std::string& data, int timeoutMs) = 0;
+};
+
+// POSIX serial port (e.g. /dev/ttyACM0), raw 115200 8N1
+class SerialPortLink : public DeviceLink {
+public:
+  SerialPortLink();
+  ~SerialPortLink();
+
+  bool open(const char* path, std::string& error);
+  void close();
+
+  bool write(const std::string& data) override;
+  int read(std::string& data, int timeoutMs) override;
+
+private:
+  int fd;
+};
+
+//==============================================================================
+// COMMAND CONSOLE
+//==============================================================================
+
+struct ConsoleReply {
+  std::string command;
+  std::string response;    // Device output for command, '\r' stripped
+};
+
+class DeviceConsole {
+public:
+  // window = commands sent ahead of their responses (1 = lock-step)
+  explicit DeviceConsole(DeviceLink& link, int window = 8, int timeoutMs = 5000);
+
+  // Send commands pipelined, collecting one reply per command in order.
+  // Stops at the first timeout or lost link with error set.
+  bool run(const std::vector<std::string>& commands, std::vector<ConsoleReply>& replies,
+           std::string& error);
+
+  // Single command convenience wrapper
+  bool run(const std::string& command, std::string& response, std::string& error);
+
+  // Total commands written to the device through this console
+  int commandsSent() const { return sent; }
+
+private:
+  bool waitForReply(const std::string& command, std::string& response, std::string& error);
+
+  DeviceLink& link;
+  int window;
+  int timeoutMs;
+  int sent;
+  std::string received;     // Unconsumed device output
+};
+
+// Longest command line the device console accepts (readline buffer - 1)
+static const size_t DEVICE_MAX_COMMAND = 127;
+
+#endif // DEVICE_LINK_H
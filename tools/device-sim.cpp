@@ -0,0 +1,80 @@
+/*
+ * Loopback Device Simulator Implementation
+ *
+ * Shares the firmware globals (macros, chording, Serial, EEPROM) with the
+ * rest of the process - only one simulated device exists at a time.
+ */
+
+#include "device-sim.h"
+
+#include <Arduino.h>
+#include "../storage.h"
+#include "../chording.h"
+#include "../serial-interface.h"
+#include "../builtin-profile.h"
+
+// Simulated paddle has no switches pressed
+uint32_t loopSwitches() {
+  return 0;
+}
+
+//==============================================================================
+// LOOPBACK DEVICE
+//==============================================================================
+
+LoopbackDevice::LoopbackDevice() {
+  powerCycle();
+}
+
+void LoopbackDevice::powerCycle() {
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    setSwitchMacro(i, false, nullptr);
+    setSwitchMacro(i, true, nullptr);
+  }
+  chording.clearAllChords();
+  chording.clearAllModifiers();
+  boot();
+}
+
+void LoopbackDevice::boot() {
+  commands.clear();
+  partialLine.clear();
+
+  // Factory profile and stored configuration, then bring up the console
+  setupBuiltinProfile();
+  processCommand("LOAD");
+  setupSerialInterface();
+}
+
+bool LoopbackDevice::write(const std::string& data) {
+  Serial.appendInput(data);
+
+  for (char c : data) {
+    if (c == '\n' || c == '\r') {
+      if (!partialLine.empty()) commands.push_back(partialLine);
+      partialLine.clear();
+    } else {
+      partialLine += c;
+    }
+  }
+  return true;
+}
+
+int LoopbackDevice::read(std::string& data, int timeoutMs) {
+  // Each pass of the console loop handles at most one line
+  while (Serial.available()) {
+    loopSerialInterface();
+  }
+
+  std::string output = Serial.takeOutput();
+  data += output;
+  return (int)output.size();
+}
+
+int LoopbackDevice::saveCount() const {
+  int count = 0;
+  for (const auto& line : commands) {
+    if (strncasecmp(line.c_str(), "SAVE", 4) == 0) count++;
+  }
+  return count;
+}
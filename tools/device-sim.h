@@ -0,0 +1,43 @@
+/*
+ * Loopback Device Simulator Interface
+ *
+ * A DeviceLink that runs the firmware console in-process: bytes written
+ * are fed to the Serial mock and processed by the real command code, with
+ * EEPROM backed by the EEPROM mock. Lets the sync tool (and its tests) run
+ * without hardware.
+ */
+
+#ifndef DEVICE_SIM_H
+#define DEVICE_SIM_H
+
+#include "device-link.h"
+
+//==============================================================================
+// LOOPBACK DEVICE
+//==============================================================================
+
+class LoopbackDevice : public DeviceLink {
+public:
+  // Boots from whatever the EEPROM mock holds
+  LoopbackDevice();
+
+  // Drop RAM state and boot again - only SAVEd configuration survives
+  void powerCycle();
+
+  bool write(const std::string& data) override;
+  int read(std::string& data, int timeoutMs) override;
+
+  // Command lines the console has received since boot
+  const std::vector<std::string>& commandLog() const { return commands; }
+
+  // Number of SAVE commands (EEPROM write passes) since boot
+  int saveCount() const;
+
+private:
+  void boot();
+
+  std::vector<std::string> commands;
+  std::string partialLine;
+};
+
+#endif // DEVICE_SIM_H
@@ -0,0 +1,55 @@
+/*
+ * Host Event Stream Implementation
+ */
+
+#include "event-stream.h"
+#include "../chording.h"
+#include "../journal.h"
+
+void HostEventReader::feed(const std::string& bytes, std::vector<HostEvent>& events, std::string& text) {
+  pending += bytes;
+
+  size_t i = 0;
+  while (i < pending.size()) {
+    if ((uint8_t)pending[i] != HOST_EVENT_SYNC) {
+      text += pending[i++];
+      continue;
+    }
+    if (pending.size() - i < HOST_EVENT_FRAME_SIZE) break;
+
+    HostEvent event;
+    if (decodeHostEvent((const uint8_t*)pending.data() + i, event)) {
+      events.push_back(event);
+      i += HOST_EVENT_FRAME_SIZE;
+    } else {
+      // Resynchronize on the next sync byte
+      droppedCount++;
+      i++;
+    }
+  }
+  pending.erase(0, i);
+}
+
+// Same words as the journal's chord outcomes
+static std::string formatOutcome(uint32_t outcome) {
+  switch (outcome) {
+    case JOURNAL_CHORD_FIRED:     return "fired";
+    case JOURNAL_CHORD_UNDEFINED: return "undefined";
+    case JOURNAL_CHORD_CANCELLED: return "cancelled";
+    case JOURNAL_CHORD_EXPIRED:   return "expired";
+    case JOURNAL_CHORD_CORRECTED: return "corrected";
+    default:                      return "?";
+  }
+}
+
+std::string formatHostEvent(const HostEvent& event) {
+  switch (event.type) {
+    case HOST_EVENT_PRESS:   return "press " + std::to_string(event.data);
+    case HOST_EVENT_RELEASE: return "release " + std::to_string(event.data);
+    case HOST_EVENT_CHORD:   return std::string("chord ") + formatKeyMask(event.data).c_str();
+    case HOST_EVENT_TYPED:   return "typed " + std::to_string(event.data);
+    case HOST_EVENT_GESTURE: return "gesture " + formatOutcome(event.data >> 24) + " " +
+                                    std::to_string(event.data & 0xFFFFFF) + "ms";
+    default:                 return "event " + std::to_string(event.type);
+  }
+}
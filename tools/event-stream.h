@@ -0,0 +1,35 @@
+/*
+ * Host Event Stream Interface
+ *
+ * Separates the keypad's binary event frames (host-events.h) from the
+ * console text they are interleaved with, across reads that split frames.
+ */
+
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include "../host-events.h"
+
+#include <string>
+#include <vector>
+
+class HostEventReader {
+public:
+  HostEventReader() : droppedCount(0) {}
+
+  // Append device output: whole frames go to events, everything else to
+  // text. A frame cut off at the end is kept for the next call.
+  void feed(const std::string& bytes, std::vector<HostEvent>& events, std::string& text);
+
+  // Frames that failed their check (sync byte then garbage)
+  unsigned dropped() const { return droppedCount; }
+
+private:
+  std::string pending;
+  unsigned droppedCount;
+};
+
+// "press 3", "release 3", "chord 0+1", "typed 5", "gesture fired 120ms"
+std::string formatHostEvent(const HostEvent& event);
+
+#endif // EVENT_STREAM_H
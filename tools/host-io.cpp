@@ -0,0 +1,274 @@
+/*
+ * Host Firmware I/O Implementation
+ *
+ * Everything here is non-blocking: the sketch loop() keeps running while
+ * the console, socket and script are serviced between passes.
+ */
+
+#include "host-io.h"
+
+#include <Arduino.h>
+#include "../chording.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <unistd.h>
+
+//==============================================================================
+// SWITCH INPUT
+//==============================================================================
+
+bool parseSwitchState(const char* text, uint32_t& switches) {
+  if (strcasecmp(text, "NONE") == 0) {
+    switches = 0;
+    return true;
+  }
+  switches = parseKeyList(text);
+  return switches != 0;
+}
+
+static std::string trim(const std::string& text) {
+  size_t start = text.find_first_not_of(" \t\r");
+  if (start == std::string::npos) return "";
+  size_t end = text.find_last_not_of(" \t\r");
+  return text.substr(start, end - start + 1);
+}
+
+bool loadSwitchScript(const char* path, std::vector<SwitchScriptStep>& steps, std::string& error) {
+  std::ifstream file(path);
+  if (!file) {
+    error = std::string("Cannot open ") + path;
+    return false;
+  }
+
+  steps.clear();
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line)) {
+    lineNumber++;
+    size_t hash = line.find('#');
+    if (hash != std::string::npos) line.resize(hash);
+    line = trim(line);
+    if (line.empty()) continue;
+
+    std::string where = std::string(path) + ":" + std::to_string(lineNumber) + ": ";
+    char* rest;
+    unsigned long atMs = strtoul(line.c_str(), &rest, 10);
+    if (rest == line.c_str() || (*rest != ' ' && *rest != '\t')) {
+      error = where + "expected \"<ms> <keys|NONE|EXIT>\"";
+      return false;
+    }
+    if (!steps.empty() && atMs < steps.back().atMs) {
+      error = where + "time goes backwards";
+      return false;
+    }
+
+    SwitchScriptStep step;
+    step.atMs = atMs;
+    step.switches = steps.empty() ? 0 : steps.back().switches;
+    step.exit = false;
+    std::string state = trim(rest);
+    if (strcasecmp(state.c_str(), "EXIT") == 0) {
+      step.exit = true;
+    } else if (!parseSwitchState(state.c_str(), step.switches)) {
+      error = where + "invalid keys '" + state + "'";
+      return false;
+    }
+    steps.push_back(step);
+  }
+  return true;
+}
+
+SwitchSocket::SwitchSocket() : listenFd(-1) {}
+
+SwitchSocket::~SwitchSocket() {
+  for (int fd : clients) close(fd);
+  if (listenFd >= 0) {
+    close(listenFd);
+    unlink(path.c_str());
+  }
+}
+
+bool SwitchSocket::listen(const char* socketPath, std::string& error) {
+  struct sockaddr_un addr;
+  if (strlen(socketPath) >= sizeof(addr.sun_path)) {
+    error = std::string("Socket path too long: ") + socketPath;
+    return false;
+  }
+
+  listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (listenFd < 0) {
+    error = std::string("socket: ") + strerror(errno);
+    return false;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socketPath);
+  unlink(socketPath);
+  if (bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(listenFd, 4) != 0) {
+    error = std::string("Cannot listen on ") + socketPath + ": " + strerror(errno);
+    close(listenFd);
+    listenFd = -1;
+    return false;
+  }
+  path = socketPath;
+  return true;
+}
+
+void SwitchSocket::poll(uint32_t& switches) {
+  if (listenFd < 0) return;
+
+  int fd;
+  while ((fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK)) >= 0) {
+    clients.push_back(fd);
+    partial.push_back("");
+  }
+
+  for (size_t i = 0; i < clients.size(); ) {
+    char buffer[256];
+    ssize_t n = read(clients[i], buffer, sizeof(buffer));
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+      close(clients[i]);
+      clients.erase(clients.begin() + i);
+      partial.erase(partial.begin() + i);
+      continue;
+    }
+    for (ssize_t j = 0; j < n; j++) {
+      if (buffer[j] != '\n') {
+        partial[i] += buffer[j];
+        continue;
+      }
+      std::string line = trim(partial[i]);
+      partial[i].clear();
+      uint32_t state;
+      if (!line.empty() && parseSwitchState(line.c_str(), state)) switches = state;
+    }
+    if (n < 0) i++;
+  }
+}
+
+void SwitchSocket::collectFds(std::vector<int>& fds) const {
+  if (listenFd >= 0) fds.push_back(listenFd);
+  fds.insert(fds.end(), clients.begin(), clients.end());
+}
+
+//==============================================================================
+// SERIAL CONSOLE
+//==============================================================================
+
+ConsolePty::ConsolePty() : masterFd(-1), slaveFd(-1) {}
+
+ConsolePty::~ConsolePty() {
+  if (!link.empty()) unlink(link.c_str());
+  if (slaveFd >= 0) close(slaveFd);
+  if (masterFd >= 0) close(masterFd);
+}
+
+bool ConsolePty::open(const char* linkPath, std::string& error) {
+  masterFd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (masterFd < 0 || grantpt(masterFd) != 0 || unlockpt(masterFd) != 0) {
+    error = std::string("Cannot create pseudo-terminal: ") + strerror(errno);
+    return false;
+  }
+  slave = ptsname(masterFd);
+
+  // Raw like a USB CDC port: no echo, no line editing, no newline mapping
+  slaveFd = ::open(slave.c_str(), O_RDWR | O_NOCTTY);
+  struct termios tio;
+  if (slaveFd < 0 || tcgetattr(slaveFd, &tio) != 0) {
+    error = "Cannot open " + slave + ": " + strerror(errno);
+    return false;
+  }
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, B115200);
+  cfsetospeed(&tio, B115200);
+  tcsetattr(slaveFd, TCSANOW, &tio);
+
+  if (linkPath) {
+    unlink(linkPath);
+    if (symlink(slave.c_str(), linkPath) != 0) {
+      error = std::string("Cannot link ") + linkPath + ": " + strerror(errno);
+      return false;
+    }
+    link = linkPath;
+  }
+  return true;
+}
+
+void ConsolePty::receive() {
+  char buffer[256];
+  ssize_t n;
+  while ((n = read(masterFd, buffer, sizeof(buffer))) > 0) {
+    Serial.appendInput(std::string(buffer, n));
+  }
+}
+
+void ConsolePty::transmit() {
+  std::string output = Serial.takeOutput();
+  if (output.empty()) return;
+
+  std::string wire;
+  for (char c : output) {
+    if (c == '\n') wire += '\r';
+    wire += c;
+  }
+  // Output nobody reads is dropped once the pty buffer fills, as on USB
+  size_t sent = 0;
+  while (sent < wire.size()) {
+    ssize_t n = write(masterFd, wire.data() + sent, wire.size() - sent);
+    if (n <= 0) break;
+    sent += n;
+  }
+}
+
+//==============================================================================
+// EEPROM FILE
+//==============================================================================
+
+bool loadEepromFile(const char* path, std::string& error) {
+  EEPROM.clear();
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return true;
+
+  char byte;
+  for (int address = 0; address < EEPROM.length() && file.get(byte); address++) {
+    EEPROM.write(address, (uint8_t)byte);
+  }
+  if (file.bad()) {
+    error = std::string("Cannot read ") + path;
+    return false;
+  }
+  return true;
+}
+
+bool saveEepromFile(const char* path, std::string& error) {
+  std::string temp = std::string(path) + ".tmp";
+  {
+    std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+    file.write((const char*)EEPROM.getRawMemory(), EEPROM.length());
+    if (!file) {
+      error = "Cannot write " + temp;
+      return false;
+    }
+  }
+  if (rename(temp.c_str(), path) != 0) {
+    error = std::string("Cannot replace ") + path + ": " + strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+//==============================================================================
+// HID LOG
+//==============================================================================
+
+void logHostEvent(FILE* log, uint32_t elapsedUs, const char* what, const std::string& detail) {
+  fprintf(log, "%7u.%03u  %-8s %s\n", elapsedUs / 1000, elapsedUs % 1000, what, detail.c_str());
+  fflush(log);
+}
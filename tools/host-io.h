@@ -0,0 +1,101 @@
+/*
+ * Host Firmware I/O Interface
+ *
+ * The pieces kphost puts around the real sketch: a pseudo-terminal for the
+ * serial console, a file behind the EEPROM mock, switch input from a timed
+ * script or from lines written to a socket, and a timestamped HID log.
+ */
+
+#ifndef HOST_IO_H
+#define HOST_IO_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// SWITCH INPUT
+//==============================================================================
+
+// "<keys|NONE>" -> switch state, e.g. "0+1" -> 0x3; false if not a key list
+bool parseSwitchState(const char* text, uint32_t& switches);
+
+struct SwitchScriptStep {
+  uint32_t atMs;              // Offset from the end of setup()
+  uint32_t switches;
+  bool exit;                  // "EXIT" - stop the host firmware
+};
+
+// One "<ms> <keys|NONE|EXIT>" step per line, '#' comments, times ascending
+bool loadSwitchScript(const char* path, std::vector<SwitchScriptStep>& steps, std::string& error);
+
+// Unix socket taking one "<keys|NONE>" switch state per line
+class SwitchSocket {
+public:
+  SwitchSocket();
+  ~SwitchSocket();
+
+  bool listen(const char* path, std::string& error);
+
+  // Accept clients and apply every complete line to switches; never blocks
+  void poll(uint32_t& switches);
+
+  // Descriptors to wait on (listener and clients)
+  void collectFds(std::vector<int>& fds) const;
+
+private:
+  int listenFd;
+  std::string path;
+  std::vector<int> clients;
+  std::vector<std::string> partial;
+};
+
+//==============================================================================
+// SERIAL CONSOLE
+//==============================================================================
+
+// Raw pseudo-terminal standing in for the USB serial port. The slave side
+// stays open so the console survives clients coming and going.
+class ConsolePty {
+public:
+  ConsolePty();
+  ~ConsolePty();
+
+  // Optional link: symlink to the slave device for a stable path
+  bool open(const char* link, std::string& error);
+
+  const std::string& slavePath() const { return slave; }
+  int fd() const { return masterFd; }
+
+  // Move bytes typed by the client into the Serial mock input
+  void receive();
+
+  // Send the Serial mock output, '\n' as "\r\n" like the device println
+  void transmit();
+
+private:
+  int masterFd;
+  int slaveFd;
+  std::string slave;
+  std::string link;
+};
+
+//==============================================================================
+// EEPROM FILE
+//==============================================================================
+
+// Missing file leaves the EEPROM mock erased; shorter files fill the start
+bool loadEepromFile(const char* path, std::string& error);
+
+// Written whole via a temporary file and rename
+bool saveEepromFile(const char* path, std::string& error);
+
+//==============================================================================
+// HID LOG
+//==============================================================================
+
+// "<ms>.<us>  <what>", one line per loop pass that produced output
+void logHostEvent(FILE* log, uint32_t elapsedUs, const char* what, const std::string& detail);
+
+#endif // HOST_IO_H
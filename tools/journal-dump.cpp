@@ -0,0 +1,105 @@
+/*
+ * Journal Dump Decoding Implementation
+ */
+
+#include "journal-dump.h"
+
+#include <cctype>
+
+//==============================================================================
+// DECODING
+//==============================================================================
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+bool parseJournalDump(const std::string& text, std::vector<uint8_t>& image, std::string& error) {
+  image.clear();
+  if (text.size() >= 2 && text[0] == 'K' && text[1] == 'J') {
+    image.assign(text.begin(), text.end());
+    return true;
+  }
+
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string::npos) end = text.size();
+    std::string line = text.substr(pos, end - pos);
+    pos = end + 1;
+
+    while (!line.empty() && isspace((unsigned char)line.back())) line.pop_back();
+    bool hex = !line.empty() && line.size() % 2 == 0;
+    for (char c : line) hex = hex && hexValue(c) >= 0;
+    if (!hex) continue;
+
+    for (size_t i = 0; i < line.size(); i += 2) {
+      image.push_back(hexValue(line[i]) * 16 + hexValue(line[i + 1]));
+    }
+  }
+
+  if (image.empty()) {
+    error = "No journal data found";
+    return false;
+  }
+  return true;
+}
+
+bool decodeJournalImage(const std::vector<uint8_t>& image, std::vector<JournalEvent>& events,
+                        std::string& error) {
+  events.clear();
+  if (image.size() < JOURNAL_HEADER_SIZE || image[0] != 'K' || image[1] != 'J') {
+    error = "Not a journal image";
+    return false;
+  }
+  if (image[2] != JOURNAL_VERSION) {
+    error = "Unsupported journal version " + std::to_string(image[2]);
+    return false;
+  }
+  size_t count = image[3];
+  if (image.size() < JOURNAL_HEADER_SIZE + count * JOURNAL_ENTRY_SIZE) {
+    error = "Journal image truncated: " + std::to_string(count) + " entries expected";
+    return false;
+  }
+
+  uint32_t ms = 0;
+  for (size_t i = 0; i < count; i++) {
+    JournalEvent event;
+    event.entry = decodeJournalEntry(&image[JOURNAL_HEADER_SIZE + i * JOURNAL_ENTRY_SIZE]);
+    if (i > 0) ms += (uint16_t)(event.entry.timeMs - events.back().entry.timeMs);
+    event.ms = ms;
+    events.push_back(event);
+  }
+  return true;
+}
+
+//==============================================================================
+// REPLAY
+//==============================================================================
+
+std::string journalToScript(const std::vector<JournalEvent>& events) {
+  std::string script;
+  uint32_t lastMs = 0;
+  for (const auto& event : events) {
+    if (event.entry.type != JOURNAL_SWITCHES) continue;
+    uint32_t switches = event.entry.data;
+    script += std::to_string(event.ms) + " ";
+    if (switches == 0) {
+      script += "NONE";
+    } else {
+      for (int key = 0, first = 1; key < 32; key++) {
+        if (!(switches & (1UL << key))) continue;
+        if (!first) script += "+";
+        script += std::to_string(key);
+        first = 0;
+      }
+    }
+    script += "\n";
+    lastMs = event.ms;
+  }
+  script += std::to_string(lastMs + 1000) + " EXIT\n";
+  return script;
+}
@@ -0,0 +1,40 @@
+/*
+ * Journal Dump Decoding Interface
+ *
+ * Turns the output of JOURNAL DUMP (hex lines, as captured from the
+ * console) or a raw image back into journal entries with unwrapped
+ * timestamps, and replays switch edges as a kphost script.
+ */
+
+#ifndef JOURNAL_DUMP_H
+#define JOURNAL_DUMP_H
+
+#include "../journal.h"
+
+#include <string>
+#include <vector>
+
+//==============================================================================
+// DECODING
+//==============================================================================
+
+struct JournalEvent {
+  uint32_t ms;              // From the oldest entry; gaps over 65 s fold
+  JournalEntry entry;
+};
+
+// Raw image (starts "KJ") or console text: every line made only of hex
+// digit pairs is image data, anything else (echo, prompt) is skipped
+bool parseJournalDump(const std::string& text, std::vector<uint8_t>& image, std::string& error);
+
+bool decodeJournalImage(const std::vector<uint8_t>& image, std::vector<JournalEvent>& events,
+                        std::string& error);
+
+//==============================================================================
+// REPLAY
+//==============================================================================
+
+// "<ms> <keys|NONE>" for each switch edge, then EXIT a second after the last
+std::string journalToScript(const std::vector<JournalEvent>& events);
+
+#endif // JOURNAL_DUMP_H
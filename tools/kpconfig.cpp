@@ -0,0 +1,323 @@
+/*
+ * kpconfig - Host Configuration Tool
+ *
+ * Works on text config files (MAP / CHORD lines) without a device attached
+ *
+ * Usage:
+ *   kpconfig hash <config>     Print the hash a device reports for CONFIG HASH
+ *   kpconfig compile <config> [--board NAME] [--flash-size SIZE] [--format bin|hex|header] [-o FILE]
+ *                              Validate and emit a ready-to-flash storage image
+ *   kpconfig sync <config> (--port DEVICE | --loopback [STATE]) [--dry-run] [--no-save]
+ *                              Send only the changes a device needs, then SAVE once
+ *   kpconfig show (--port DEVICE | <dump-file>)
+ *                              Print a device's bindings from DUMP, decoded here
+ */
+
+#include "config-file.h"
+#include "config-image.h"
+#include "config-sync.h"
+#include "binding-dump.h"
+#include "device-sim.h"
+#include "../config-hash.h"
+#include "../storage.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static void printErrors(const char* path, const std::vector<ConfigError>& errors) {
+  for (const auto& err : errors) {
+    if (err.line > 0) {
+      fprintf(stderr, "%s:%d: error: %s\n", path, err.line, err.message.c_str());
+    } else {
+      fprintf(stderr, "%s: error: %s\n", path, err.message.c_str());
+    }
+  }
+}
+
+static void usage() {
+  fprintf(stderr, "Usage:\n");
+  fprintf(stderr, "  kpconfig hash <config>\n");
+  fprintf(stderr, "  kpconfig compile <config> [--board NAME] [--flash-size SIZE] [--format bin|hex|header] [-o FILE]\n");
+  fprintf(stderr, "  kpconfig sync <config> (--port DEVICE | --loopback [STATE]) [--dry-run] [--no-save]\n");
+  fprintf(stderr, "  kpconfig show (--port DEVICE | <dump-file>)\n");
+  fprintf(stderr, "\nBoards: %s\n", boardNames().c_str());
+  fprintf(stderr, "\nOn pico and kb2040 the EEPROM is the last 4K of flash, so hex output\n");
+  fprintf(stderr, "is addressed for 2M (pico) or 8M (kb2040) of flash with no filesystem.\n");
+  fprintf(stderr, "--flash-size (bytes, or with a K or M suffix) sets another flash size.\n");
+}
+
+// Bytes, or kilobytes / megabytes with a K / M suffix; 0 if malformed
+static uint32_t parseFlashSize(const char* text) {
+  char* end;
+  unsigned long size = strtoul(text, &end, 10);
+  if (end == text) return 0;
+  if (*end == 'K' || *end == 'k') {
+    size <<= 10;
+    end++;
+  } else if (*end == 'M' || *end == 'm') {
+    size <<= 20;
+    end++;
+  }
+  return (*end == '\0' && size <= 0x0FFFFFFFUL) ? size : 0;
+}
+
+//==============================================================================
+// SUBCOMMANDS
+//==============================================================================
+
+static int cmdHash(const char* path) {
+  HostConfig config;
+  std::vector<ConfigError> errors;
+  if (!loadConfigFile(path, config, errors)) {
+    printErrors(path, errors);
+    return 1;
+  }
+
+  char hashText[17];
+  formatConfigHash(hostConfigHash(config), hashText);
+  printf("%s\n", hashText);
+  return 0;
+}
+
+static int cmdCompile(int argc, char* argv[]) {
+  const char* path = nullptr;
+  const char* boardName = "teensy";
+  const char* format = "bin";
+  const char* outPath = nullptr;
+  const char* flashSizeText = nullptr;
+
+  for (int i = 0; i < argc; i++) {
+    if (strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+      boardName = argv[++i];
+    } else if (strcmp(argv[i], "--flash-size") == 0 && i + 1 < argc) {
+      flashSizeText = argv[++i];
+    } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+      format = argv[++i];
+    } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      outPath = argv[++i];
+    } else if (!path && argv[i][0] != '-') {
+      path = argv[i];
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  const BoardInfo* board = findBoard(boardName);
+  if (!path || !board) {
+    if (!board) fprintf(stderr, "Unknown board '%s'\n", boardName);
+    usage();
+    return 2;
+  }
+  if (strcmp(format, "bin") != 0 && strcmp(format, "hex") != 0 && strcmp(format, "header") != 0) {
+    fprintf(stderr, "Unknown format '%s'\n", format);
+    usage();
+    return 2;
+  }
+  uint32_t flashSize = board->flashSize;
+  if (flashSizeText) {
+    flashSize = parseFlashSize(flashSizeText);
+    if (board->flashBase == 0) {
+      fprintf(stderr, "%s EEPROM is not in flash - --flash-size does not apply\n", board->name);
+      return 2;
+    }
+  }
+  uint32_t hexAddress = boardHexAddress(*board, flashSize);
+  if (board->flashBase != 0 && hexAddress == 0) {
+    fprintf(stderr, "Invalid flash size '%s'\n", flashSizeText);
+    usage();
+    return 2;
+  }
+
+  HostConfig config;
+  std::vector<ConfigError> errors;
+  if (!loadConfigFile(path, config, errors)) {
+    printErrors(path, errors);
+    return 1;
+  }
+
+  std::vector<uint8_t> image;
+  uint16_t usedBytes;
+  std::string error;
+  if (!buildConfigImage(config, *board, image, usedBytes, error)) {
+    fprintf(stderr, "%s: error: %s\n", path, error.c_str());
+    return 1;
+  }
+
+  FILE* out = outPath ? fopen(outPath, strcmp(format, "bin") == 0 ? "wb" : "w") : stdout;
+  if (!out) {
+    perror(outPath);
+    return 1;
+  }
+
+  if (strcmp(format, "bin") == 0) {
+    writeImageBinary(out, image);
+  } else if (strcmp(format, "hex") == 0) {
+    writeImageIntelHex(out, image, hexAddress);
+  } else {
+    writeImageHeader(out, image, usedBytes, path, *board);
+  }
+
+  if (outPath) fclose(out);
+
+  char hashText[17];
+  formatConfigHash(hostConfigHash(config), hashText);
+  fprintf(stderr, "%s: %u of %u bytes, config hash %s\n", board->name, usedBytes, board->eepromSize, hashText);
+  return 0;
+}
+
+static int cmdSync(int argc, char* argv[]) {
+  const char* path = nullptr;
+  const char* port = nullptr;
+  const char* statePath = nullptr;
+  bool loopback = false;
+  SyncOptions options;
+
+  for (int i = 0; i < argc; i++) {
+    if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+      port = argv[++i];
+    } else if (strcmp(argv[i], "--loopback") == 0) {
+      loopback = true;
+      if (i + 1 < argc && argv[i + 1][0] != '-' && path) statePath = argv[++i];
+    } else if (strcmp(argv[i], "--dry-run") == 0) {
+      options.dryRun = true;
+    } else if (strcmp(argv[i], "--no-save") == 0) {
+      options.save = false;
+    } else if (!path && argv[i][0] != '-') {
+      path = argv[i];
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (!path || loopback == (port != nullptr)) {
+    usage();
+    return 2;
+  }
+
+  HostConfig desired;
+  std::vector<ConfigError> errors;
+  if (!loadConfigFile(path, desired, errors)) {
+    printErrors(path, errors);
+    return 1;
+  }
+
+  std::string error;
+  SerialPortLink serialLink;
+  std::unique_ptr<LoopbackDevice> simulator;
+  DeviceLink* link;
+
+  if (loopback) {
+    // Simulated device boots from STATE as if it had been flashed and saved
+    if (statePath) {
+      HostConfig state;
+      std::vector<uint8_t> image;
+      uint16_t usedBytes;
+      if (!loadConfigFile(statePath, state, errors)) {
+        printErrors(statePath, errors);
+        return 1;
+      }
+      if (!buildConfigImage(state, *findBoard("pico"), image, usedBytes, error)) {
+        fprintf(stderr, "%s: error: %s\n", statePath, error.c_str());
+        return 1;
+      }
+      installConfigImage(image.data(), usedBytes);
+    }
+    simulator.reset(new LoopbackDevice());
+    link = simulator.get();
+  } else {
+    if (!serialLink.open(port, error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    link = &serialLink;
+  }
+
+  DeviceConsole console(*link);
+  SyncReport report;
+  bool ok = syncDevice(console, desired, options, report, error);
+
+  for (const auto& op : report.ops) {
+    printf("%s%s\n", options.dryRun ? "would send: " : "sent: ", op.command.c_str());
+  }
+  if (!ok) {
+    fprintf(stderr, "sync failed: %s\n", error.c_str());
+    return 1;
+  }
+
+  if (report.upToDate) {
+    printf("Device already matches %s (config hash %s)%s\n", path, report.deviceHash.c_str(),
+           report.saved ? ", saved" : "");
+  } else {
+    if (!report.exactReadback) {
+      fprintf(stderr, "warning: device bindings did not read back exactly - resent in full\n");
+    }
+    printf("%zu operation%s%s, %d console commands\n", report.ops.size(),
+           report.ops.size() == 1 ? "" : "s",
+           report.saved ? ", saved" : (options.dryRun ? " planned" : ", not saved"),
+           console.commandsSent());
+  }
+  return 0;
+}
+
+static int cmdShow(int argc, char* argv[]) {
+  std::string text, error;
+  if (argc == 2 && strcmp(argv[0], "--port") == 0) {
+    SerialPortLink link;
+    if (!link.open(argv[1], error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    DeviceConsole console(link, 1);
+    if (!console.run("DUMP", text, error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+  } else if (argc == 1 && argv[0][0] != '-') {
+    std::ifstream file(argv[0], std::ios::binary);
+    if (!file) {
+      fprintf(stderr, "Cannot open %s\n", argv[0]);
+      return 1;
+    }
+    text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  } else {
+    usage();
+    return 2;
+  }
+
+  BindingDump dump;
+  if (!parseBindingDump(text, dump, error)) {
+    fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+  printf("%s", formatBindingDump(dump).c_str());
+  return 0;
+}
+
+//==============================================================================
+// MAIN
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+  if (argc == 3 && strcmp(argv[1], "hash") == 0) {
+    return cmdHash(argv[2]);
+  }
+  if (argc >= 3 && strcmp(argv[1], "compile") == 0) {
+    return cmdCompile(argc - 2, argv + 2);
+  }
+  if (argc >= 3 && strcmp(argv[1], "sync") == 0) {
+    return cmdSync(argc - 2, argv + 2);
+  }
+  if (argc >= 3 && strcmp(argv[1], "show") == 0) {
+    return cmdShow(argc - 2, argv + 2);
+  }
+
+  usage();
+  return 2;
+}
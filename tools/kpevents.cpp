@@ -0,0 +1,202 @@
+/*
+ * kpevents - Host Event Listener
+ *
+ * Reference listener for the binary event channel: turns it on (EVENTS ON)
+ * and prints one line per event, "<device us> press 3", for automation to
+ * read. With --latency it drives kphost's switch socket instead and times
+ * each switch change to the event it produces.
+ *
+ * Usage:
+ *   kpevents --port DEVICE [--text]
+ *   kpevents --port DEVICE --latency SOCKET [--keys K] [--count N]
+ */
+
+#include "event-stream.h"
+#include "device-link.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+// The firmware command set is linked in; there is no switch hardware here
+uint32_t loopSwitches() {
+  return 0;
+}
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void requestStop(int) {
+  stopRequested = 1;
+}
+
+static void usage() {
+  fprintf(stderr, "Usage:\n");
+  fprintf(stderr, "  kpevents --port DEVICE [--text]\n");
+  fprintf(stderr, "  kpevents --port DEVICE --latency SOCKET [--keys K] [--count N]\n");
+  fprintf(stderr, "\n--text also passes console text to stderr; --latency times events\n");
+  fprintf(stderr, "from kphost's switch socket (default keys 0, 100 presses)\n");
+}
+
+static int connectSocket(const char* path, std::string& error) {
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    error = std::string("Cannot connect to ") + path;
+    if (fd >= 0) close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static uint64_t hostMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Read until at least one event arrives or timeoutMs passes
+static bool waitForEvent(DeviceLink& link, HostEventReader& reader, int timeoutMs,
+                         std::vector<HostEvent>& events) {
+  uint64_t deadline = hostMicros() + timeoutMs * 1000ULL;
+  std::string text;
+  while (events.empty() && hostMicros() < deadline) {
+    std::string data;
+    if (link.read(data, 1) < 0) return false;
+    reader.feed(data, events, text);
+  }
+  return true;
+}
+
+//==============================================================================
+// MODES
+//==============================================================================
+
+static int listen(DeviceLink& link, bool passText) {
+  HostEventReader reader;
+  while (!stopRequested) {
+    std::string data;
+    if (link.read(data, 100) < 0) {
+      fprintf(stderr, "kpevents: device gone\n");
+      return 1;
+    }
+    std::vector<HostEvent> events;
+    std::string text;
+    reader.feed(data, events, text);
+    for (const HostEvent& event : events) {
+      printf("%lu %s\n", (unsigned long)event.timeUs, formatHostEvent(event).c_str());
+    }
+    if (passText) fputs(text.c_str(), stderr);
+    fflush(stdout);
+  }
+  return 0;
+}
+
+static int measureLatency(DeviceLink& link, int socketFd, const std::string& keys, int count) {
+  HostEventReader reader;
+  std::vector<uint32_t> latencies;
+  int missing = 0;
+
+  for (int i = 0; i < count * 2 && !stopRequested; i++) {
+    std::string line = (i % 2 == 0 ? keys : std::string("NONE")) + "\n";
+    std::vector<HostEvent> events;
+    uint64_t sentUs = hostMicros();
+    if (write(socketFd, line.data(), line.size()) != (ssize_t)line.size() ||
+        !waitForEvent(link, reader, 200, events)) {
+      fprintf(stderr, "kpevents: link to kphost lost\n");
+      return 1;
+    }
+    if (events.empty()) {
+      missing++;
+    } else {
+      latencies.push_back(hostMicros() - sentUs);
+    }
+    // Let the chord engine settle between changes
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  if (latencies.empty()) {
+    fprintf(stderr, "kpevents: no events - are keys %s unbound or an undefined chord?\n", keys.c_str());
+    return 1;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  uint64_t total = 0;
+  for (uint32_t latency : latencies) total += latency;
+  printf("%u events, %d changes without one\n", (unsigned)latencies.size(), missing);
+  printf("Switch to event: min %u, median %u, avg %u, max %u us\n", latencies.front(),
+         latencies[latencies.size() / 2], (unsigned)(total / latencies.size()), latencies.back());
+  if (reader.dropped()) printf("%u damaged frames\n", reader.dropped());
+  return 0;
+}
+
+//==============================================================================
+// MAIN
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+  const char* port = nullptr;
+  const char* latencySocket = nullptr;
+  std::string keys = "0";
+  int count = 100;
+  bool passText = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+      port = argv[++i];
+    } else if (strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
+      latencySocket = argv[++i];
+    } else if (strcmp(argv[i], "--keys") == 0 && i + 1 < argc) {
+      keys = argv[++i];
+    } else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+      count = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--text") == 0) {
+      passText = true;
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (!port || count <= 0) {
+    usage();
+    return 2;
+  }
+
+  std::string error;
+  std::string response;
+  SerialPortLink link;
+  int socketFd = -1;
+  if (!link.open(port, error) ||
+      (latencySocket && (socketFd = connectSocket(latencySocket, error)) < 0)) {
+    fprintf(stderr, "kpevents: %s\n", error.c_str());
+    return 1;
+  }
+  {
+    DeviceConsole console(link, 1);
+    if (!console.run("EVENTS ON", response, error)) {
+      fprintf(stderr, "kpevents: %s\n", error.c_str());
+      return 1;
+    }
+  }
+
+  signal(SIGINT, requestStop);
+  signal(SIGTERM, requestStop);
+
+  int result = latencySocket ? measureLatency(link, socketFd, keys, count) : listen(link, passText);
+
+  // Hand the console back with its text switch prints
+  DeviceConsole console(link, 1);
+  console.run("EVENTS OFF", response, error);
+  if (socketFd >= 0) close(socketFd);
+  return result;
+}
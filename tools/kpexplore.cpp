@@ -0,0 +1,131 @@
+/*
+ * kpexplore - Chord State Machine Explorer
+ *
+ * Exhaustively checks the firmware chord engine over bounded switch-event
+ * sequences and reports worst-case chord latency
+ *
+ * Usage:
+ *   kpexplore [--keys N] [--chord KEYS]... [--modifiers KEYS] [--window MS]
+ *             [--delays MS,MS,...] [--depth N] [--jobs N]
+ */
+
+#include "chord-explore.h"
+#include "../chording.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+// The firmware command set is linked in; there is no switch hardware here
+uint32_t loopSwitches() {
+  return 0;
+}
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static void usage() {
+  fprintf(stderr, "Usage:\n");
+  fprintf(stderr, "  kpexplore [--keys N] [--chord KEYS]... [--modifiers KEYS] [--window MS]\n");
+  fprintf(stderr, "            [--delays MS,MS,...] [--depth N] [--jobs N]\n");
+  fprintf(stderr, "\nDefaults: 4 keys, chords 0+1 1+2 0+1+2, depth 5, one job per core\n");
+}
+
+static std::vector<uint32_t> parseDelays(const char* text) {
+  std::vector<uint32_t> delays;
+  while (*text) {
+    char* end;
+    unsigned long ms = strtoul(text, &end, 10);
+    if (end == text || ms == 0) return {};
+    delays.push_back(ms);
+    text = (*end == ',') ? end + 1 : end;
+  }
+  return delays;
+}
+
+static std::string keyText(uint32_t keyMask) {
+  return formatKeyMask(keyMask).c_str();
+}
+
+//==============================================================================
+// MAIN
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+  ExploreConfig config;
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  config.jobs = cores > 0 ? cores : 1;
+
+  for (int i = 1; i < argc; i++) {
+    const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (strcmp(argv[i], "--keys") == 0) {
+      config.keys = atoi(value);
+    } else if (strcmp(argv[i], "--chord") == 0) {
+      uint32_t mask = parseKeyList(value);
+      if (mask == 0) {
+        fprintf(stderr, "Invalid chord: %s\n", value);
+        return 2;
+      }
+      config.chords.push_back(mask);
+    } else if (strcmp(argv[i], "--modifiers") == 0) {
+      config.modifierMask = parseKeyList(value);
+    } else if (strcmp(argv[i], "--window") == 0) {
+      config.windowMs = atoi(value);
+    } else if (strcmp(argv[i], "--delays") == 0) {
+      config.delaysMs = parseDelays(value);
+      if (config.delaysMs.empty()) {
+        fprintf(stderr, "Invalid delays: %s\n", value);
+        return 2;
+      }
+    } else if (strcmp(argv[i], "--depth") == 0) {
+      config.depth = atoi(value);
+    } else if (strcmp(argv[i], "--jobs") == 0) {
+      config.jobs = atoi(value);
+    } else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+  if (config.chords.empty()) config.chords = {0x03, 0x06, 0x07};
+  if (config.depth == 0 || config.windowMs < 2) {
+    usage();
+    return 2;
+  }
+
+  ExploreResult result;
+  std::string error;
+  if (!exploreChords(config, result, error)) {
+    fprintf(stderr, "kpexplore: %s\n", error.c_str());
+    return 1;
+  }
+
+  printf("%llu sequences, %llu events, depth %u, %u keys, %u jobs\n",
+         (unsigned long long)result.sequences, (unsigned long long)result.events,
+         config.depth, config.keys, config.jobs);
+
+  printf("\nChord      fires        press-to-execute   release-to-execute\n");
+  for (const auto& chord : result.latency) {
+    if (chord.fires == 0) {
+      printf("%-10s never fired\n", keyText(chord.keyMask).c_str());
+      continue;
+    }
+    printf("%-10s %-12llu %5u - %5u ms     max %5u ms\n", keyText(chord.keyMask).c_str(),
+           (unsigned long long)chord.fires, chord.minPressMs, chord.maxPressMs,
+           chord.maxReleaseMs);
+  }
+
+  if (result.violations > 0) {
+    printf("\n%llu invariant violations, e.g.\n", (unsigned long long)result.violations);
+    for (const auto& example : result.examples) printf("  %s\n", example.c_str());
+    return 1;
+  }
+  printf("\nNo invariant violations\n");
+  return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * kphost - Full Firmware Host Build
+ *
+ * Compiles keypaddle.ino itself against the test mocks and runs setup()
+ * and loop() on Linux. The serial console is a pseudo-terminal (kpconfig
+ * sync --port works against it), EEPROM lives in a file, switches come from
+ * a script or a socket, and HID output is logged with timestamps.
+ *
+ * Usage:
+ *   kphost [--eeprom FILE] [--link PATH] [--script FILE] [--socket PATH] [--log FILE]
+ */
+
+#include "host-io.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+
+// Prototypes the Arduino build generates for the sketch
+void processSwitchChanges(uint32_t current, uint32_t previous);
+void handleKeyEvent(uint8_t keyIndex, uint8_t event);
+void printSystemStatus();
+void loopInput();
+void pollMacroInput();
+uint32_t readInputSwitches();
+bool isKeyUnbound(uint8_t keyIndex);
+void sendChordEvent(uint32_t keyMask);
+void sendSpeedEvent(bool gesture, uint32_t data);
+
+#include "../keypaddle.ino"
+
+//==============================================================================
+// SWITCH HARDWARE
+//==============================================================================
+
+// Written by the script and socket, read by loop() as the debounced state
+static uint32_t hostSwitches = 0;
+
+void setupSwitches() {
+}
+
+uint32_t loopSwitches() {
+  return hostSwitches;
+}
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void requestStop(int) {
+  stopRequested = 1;
+}
+
+static void usage() {
+  fprintf(stderr, "Usage:\n");
+  fprintf(stderr, "  kphost [--eeprom FILE] [--link PATH] [--script FILE] [--socket PATH] [--log FILE]\n");
+  fprintf(stderr, "\nScript lines: <ms> <keys|NONE|EXIT>   Socket lines: <keys|NONE>\n");
+}
+
+// Wait for console or socket input, at most one millisecond
+static void waitForInput(const ConsolePty& console, const SwitchSocket& socket) {
+  std::vector<int> fds;
+  fds.push_back(console.fd());
+  socket.collectFds(fds);
+
+  std::vector<struct pollfd> polled;
+  for (int fd : fds) polled.push_back({fd, POLLIN, 0});
+  ::poll(polled.data(), polled.size(), 1);
+}
+
+//==============================================================================
+// MAIN
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+  const char* eepromPath = "kphost.eeprom";
+  const char* linkPath = nullptr;
+  const char* scriptPath = nullptr;
+  const char* socketPath = nullptr;
+  const char* logPath = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (strcmp(argv[i], "--eeprom") == 0) {
+      eepromPath = value;
+    } else if (strcmp(argv[i], "--link") == 0) {
+      linkPath = value;
+    } else if (strcmp(argv[i], "--script") == 0) {
+      scriptPath = value;
+    } else if (strcmp(argv[i], "--socket") == 0) {
+      socketPath = value;
+    } else if (strcmp(argv[i], "--log") == 0) {
+      logPath = value;
+    } else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+
+  std::string error;
+  std::vector<SwitchScriptStep> script;
+  ConsolePty console;
+  SwitchSocket socket;
+  if ((scriptPath && !loadSwitchScript(scriptPath, script, error)) ||
+      !loadEepromFile(eepromPath, error) ||
+      !console.open(linkPath, error) ||
+      (socketPath && !socket.listen(socketPath, error))) {
+    fprintf(stderr, "kphost: %s\n", error.c_str());
+    return 1;
+  }
+
+  FILE* log = stdout;
+  if (logPath && !(log = fopen(logPath, "w"))) {
+    fprintf(stderr, "kphost: cannot write %s\n", logPath);
+    return 1;
+  }
+  fprintf(stderr, "kphost: console on %s%s%s\n", console.slavePath().c_str(),
+          linkPath ? " -> " : "", linkPath ? linkPath : "");
+
+  signal(SIGINT, requestStop);
+  signal(SIGTERM, requestStop);
+  signal(SIGPIPE, SIG_IGN);
+
+  setup();
+  console.transmit();
+  Keyboard.clearActions();
+  Mouse.clearReports();
+
+  std::vector<uint8_t> savedEeprom(EEPROM.getRawMemory(), EEPROM.getRawMemory() + EEPROM.length());
+  uint32_t startUs = micros();
+  uint32_t loggedSwitches = 0;
+  size_t nextStep = 0;
+
+  while (!stopRequested) {
+    uint32_t elapsedUs = micros() - startUs;
+    while (nextStep < script.size() && script[nextStep].atMs * 1000UL <= elapsedUs) {
+      if (script[nextStep].exit) stopRequested = 1;
+      hostSwitches = script[nextStep++].switches;
+    }
+    console.receive();
+    socket.poll(hostSwitches);
+
+    if (hostSwitches != loggedSwitches) {
+      logHostEvent(log, elapsedUs, "switches", formatKeyMask(hostSwitches).c_str());
+      loggedSwitches = hostSwitches;
+    }
+
+    loop();
+
+    if (!Keyboard.getActions().empty()) {
+      logHostEvent(log, micros() - startUs, "hid", Keyboard.toString());
+      Keyboard.clearActions();
+    }
+    if (!Mouse.getReports().empty()) {
+      logHostEvent(log, micros() - startUs, "mouse", Mouse.toString());
+      Mouse.clearReports();
+    }
+    console.transmit();
+
+    if (!EEPROM.compareMemory(savedEeprom.data())) {
+      if (!saveEepromFile(eepromPath, error)) fprintf(stderr, "kphost: %s\n", error.c_str());
+      EEPROM.copyMemory(savedEeprom.data());
+    }
+
+    if (!stopRequested) waitForInput(console, socket);
+  }
+
+  if (log != stdout) fclose(log);
+  return 0;
+}
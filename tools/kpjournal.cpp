@@ -0,0 +1,101 @@
+/*
+ * kpjournal - Event Journal Reader
+ *
+ * Decodes the device's black-box journal (JOURNAL DUMP) for post-mortem
+ * analysis, or turns its switch edges into a kphost script to replay them
+ *
+ * Usage:
+ *   kpjournal <dump-file> [--script]
+ *   kpjournal --port DEVICE [--saved] [--script]
+ */
+
+#include "journal-dump.h"
+#include "device-link.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// The firmware command set is linked in; there is no switch hardware here
+uint32_t loopSwitches() {
+  return 0;
+}
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+static void usage() {
+  fprintf(stderr, "Usage:\n");
+  fprintf(stderr, "  kpjournal <dump-file> [--script]\n");
+  fprintf(stderr, "  kpjournal --port DEVICE [--saved] [--script]\n");
+  fprintf(stderr, "\n--saved reads the EEPROM copy, --script prints a kphost switch script\n");
+}
+
+static bool readDump(const char* path, std::string& text, std::string& error) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    error = std::string("Cannot open ") + path;
+    return false;
+  }
+  text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+static bool fetchDump(const char* port, bool saved, std::string& text, std::string& error) {
+  SerialPortLink link;
+  if (!link.open(port, error)) return false;
+  DeviceConsole console(link, 1);
+  return console.run(saved ? "JOURNAL DUMP SAVED" : "JOURNAL DUMP", text, error);
+}
+
+//==============================================================================
+// MAIN
+//==============================================================================
+
+int main(int argc, char* argv[]) {
+  const char* path = nullptr;
+  const char* port = nullptr;
+  bool saved = false;
+  bool script = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+      port = argv[++i];
+    } else if (strcmp(argv[i], "--saved") == 0) {
+      saved = true;
+    } else if (strcmp(argv[i], "--script") == 0) {
+      script = true;
+    } else if (!path && argv[i][0] != '-') {
+      path = argv[i];
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if ((path != nullptr) == (port != nullptr) || (saved && !port)) {
+    usage();
+    return 2;
+  }
+
+  std::string text;
+  std::string error;
+  std::vector<uint8_t> image;
+  std::vector<JournalEvent> events;
+  if (!(port ? fetchDump(port, saved, text, error) : readDump(path, text, error)) ||
+      !parseJournalDump(text, image, error) ||
+      !decodeJournalImage(image, events, error)) {
+    fprintf(stderr, "kpjournal: %s\n", error.c_str());
+    return 1;
+  }
+
+  if (script) {
+    fputs(journalToScript(events).c_str(), stdout);
+    return 0;
+  }
+  for (const auto& event : events) {
+    printf("%8u ms  %s\n", event.ms, formatJournalEntry(event.entry).c_str());
+  }
+  return 0;
+}
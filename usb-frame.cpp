@@ -0,0 +1,137 @@
+/*
+ * USB Frame Tracking Implementation
+ *
+ * Teensy 2.0: frame number from UDFNUMH:L, keyboard endpoint drained when
+ * its busy-bank count (UESTA0X NBUSYBK) reaches zero.
+ * RP2040: frame number from the controller's SOF_RD register, endpoint
+ * drained when TinyUSB reports the HID interface ready.
+ * Host builds: a frame every 1000 us of micros(), and the host "polls" at
+ * the start of each frame.
+ */
+
+#include "usb-frame.h"
+
+#if defined(__AVR__) && defined(CORE_TEENSY)
+#include <avr/interrupt.h>
+#include "hardware/usb_private.h"
+#elif defined(ARDUINO_ARCH_RP2040)
+#include <hardware/structs/usb.h>
+#include <tusb.h>
+#endif
+
+//==============================================================================
+// STATE
+//==============================================================================
+
+static uint16_t lastFrame;
+static bool frameSeen = false;
+static uint32_t frameStartUs;
+
+static bool reportPending = false;
+static uint16_t reportFrame;     // Frame the pending report was queued in
+static uint32_t reportQueuedUs;
+
+static UsbFrameStats stats = { 0, 0, 0xFFFFFFFF, 0, 0 };
+
+//==============================================================================
+// PLATFORM ACCESS
+//==============================================================================
+
+#if defined(__AVR__) && defined(CORE_TEENSY)
+
+static bool readFrame(uint16_t& frame) {
+  if (!usb_configuration || usb_suspended) return false;
+  uint8_t low = UDFNUML;
+  frame = ((uint16_t)(UDFNUMH & 0x07) << 8) | low;
+  return true;
+}
+
+static bool keyboardDrained() {
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t saved = UENUM;
+  UENUM = KEYBOARD_ENDPOINT;
+  bool drained = (UESTA0X & 0x03) == 0;
+  UENUM = saved;
+  SREG = sreg;
+  return drained;
+}
+
+#elif defined(ARDUINO_ARCH_RP2040)
+
+static bool readFrame(uint16_t& frame) {
+  if (!tud_mounted() || tud_suspended()) return false;
+  frame = usb_hw->sof_rd & USB_SOF_RD_BITS;
+  return true;
+}
+
+static bool keyboardDrained() {
+  return tud_hid_ready();
+}
+
+#else
+
+static bool readFrame(uint16_t& frame) {
+  frame = (micros() / 1000) & 0x7FF;
+  return true;
+}
+
+static bool keyboardDrained() {
+  return lastFrame != reportFrame;
+}
+
+#endif
+
+//==============================================================================
+// FRAME TRACKING
+//==============================================================================
+
+bool loopUsbFrame() {
+  uint16_t frame;
+  if (!readFrame(frame)) {
+    frameSeen = false;
+    return false;
+  }
+
+  bool started = frameSeen && frame != lastFrame;
+  if (started || !frameSeen) {
+    frameStartUs = micros();
+    lastFrame = frame;
+  }
+  if (started) stats.frames++;
+  frameSeen = true;
+
+  if (reportPending && keyboardDrained()) {
+    uint32_t wait = micros() - reportQueuedUs;
+    reportPending = false;
+    stats.reports++;
+    stats.totalWaitUs += wait;
+    if (wait < stats.minWaitUs) stats.minWaitUs = wait;
+    if (wait > stats.maxWaitUs) stats.maxWaitUs = wait;
+  }
+  return started;
+}
+
+uint32_t usbFrameStartUs() {
+  return frameStartUs;
+}
+
+//==============================================================================
+// QUEUE-TO-POLL MEASUREMENT
+//==============================================================================
+
+void usbReportQueued() {
+  uint16_t frame;
+  if (!frameSeen || !readFrame(frame)) return;
+  reportPending = true;
+  reportFrame = frame;
+  reportQueuedUs = micros();
+}
+
+const UsbFrameStats& usbFrameStats() {
+  return stats;
+}
+
+void resetUsbFrameStats() {
+  stats = { 0, 0, 0xFFFFFFFF, 0, 0 };
+}
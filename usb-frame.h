@@ -0,0 +1,51 @@
+/*
+ * USB Frame Tracking Interface
+ *
+ * The host polls the keyboard endpoint once per 1 ms USB frame. A report
+ * queued just after a poll waits almost a full frame, so press-to-report
+ * latency jitters by up to a frame depending on when the scan ran. This
+ * module watches the frame counter to find where each frame starts, so
+ * loop() can phase-lock the input task to run USB_SOF_LEAD_US before the
+ * next start of frame, and measures how long each report waits in the
+ * endpoint before the host takes it.
+ *
+ * The USB cores own the start-of-frame interrupt, so the frame counter is
+ * polled once per loop() pass instead; a frame start is seen within one
+ * pass of when it happened.
+ */
+
+#ifndef USB_FRAME_H
+#define USB_FRAME_H
+
+#include <Arduino.h>
+
+//==============================================================================
+// FRAME TRACKING
+//==============================================================================
+
+// Call once per loop() pass; true when a new frame has started since the
+// last call (false while USB is not running)
+bool loopUsbFrame();
+
+// micros() when the current frame was first seen
+uint32_t usbFrameStartUs();
+
+//==============================================================================
+// QUEUE-TO-POLL MEASUREMENT
+//==============================================================================
+
+// Call after each keyboard report is handed to the USB core
+void usbReportQueued();
+
+struct UsbFrameStats {
+  uint32_t frames;               // Frame starts seen
+  uint32_t reports;              // Reports the host has taken
+  uint32_t minWaitUs;
+  uint32_t maxWaitUs;
+  uint32_t totalWaitUs;          // From the last queued report to the host poll
+};
+
+const UsbFrameStats& usbFrameStats();
+void resetUsbFrameStats();
+
+#endif // USB_FRAME_H